@@ -26,6 +26,7 @@
 
 #include "cppmicroservices/ServiceReferenceBase.h"
 
+#include <cstdint>
 #include <future>
 
 namespace cppmicroservices
@@ -39,6 +40,21 @@ namespace cppmicroservices
         \brief Groups AsyncWorkService class related symbols
         */
 
+        /**
+         * \ingroup MicroService
+         * \ingroup gr_asyncworkservice
+         *
+         * The priority of a task posted with AsyncWorkService::postWithPriority.
+         * Implementations of PriorityAsyncWorkService run queued tasks with a
+         * higher priority first.
+         */
+        enum class TaskPriority : std::uint8_t
+        {
+            Low,    ///< Background work, e.g. configuration notifications
+            Normal, ///< The priority of tasks posted with AsyncWorkService::post
+            High    ///< Latency sensitive work, e.g. component activation
+        };
+
         /**
          * \ingroup MicroService
          * \ingroup gr_asyncworkservice
@@ -67,6 +83,48 @@ namespace cppmicroservices
              * with the std::packaged_task<void()> in order to wait on the async task.
              */
             virtual void post(std::packaged_task<void()>&& task) = 0;
+
+            /**
+             * Run a std::packaged_task<void()> with the given priority.
+             *
+             * If this object also implements PriorityAsyncWorkService, the task is
+             * passed to PriorityAsyncWorkService::postWithPriority. Otherwise the
+             * priority is ignored and the task is passed to post().
+             *
+             * @param task A std::packaged_task<void()> wrapping a Callable target to
+             * execute asynchronously.
+             * @param priority The priority of the task.
+             *
+             * @see post(std::packaged_task<void()>&&)
+             */
+            void postWithPriority(std::packaged_task<void()>&& task, TaskPriority priority);
+        };
+
+        /**
+         * \ingroup MicroService
+         * \ingroup gr_asyncworkservice
+         *
+         * An optional interface for AsyncWorkService implementations which schedule
+         * tasks by priority. It is kept separate from AsyncWorkService so that
+         * existing implementations of AsyncWorkService remain compatible.
+         *
+         * @remarks This class is thread safe.
+         */
+        class US_usAsyncWorkService_EXPORT PriorityAsyncWorkService
+        {
+          public:
+            virtual ~PriorityAsyncWorkService();
+
+            /**
+             * Run a std::packaged_task<void()> with the given priority. Tasks with a
+             * higher priority which are waiting to be run are started before tasks
+             * with a lower priority.
+             *
+             * @param task A std::packaged_task<void()> wrapping a Callable target to
+             * execute asynchronously.
+             * @param priority The priority of the task.
+             */
+            virtual void postWithPriority(std::packaged_task<void()>&& task, TaskPriority priority) = 0;
         };
     } // namespace async
 } // namespace cppmicroservices
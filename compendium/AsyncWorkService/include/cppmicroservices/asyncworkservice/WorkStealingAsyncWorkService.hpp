@@ -0,0 +1,129 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+#ifndef CPPMICROSERVICES_WORK_STEALING_ASYNC_WORK_SERVICE_H__
+#define CPPMICROSERVICES_WORK_STEALING_ASYNC_WORK_SERVICE_H__
+
+#include "cppmicroservices/asyncworkservice/AsyncWorkService.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+
+namespace cppmicroservices
+{
+    namespace async
+    {
+
+        /**
+         * \ingroup gr_asyncworkservice
+         *
+         * The framework property which sets the number of worker threads of the
+         * WorkStealingAsyncWorkService registered by the AsyncWorkService bundle.
+         * The value must be a positive integer or a string containing one. If
+         * the property is not set, one worker per hardware thread is used.
+         */
+        inline constexpr char const* ASYNC_WORK_SERVICE_WORKER_COUNT = "org.cppmicroservices.asyncworkservice.workers";
+
+        /**
+         * \ingroup gr_asyncworkservice
+         *
+         * A snapshot of the metrics of a WorkStealingAsyncWorkService.
+         */
+        struct WorkStealingMetrics
+        {
+            std::size_t workerCount = 0;   ///< The number of worker threads
+            std::size_t queueDepth = 0;    ///< The number of tasks waiting to be run
+            std::uint64_t executed = 0;    ///< The number of tasks started so far
+            std::uint64_t stolen = 0;      ///< The number of tasks stolen from the queue of another worker
+            std::chrono::nanoseconds averageLatency { 0 }; ///< The average time between posting and starting a task
+            std::chrono::nanoseconds maxLatency { 0 };     ///< The longest time between posting and starting a task
+        };
+
+        class WorkStealingAsyncWorkServicePrivate;
+
+        /**
+         * \ingroup MicroService
+         * \ingroup gr_asyncworkservice
+         *
+         * An AsyncWorkService which runs tasks on a fixed number of worker threads.
+         *
+         * Every worker owns a queue per TaskPriority. Tasks posted from outside the
+         * pool are distributed round-robin over the workers, tasks posted from a
+         * worker thread are queued on that worker. A worker runs its own tasks in
+         * posting order and steals tasks from the other workers when it runs out of
+         * work, always taking the highest priority task it can find first.
+         *
+         * @remarks This class is thread safe.
+         */
+        class US_usAsyncWorkService_EXPORT WorkStealingAsyncWorkService final
+            : public AsyncWorkService
+            , public PriorityAsyncWorkService
+        {
+          public:
+            /**
+             * Start the worker threads.
+             *
+             * @param workerCount The number of worker threads. If zero, one worker
+             * per hardware thread is started.
+             */
+            explicit WorkStealingAsyncWorkService(std::size_t workerCount = 0);
+
+            WorkStealingAsyncWorkService(WorkStealingAsyncWorkService const&) = delete;
+            WorkStealingAsyncWorkService& operator=(WorkStealingAsyncWorkService const&) = delete;
+
+            /**
+             * Calls Shutdown().
+             */
+            ~WorkStealingAsyncWorkService() override;
+
+            /**
+             * Queue a task with TaskPriority::Normal.
+             */
+            void post(std::packaged_task<void()>&& task) override;
+
+            /**
+             * Queue a task with the given priority.
+             */
+            void postWithPriority(std::packaged_task<void()>&& task, TaskPriority priority) override;
+
+            /**
+             * Run all queued tasks and stop the worker threads. Tasks posted while
+             * the queued tasks are run are run as well, tasks posted after this
+             * method returned are discarded and their futures report a broken
+             * promise. Calling this method more than once has no effect.
+             */
+            void Shutdown();
+
+            /**
+             * Returns the current metrics of this object.
+             */
+            WorkStealingMetrics GetMetrics() const;
+
+          private:
+            std::shared_ptr<WorkStealingAsyncWorkServicePrivate> d;
+        };
+    } // namespace async
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_WORK_STEALING_ASYNC_WORK_SERVICE_H__
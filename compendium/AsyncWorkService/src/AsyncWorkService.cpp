@@ -29,5 +29,20 @@ namespace cppmicroservices
 
         AsyncWorkService::~AsyncWorkService() = default;
 
+        void
+        AsyncWorkService::postWithPriority(std::packaged_task<void()>&& task, TaskPriority priority)
+        {
+            if (auto prioritized = dynamic_cast<PriorityAsyncWorkService*>(this))
+            {
+                prioritized->postWithPriority(std::move(task), priority);
+            }
+            else
+            {
+                post(std::move(task));
+            }
+        }
+
+        PriorityAsyncWorkService::~PriorityAsyncWorkService() = default;
+
     }
 } // namespace cppmicroservices
@@ -0,0 +1,312 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "cppmicroservices/asyncworkservice/WorkStealingAsyncWorkService.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cppmicroservices
+{
+    namespace async
+    {
+
+        namespace
+        {
+            constexpr std::size_t PriorityCount = 3;
+
+            struct QueuedTask
+            {
+                std::packaged_task<void()> task;
+                std::chrono::steady_clock::time_point posted;
+            };
+
+            struct Worker
+            {
+                std::mutex mutex;
+                // one queue per TaskPriority, the owner pops from the front
+                // and other workers steal from the back
+                std::array<std::deque<QueuedTask>, PriorityCount> queues;
+                std::thread thread;
+            };
+
+            // The pool and worker index of the current thread, used to queue
+            // tasks posted by a running task on the same worker
+            thread_local WorkStealingAsyncWorkServicePrivate const* currentPool = nullptr;
+            thread_local std::size_t currentWorker = 0;
+        } // namespace
+
+        class WorkStealingAsyncWorkServicePrivate
+            : public std::enable_shared_from_this<WorkStealingAsyncWorkServicePrivate>
+        {
+          public:
+            explicit WorkStealingAsyncWorkServicePrivate(std::size_t workerCount)
+                : nextWorker(0)
+                , pending(0)
+                , stopping(false)
+                , activeWorkers(workerCount)
+                , executed(0)
+                , stolen(0)
+                , totalLatency(0)
+                , maxLatency(0)
+            {
+                workers.reserve(workerCount);
+                for (std::size_t i = 0; i < workerCount; ++i)
+                {
+                    workers.push_back(std::make_unique<Worker>());
+                }
+            }
+
+            void
+            Start()
+            {
+                // The workers keep this object alive, in case the last reference
+                // to the service is released by one of its own tasks
+                for (std::size_t i = 0; i < workers.size(); ++i)
+                {
+                    workers[i]->thread = std::thread([self = shared_from_this(), i]() { self->Run(i); });
+                }
+            }
+
+            void
+            Post(std::packaged_task<void()>&& task, TaskPriority priority)
+            {
+                auto const index = currentPool == this
+                                       ? currentWorker
+                                       : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+                auto& worker = *workers[index];
+                {
+                    // Queue the task with the sleep mutex held, which a worker
+                    // holds while it decides to wait or to exit. This way the
+                    // notification cannot get lost, and a task is either seen
+                    // by a worker or posted after all workers exited.
+                    std::lock_guard<std::mutex> sl(sleepMutex);
+                    if (activeWorkers == 0)
+                    {
+                        // destroy the task, which breaks its promise
+                        std::packaged_task<void()> discarded(std::move(task));
+                        return;
+                    }
+                    std::lock_guard<std::mutex> l(worker.mutex);
+                    worker.queues[static_cast<std::size_t>(priority)].push_back(
+                        QueuedTask { std::move(task), std::chrono::steady_clock::now() });
+                    pending.fetch_add(1);
+                }
+                sleepCV.notify_one();
+            }
+
+            void
+            Shutdown()
+            {
+                {
+                    std::lock_guard<std::mutex> l(sleepMutex);
+                    if (stopping)
+                    {
+                        return;
+                    }
+                    stopping = true;
+                }
+                sleepCV.notify_all();
+
+                for (auto& worker : workers)
+                {
+                    if (worker->thread.get_id() == std::this_thread::get_id())
+                    {
+                        // Shutdown() called from a task, the worker exits once
+                        // the task returned and the queues are empty
+                        worker->thread.detach();
+                    }
+                    else if (worker->thread.joinable())
+                    {
+                        worker->thread.join();
+                    }
+                }
+            }
+
+            WorkStealingMetrics
+            GetMetrics() const
+            {
+                WorkStealingMetrics metrics;
+                metrics.workerCount = workers.size();
+                metrics.queueDepth = static_cast<std::size_t>(std::max<std::int64_t>(pending.load(), 0));
+                metrics.executed = executed.load();
+                metrics.stolen = stolen.load();
+                if (metrics.executed > 0)
+                {
+                    metrics.averageLatency = std::chrono::nanoseconds(totalLatency.load() / metrics.executed);
+                }
+                metrics.maxLatency = std::chrono::nanoseconds(maxLatency.load());
+                return metrics;
+            }
+
+          private:
+            void
+            Run(std::size_t index)
+            {
+                currentPool = this;
+                currentWorker = index;
+
+                QueuedTask task;
+                for (;;)
+                {
+                    if (Take(index, task))
+                    {
+                        Execute(task);
+                        continue;
+                    }
+
+                    std::unique_lock<std::mutex> l(sleepMutex);
+                    sleepCV.wait(l, [this]() { return pending.load() > 0 || stopping; });
+                    if (stopping && pending.load() <= 0)
+                    {
+                        --activeWorkers;
+                        return;
+                    }
+                }
+            }
+
+            // Take the highest priority task, preferring the own queue over
+            // stealing from another worker at the same priority
+            bool
+            Take(std::size_t index, QueuedTask& task)
+            {
+                for (std::size_t p = PriorityCount; p-- > 0;)
+                {
+                    for (std::size_t i = 0; i < workers.size(); ++i)
+                    {
+                        auto const victim = (index + i) % workers.size();
+                        auto& worker = *workers[victim];
+                        std::lock_guard<std::mutex> l(worker.mutex);
+                        auto& queue = worker.queues[p];
+                        if (queue.empty())
+                        {
+                            continue;
+                        }
+                        if (victim == index)
+                        {
+                            task = std::move(queue.front());
+                            queue.pop_front();
+                        }
+                        else
+                        {
+                            task = std::move(queue.back());
+                            queue.pop_back();
+                            stolen.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        pending.fetch_sub(1);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void
+            Execute(QueuedTask& task)
+            {
+                auto const latency = static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - task.posted)
+                        .count());
+                totalLatency.fetch_add(latency, std::memory_order_relaxed);
+                auto currentMax = maxLatency.load(std::memory_order_relaxed);
+                while (currentMax < latency
+                       && !maxLatency.compare_exchange_weak(currentMax, latency, std::memory_order_relaxed))
+                {
+                }
+
+                // Count the task before it makes its future ready, so that a
+                // thread waiting for the future sees it in the metrics
+                executed.fetch_add(1, std::memory_order_relaxed);
+
+                // the packaged_task stores exceptions thrown by the callable in its future
+                try
+                {
+                    task.task();
+                }
+                catch (...)
+                {
+                }
+                task.task = std::packaged_task<void()>();
+            }
+
+            std::vector<std::unique_ptr<Worker>> workers;
+            std::atomic<std::size_t> nextWorker;
+
+            // The number of queued tasks, updated with the mutex of the queue
+            // held.
+            std::atomic<std::int64_t> pending;
+
+            std::mutex sleepMutex;
+            std::condition_variable sleepCV;
+            // guarded by sleepMutex
+            bool stopping;
+            std::size_t activeWorkers;
+
+            std::atomic<std::uint64_t> executed;
+            std::atomic<std::uint64_t> stolen;
+            std::atomic<std::uint64_t> totalLatency;
+            std::atomic<std::uint64_t> maxLatency;
+        };
+
+        WorkStealingAsyncWorkService::WorkStealingAsyncWorkService(std::size_t workerCount)
+        {
+            if (workerCount == 0)
+            {
+                workerCount = std::max(std::thread::hardware_concurrency(), 1u);
+            }
+            d = std::make_shared<WorkStealingAsyncWorkServicePrivate>(workerCount);
+            d->Start();
+        }
+
+        WorkStealingAsyncWorkService::~WorkStealingAsyncWorkService() { Shutdown(); }
+
+        void
+        WorkStealingAsyncWorkService::post(std::packaged_task<void()>&& task)
+        {
+            d->Post(std::move(task), TaskPriority::Normal);
+        }
+
+        void
+        WorkStealingAsyncWorkService::postWithPriority(std::packaged_task<void()>&& task, TaskPriority priority)
+        {
+            d->Post(std::move(task), priority);
+        }
+
+        void
+        WorkStealingAsyncWorkService::Shutdown()
+        {
+            d->Shutdown();
+        }
+
+        WorkStealingMetrics
+        WorkStealingAsyncWorkService::GetMetrics() const
+        {
+            return d->GetMetrics();
+        }
+    } // namespace async
+} // namespace cppmicroservices
@@ -0,0 +1,89 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "Activator.hpp"
+
+#include <cppmicroservices/Any.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace cppmicroservices
+{
+    namespace async
+    {
+        namespace impl
+        {
+            namespace
+            {
+                std::size_t
+                GetWorkerCount(cppmicroservices::BundleContext const& bc)
+                {
+                    auto const workers = bc.GetProperty(ASYNC_WORK_SERVICE_WORKER_COUNT);
+                    if (workers.Empty())
+                    {
+                        return 0;
+                    }
+
+                    try
+                    {
+                        auto const count = std::stol(workers.ToString());
+                        if (count > 0)
+                        {
+                            return static_cast<std::size_t>(count);
+                        }
+                    }
+                    catch (std::exception const&)
+                    {
+                    }
+                    throw std::invalid_argument(std::string("Invalid value for the framework property ")
+                                                + ASYNC_WORK_SERVICE_WORKER_COUNT + ": " + workers.ToString());
+                }
+            } // namespace
+
+            void
+            Activator::Start(cppmicroservices::BundleContext bc)
+            {
+                workService = std::make_shared<WorkStealingAsyncWorkService>(GetWorkerCount(bc));
+                reg = bc.RegisterService<AsyncWorkService, WorkStealingAsyncWorkService>(workService);
+            }
+
+            void
+            Activator::Stop(cppmicroservices::BundleContext)
+            {
+                // Unregister first, so that users switch away from the service
+                // before the queued tasks are run and the workers are stopped
+                if (reg)
+                {
+                    reg.Unregister();
+                }
+                if (workService)
+                {
+                    workService->Shutdown();
+                    workService.reset();
+                }
+            }
+        } // namespace impl
+    }     // namespace async
+} // namespace cppmicroservices
+
+CPPMICROSERVICES_EXPORT_BUNDLE_ACTIVATOR(cppmicroservices::async::impl::Activator)
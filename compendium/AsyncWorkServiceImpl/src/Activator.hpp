@@ -0,0 +1,58 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef CPPMICROSERVICES_ASYNCWORKSERVICE_ACTIVATOR_HPP
+#define CPPMICROSERVICES_ASYNCWORKSERVICE_ACTIVATOR_HPP
+
+#include "cppmicroservices/BundleActivator.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/ServiceRegistration.h"
+#include "cppmicroservices/asyncworkservice/WorkStealingAsyncWorkService.hpp"
+
+#include <memory>
+
+namespace cppmicroservices
+{
+    namespace async
+    {
+        namespace impl
+        {
+            /**
+             * Registers a WorkStealingAsyncWorkService under the AsyncWorkService
+             * and WorkStealingAsyncWorkService interfaces. The number of workers is
+             * read from the ASYNC_WORK_SERVICE_WORKER_COUNT framework property.
+             */
+            class Activator final : public cppmicroservices::BundleActivator
+            {
+              public:
+                void Start(cppmicroservices::BundleContext bc) override;
+                void Stop(cppmicroservices::BundleContext) override;
+
+              private:
+                std::shared_ptr<WorkStealingAsyncWorkService> workService;
+                cppmicroservices::ServiceRegistration<AsyncWorkService, WorkStealingAsyncWorkService> reg;
+            };
+        } // namespace impl
+    }     // namespace async
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_ASYNCWORKSERVICE_ACTIVATOR_HPP
@@ -25,6 +25,7 @@
 
 #include "cppmicroservices/cm/Configuration.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -41,6 +42,39 @@ namespace cppmicroservices
              \brief Groups ConfigurationAdmin class related symbols.
              */
 
+            /**
+             * \ingroup gr_configurationadmin
+             * Framework property specifying a directory in which ConfigurationAdmin persists
+             * its Configuration objects. When ConfigurationAdmin starts, it restores the persisted
+             * Configuration objects together with their change counts, so that they do not need
+             * to be updated again. The value of this property must be of type \c std::string.
+             * By default, Configuration objects are not persisted.
+             */
+            inline constexpr char const* CM_STORAGE_DIRECTORY = "org.cppmicroservices.cm.storage";
+
+            /**
+             * \ingroup gr_configurationadmin
+             * Framework property listing the property keys, besides the pid, by which ConfigurationAdmin
+             * indexes its Configuration objects. ListConfigurations only matches the Configuration objects
+             * found in the index when the filter requires the pid, or the value of one of these keys, to
+             * equal a string or to start with a prefix, e.g. "(&(region=emea)(pid=billing~*))". The value
+             * of this property must be of type \c std::vector<std::string>.
+             */
+            inline constexpr char const* CM_INDEXED_PROPERTIES = "org.cppmicroservices.cm.indexedproperties";
+
+            /**
+             * \ingroup gr_configurationadmin
+             * Framework property specifying whether ConfigurationAdmin coalesces the notifications of
+             * rapid updates. If an update of a Configuration object is made while the notification of
+             * a previous update of it has not started yet, no further notification is scheduled; the
+             * pending one notifies the latest properties and change count. ManagedService,
+             * ManagedServiceFactory and ConfigurationListener objects are then not notified of the
+             * intermediate updates. ConfigurationAdmin::GetUpdateNotificationStatistics counts the
+             * coalesced updates. The value of this property must be of type \c bool. The default
+             * value is \c false.
+             */
+            inline constexpr char const* CM_COALESCE_UPDATES = "org.cppmicroservices.cm.coalesceupdates";
+
             /**
              * \ingroup gr_configurationadmin
              * The ConfigurationAdmin interface is the means by which applications and services can
@@ -51,6 +85,18 @@ namespace cppmicroservices
             class ConfigurationAdmin
             {
               public:
+                /**
+                 * Counters of the notifications of Configuration updates.
+                 *
+                 * @see GetUpdateNotificationStatistics()
+                 * @see CM_COALESCE_UPDATES
+                 */
+                struct UpdateNotificationStatistics
+                {
+                    std::uint64_t scheduled; ///< Number of update notifications scheduled
+                    std::uint64_t coalesced; ///< Number of updates merged into a pending notification instead
+                };
+
                 virtual ~ConfigurationAdmin() noexcept = default;
 
                 /**
@@ -101,6 +147,20 @@ namespace cppmicroservices
                  */
                 virtual std::vector<std::shared_ptr<Configuration>> ListConfigurations(std::string const& filter = {})
                     = 0;
+
+                /**
+                 * Returns the current counters of the notifications of Configuration updates. An update
+                 * which is coalesced into a pending notification, see CM_COALESCE_UPDATES, does not
+                 * schedule a notification of its own, so the listeners are not notified of it.
+                 *
+                 * The default implementation returns zero counters.
+                 *
+                 * @return A snapshot of the update notification counters.
+                 */
+                virtual UpdateNotificationStatistics GetUpdateNotificationStatistics() const
+                {
+                    return UpdateNotificationStatistics { 0u, 0u };
+                }
             };
         } // namespace cm
     }     // namespace service
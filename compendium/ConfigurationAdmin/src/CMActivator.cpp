@@ -32,6 +32,38 @@ namespace cppmicroservices
 {
     namespace cmimpl
     {
+        namespace
+        {
+            std::shared_ptr<ConfigurationStore>
+            OpenConfigurationStore(cppmicroservices::BundleContext const& context,
+                                   std::shared_ptr<CMLogger> const& logger)
+            {
+                auto const storageProp = context.GetProperty(cppmicroservices::service::cm::CM_STORAGE_DIRECTORY);
+                if (storageProp.Empty())
+                {
+                    return nullptr;
+                }
+                if (storageProp.Type() != typeid(std::string) || any_cast<std::string>(storageProp).empty())
+                {
+                    logger->Log(SeverityLevel::LOG_ERROR,
+                                std::string("Invalid value for the framework property ")
+                                    + cppmicroservices::service::cm::CM_STORAGE_DIRECTORY
+                                    + ". Configurations are not persisted.");
+                    return nullptr;
+                }
+                try
+                {
+                    return std::make_shared<ConfigurationStore>(any_cast<std::string>(storageProp), logger);
+                }
+                catch (std::exception const&)
+                {
+                    logger->Log(SeverityLevel::LOG_ERROR,
+                                "Could not open the configuration store. Configurations are not persisted.",
+                                std::current_exception());
+                }
+                return nullptr;
+            }
+        } // namespace
         void
         CMActivator::Start(BundleContext context)
         {
@@ -42,7 +74,10 @@ namespace cppmicroservices
             // Create the AsyncWorkService object used by this runtime
             asyncWorkService = std::make_shared<CMAsyncWorkService>(context, logger);
             // Create ConfigurationAdminImpl
-            configAdminImpl = std::make_shared<ConfigurationAdminImpl>(runtimeContext, logger, asyncWorkService);
+            configAdminImpl = std::make_shared<ConfigurationAdminImpl>(runtimeContext,
+                                                                       logger,
+                                                                       asyncWorkService,
+                                                                       OpenConfigurationStore(context, logger));
             // Add bundle listener
             bundleListenerToken
                 = context.AddBundleListener(std::bind(&CMActivator::BundleChanged, this, std::placeholders::_1));
@@ -44,6 +44,7 @@ namespace cppmicroservices
          */
         class CMAsyncWorkService final
             : public cppmicroservices::async::AsyncWorkService
+            , public cppmicroservices::async::PriorityAsyncWorkService
             , public cppmicroservices::ServiceTrackerCustomizer<cppmicroservices::async::AsyncWorkService>
         {
           public:
@@ -58,6 +59,10 @@ namespace cppmicroservices
             // methods from the cppmicroservices::async::AsyncWorkService interface
             void post(std::packaged_task<void()>&& task) override;
 
+            // methods from the cppmicroservices::async::PriorityAsyncWorkService interface
+            void postWithPriority(std::packaged_task<void()>&& task,
+                                  cppmicroservices::async::TaskPriority priority) override;
+
             // methods from the cppmicroservices::ServiceTrackerCustomizer interface
             std::shared_ptr<TrackedParamType> AddingService(
                 ServiceReference<cppmicroservices::async::AsyncWorkService> const& reference) override;
@@ -20,11 +20,13 @@
 
  =============================================================================*/
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 #include <thread>
 
 #include "cppmicroservices/Constants.h"
+#include "cppmicroservices/Trace.h"
 #include "cppmicroservices/cm/ConfigurationException.hpp"
 #include "cppmicroservices/detail/ScopeGuard.h"
 
@@ -186,6 +188,34 @@ namespace
         }
         return {};
     }
+
+    // Get the property keys listed in the CM_INDEXED_PROPERTIES framework property
+    std::vector<std::string>
+    getIndexedPropertyKeys(cppmicroservices::BundleContext const& context,
+                           cppmicroservices::logservice::LogService& logger)
+    {
+        auto const keysProp = context.GetProperty(cppmicroservices::service::cm::CM_INDEXED_PROPERTIES);
+        if (keysProp.Empty())
+        {
+            return {};
+        }
+        if (keysProp.Type() != typeid(std::vector<std::string>))
+        {
+            logger.Log(SeverityLevel::LOG_ERROR,
+                       std::string("Invalid value for the framework property ")
+                           + cppmicroservices::service::cm::CM_INDEXED_PROPERTIES
+                           + ". Only the pid of Configurations is indexed.");
+            return {};
+        }
+        return cppmicroservices::any_cast<std::vector<std::string>>(keysProp);
+    }
+
+    bool
+    isCoalescingUpdates(cppmicroservices::BundleContext const& context)
+    {
+        auto const coalesceProp = context.GetProperty(cppmicroservices::service::cm::CM_COALESCE_UPDATES);
+        return (coalesceProp.Type() == typeid(bool)) && cppmicroservices::any_cast<bool>(coalesceProp);
+    }
 } // namespace
 
 namespace cppmicroservices
@@ -196,16 +226,24 @@ namespace cppmicroservices
         ConfigurationAdminImpl::ConfigurationAdminImpl(
             cppmicroservices::BundleContext context,
             std::shared_ptr<cppmicroservices::logservice::LogService> const& lggr,
-            std::shared_ptr<cppmicroservices::async::AsyncWorkService> const& asyncWS)
+            std::shared_ptr<cppmicroservices::async::AsyncWorkService> const& asyncWS,
+            std::shared_ptr<ConfigurationStore> configurationStore)
             : cmContext(std::move(context))
             , logger(lggr)
             , asyncWorkService(asyncWS)
+            , store(std::move(configurationStore))
+            , index(std::make_shared<ConfigurationIndex>(getIndexedPropertyKeys(cmContext, *logger)))
             , futuresID { 0u }
+            , coalesceUpdates(isCoalescingUpdates(cmContext))
+            , scheduledUpdates { 0u }
+            , coalescedUpdates { 0u }
             , managedServiceTracker(cmContext, this)
             , managedServiceFactoryTracker(cmContext, this)
             , randomGenerator(std::random_device {}())
             , configListenerTracker(cmContext)
         {
+            // Restore first, so that services tracked from now on are updated with the persisted properties
+            RestoreConfigurations();
             managedServiceTracker.Open();
             managedServiceFactoryTracker.Open();
             configListenerTracker.Open();
@@ -309,7 +347,10 @@ namespace cppmicroservices
                                           this,
                                           pid,
                                           std::move(factoryPid),
-                                          AnyMap { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS }))
+                                          AnyMap { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS },
+                                          0u,
+                                          store,
+                                          index))
                              .first;
                     created = true;
                 }
@@ -341,7 +382,10 @@ namespace cppmicroservices
                              std::make_shared<ConfigurationImpl>(this,
                                                                  pid,
                                                                  factoryPid,
-                                                                 AnyMap { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS }))
+                                                                 AnyMap { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS },
+                                                                 0u,
+                                                                 store,
+                                                                 index))
                          .first;
                 result = it->second;
             }
@@ -391,37 +435,46 @@ namespace cppmicroservices
 
                 // filter is not empty so look for pid and property matches
                 LDAPFilter ldap { filter };
-                cppmicroservices::AnyMap pidMap { cppmicroservices::AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
 
-                for (auto const& it : configurations)
+                /* Create an AnyMap containing the pid or factoryPid so that the ldap filter
+                 * functionality can be used to match the pid to the
+                 * input parameter. Easy way to do the comparison since input parameter could
+                 * contain a regular expression
+                 */
+                cppmicroservices::AnyMap pidMap { cppmicroservices::AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+                auto const matches = [&ldap, &pidMap](std::string const& pid, ConfigurationImpl& configuration)
                 {
                     // configurations that have not yet been updated cannot be
                     // returned.
-                    if (!it.second->HasBeenUpdatedAtLeastOnce())
+                    if (!configuration.HasBeenUpdatedAtLeastOnce())
                     {
-                        continue;
-                    }
-                    /* Create an AnyMap containing the pid or factoryPid so that the ldap filter
-                     * functionality can be used to match the pid to the
-                     * input parameter. Easy way to do the comparison since input parameter could
-                     * contain a regular expression
-                     */
-                    pidMap["pid"] = it.first;
-
-                    if (ldap.Match(pidMap))
-                    {
-                        // This configuration object has a matching pid.
-                        result.emplace_back(it.second);
+                        return false;
                     }
-                    else
+                    pidMap["pid"] = pid;
+                    return configuration.MatchesFilter(ldap, pidMap);
+                };
+
+                // If the filter requires a pid or an indexed property to have a certain value or
+                // prefix, only the configurations found in the index can match.
+                if (auto const candidates = index->FindCandidates(filter))
+                {
+                    for (auto const& pid : *candidates)
                     {
-                        // The pid wasn't a match but the properties might be. Check those.
-                        auto props = it.second->GetProperties();
-                        if (ldap.Match(props))
+                        if (auto const it = configurations.find(pid);
+                            it != std::end(configurations) && matches(it->first, *it->second))
                         {
-                            result.emplace_back(it.second);
+                            result.emplace_back(it->second);
                         }
                     }
+                    return result;
+                }
+
+                for (auto const& it : configurations)
+                {
+                    if (matches(it.first, *it.second))
+                    {
+                        result.emplace_back(it.second);
+                    }
                 } // end for
             }
             return result;
@@ -453,8 +506,14 @@ namespace cppmicroservices
                                                                              pid,
                                                                              std::move(factoryPid),
                                                                              configMetadata.properties,
-                                                                             1u);
+                                                                             1u,
+                                                                             store,
+                                                                             index);
                         changeCount = newConfig->GetChangeCount();
+                        if (store)
+                        {
+                            store->Put(pid, changeCount, configMetadata.properties);
+                        }
                         it = configurations.emplace(pid, std::move(newConfig)).first;
                         pidsAndChangeCountsAndIDs.emplace_back(pid,
                                                                changeCount,
@@ -480,7 +539,14 @@ namespace cppmicroservices
                         it->second = std::make_shared<ConfigurationImpl>(this,
                                                                          pid,
                                                                          getFactoryPid(pid),
-                                                                         configMetadata.properties);
+                                                                         configMetadata.properties,
+                                                                         0u,
+                                                                         store,
+                                                                         index);
+                        if (store && it->second->HasBeenUpdatedAtLeastOnce())
+                        {
+                            store->Put(pid, it->second->GetChangeCount(), configMetadata.properties);
+                        }
                         pidsAndChangeCountsAndIDs.emplace_back(pid,
                                                                changeCount,
                                                                reinterpret_cast<std::uintptr_t>(it->second.get()));
@@ -552,6 +618,7 @@ namespace cppmicroservices
                             configurationsToInvalidate.push_back(std::move(it->second));
                             removedAndUpdated.emplace_back(true, hasBeenUpdated);
                             configurations.erase(it);
+                            index->Remove(pid);
                             RemoveFactoryInstanceIfRequired(pid);
                             continue;
                         }
@@ -565,6 +632,7 @@ namespace cppmicroservices
                         configurationsToInvalidate.push_back(std::move(it->second));
                         removedAndUpdated.emplace_back(true, hasBeenUpdated);
                         configurations.erase(it);
+                        index->Remove(pid);
                         RemoveFactoryInstanceIfRequired(pid);
                     }
                 }
@@ -608,135 +676,177 @@ namespace cppmicroservices
             // is not available and that method cannot be called. For this reason, NotifyConfigurationUpdated
             // should not be called for Remove operations unless the caller has already confirmed
             // the configuration object has been updated at least once.
-            return PerformAsync(
-                [this, pid, changeCount]
-                {
-                    AnyMap properties { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
-                    std::string fPid;
-                    std::string nonFPid;
-                    auto removed = false;
-                    auto hasBeenUpdated = false;
-                    std::vector<std::shared_ptr<TrackedServiceWrapper<cppmicroservices::service::cm::ManagedService>>>
-                        managedServiceWrappers;
-                    std::vector<
-                        std::shared_ptr<TrackedServiceWrapper<cppmicroservices::service::cm::ManagedServiceFactory>>>
-                        managedServiceFactoryWrappers;
+            if (!coalesceUpdates)
+            {
+                ++scheduledUpdates;
+                return PerformAsync([this, pid, changeCount] { DeliverConfigurationUpdated(pid, changeCount); });
+            }
+
+            std::lock_guard<std::mutex> lk { pendingUpdatesMutex };
+            if (auto const it = pendingUpdates.find(pid); it != std::end(pendingUpdates))
+            {
+                // The pending notification has not started yet, so it will deliver these properties.
+                it->second.changeCount = std::max(it->second.changeCount, changeCount);
+                ++it->second.coalesced;
+                ++coalescedUpdates;
+                return it->second.notified;
+            }
+            auto const it = pendingUpdates.emplace(pid, PendingUpdate { changeCount, 0u, {} }).first;
+            try
+            {
+                // The notification cannot start before pendingUpdatesMutex is unlocked.
+                it->second.notified = PerformAsync(
+                    [this, pid]
                     {
-                        std::lock_guard<std::mutex> lk { configurationsMutex };
-                        const auto it = configurations.find(pid);
-                        if (it == std::end(configurations))
+                        unsigned long changeCount { 0u };
+                        std::uint64_t coalesced { 0u };
                         {
-                            removed = true;
-                            hasBeenUpdated = true;
+                            std::lock_guard<std::mutex> lk { pendingUpdatesMutex };
+                            auto const pending = pendingUpdates.find(pid);
+                            assert(pending != std::end(pendingUpdates) && "Invalid pending update iterator");
+                            changeCount = pending->second.changeCount;
+                            coalesced = pending->second.coalesced;
+                            pendingUpdates.erase(pending);
                         }
-                        else
+                        if (coalesced > 0u)
                         {
-                            try
-                            {
-                                hasBeenUpdated = it->second->HasBeenUpdatedAtLeastOnce();
-                                properties = it->second->GetProperties();
-                            }
-                            catch (const std::runtime_error&)
-                            {
-                                // Configuration is being removed
-                                removed = true;
-                            }
+                            logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+                                        "Notifying " + std::to_string(coalesced + 1u)
+                                            + " updates of the Configuration with PID " + pid + " at once");
                         }
+                        DeliverConfigurationUpdated(pid, changeCount);
+                    });
+            }
+            catch (...)
+            {
+                pendingUpdates.erase(it);
+                throw;
+            }
+            ++scheduledUpdates;
+            return it->second.notified;
+        }
 
-                        // We can only send update notifications for configuration objects that have
-                        // been updated. Just return without sending the notification for objects
-                        // that have not yet been updated.
-                        if (!hasBeenUpdated)
-                        {
-                            return;
-                        }
+        void
+        ConfigurationAdminImpl::DeliverConfigurationUpdated(std::string const& pid, unsigned long const changeCount)
+        {
+            cppmicroservices::detail::TraceSpan span("ConfigurationAdmin::NotifyConfigurationUpdated", pid);
+            AnyMap properties { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+            std::string fPid;
+            std::string nonFPid;
+            auto removed = false;
+            auto hasBeenUpdated = false;
+            std::vector<std::shared_ptr<TrackedServiceWrapper<cppmicroservices::service::cm::ManagedService>>>
+                managedServiceWrappers;
+            std::vector<std::shared_ptr<TrackedServiceWrapper<cppmicroservices::service::cm::ManagedServiceFactory>>>
+                managedServiceFactoryWrappers;
+            {
+                std::lock_guard<std::mutex> lk { configurationsMutex };
+                const auto it = configurations.find(pid);
+                if (it == std::end(configurations))
+                {
+                    removed = true;
+                    hasBeenUpdated = true;
+                }
+                else
+                {
+                    try
+                    {
+                        hasBeenUpdated = it->second->HasBeenUpdatedAtLeastOnce();
+                        properties = it->second->GetProperties();
+                    }
+                    catch (const std::runtime_error&)
+                    {
+                        // Configuration is being removed
+                        removed = true;
+                    }
+                }
+
+                // We can only send update notifications for configuration objects that have
+                // been updated. Just return without sending the notification for objects
+                // that have not yet been updated.
+                if (!hasBeenUpdated)
+                {
+                    return;
+                }
+
+                if (pid.find('~') != std::string::npos)
+                {
+                    // this is a factory pid
+                    fPid = pid;
+                }
+                else
+                {
+                    nonFPid = pid;
+                }
+                managedServiceWrappers = trackedManagedServices_;
+                managedServiceFactoryWrappers = trackedManagedServiceFactories_;
+            }
+
+            auto type = removed ? cppmicroservices::service::cm::ConfigurationEventType::CM_DELETED
+                                : cppmicroservices::service::cm::ConfigurationEventType::CM_UPDATED;
 
-                        if (pid.find('~') != std::string::npos)
+            auto configurationListeners = configListenerTracker.GetServices();
+            auto configAdminRef = cmContext.GetServiceReference<ConfigurationAdmin>();
+            for (const auto& it : configurationListeners)
+            {
+                auto configEvent
+                    = cppmicroservices::service::cm::ConfigurationEvent(configAdminRef, type, fPid, nonFPid);
+                it->configurationEvent((configEvent));
+            }
+
+            std::for_each(
+                managedServiceWrappers.begin(),
+                managedServiceWrappers.end(),
+                [&](const auto& managedServiceWrapper)
+                {
+                    // The ServiceTracker will return a default constructed shared_ptr for each ManagedService
+                    // that we aren't tracking. We must be careful not to dereference these!
+                    if ((managedServiceWrapper) && (managedServiceWrapper->getPid() == pid)
+                        && (removed
+                            || (!removed && managedServiceWrapper->needsAnUpdateNotification(pid, changeCount))))
+                    {
+                        notifyServiceUpdated(pid, *(managedServiceWrapper->getTrackedService()), properties, *logger);
+                        if (removed)
                         {
-                            // this is a factory pid
-                            fPid = pid;
+                            managedServiceWrapper->removeLastUpdatedChangeCount(pid);
                         }
                         else
                         {
-                            nonFPid = pid;
+                            managedServiceWrapper->setLastUpdatedChangeCount(pid, changeCount);
                         }
-                        managedServiceWrappers = trackedManagedServices_;
-                        managedServiceFactoryWrappers = trackedManagedServiceFactories_;
                     }
+                });
 
-                    auto type = removed ? cppmicroservices::service::cm::ConfigurationEventType::CM_DELETED
-                                        : cppmicroservices::service::cm::ConfigurationEventType::CM_UPDATED;
+            const auto factoryPid = getFactoryPid(pid);
+            if (factoryPid.empty())
+            {
+                return;
+            }
 
-                    auto configurationListeners = configListenerTracker.GetServices();
-                    auto configAdminRef = cmContext.GetServiceReference<ConfigurationAdmin>();
-                    for (const auto& it : configurationListeners)
+            std::for_each(
+                managedServiceFactoryWrappers.begin(),
+                managedServiceFactoryWrappers.end(),
+                [&](const auto& managedServiceFactoryWrapper)
+                {
+                    // The ServiceTracker will return a default constructed shared_ptr for each
+                    // ManagedServiceFactory that we aren't tracking. We must be careful not to dereference
+                    // these!
+                    if ((managedServiceFactoryWrapper) && (managedServiceFactoryWrapper->getPid() == factoryPid))
                     {
-                        auto configEvent
-                            = cppmicroservices::service::cm::ConfigurationEvent(configAdminRef, type, fPid, nonFPid);
-                        it->configurationEvent((configEvent));
-                    }
-
-                    std::for_each(
-                        managedServiceWrappers.begin(),
-                        managedServiceWrappers.end(),
-                        [&](const auto& managedServiceWrapper)
+                        if (removed)
                         {
-                            // The ServiceTracker will return a default constructed shared_ptr for each ManagedService
-                            // that we aren't tracking. We must be careful not to dereference these!
-                            if ((managedServiceWrapper) && (managedServiceWrapper->getPid() == pid)
-                                && (removed
-                                    || (!removed
-                                        && managedServiceWrapper->needsAnUpdateNotification(pid, changeCount))))
-                            {
-                                notifyServiceUpdated(pid,
-                                                     *(managedServiceWrapper->getTrackedService()),
-                                                     properties,
-                                                     *logger);
-                                if (removed)
-                                {
-                                    managedServiceWrapper->removeLastUpdatedChangeCount(pid);
-                                }
-                                else
-                                {
-                                    managedServiceWrapper->setLastUpdatedChangeCount(pid, changeCount);
-                                }
-                            }
-                        });
-
-                    const auto factoryPid = getFactoryPid(pid);
-                    if (factoryPid.empty())
-                    {
-                        return;
-                    }
-
-                    std::for_each(
-                        managedServiceFactoryWrappers.begin(),
-                        managedServiceFactoryWrappers.end(),
-                        [&](const auto& managedServiceFactoryWrapper)
+                            notifyServiceRemoved(pid, *(managedServiceFactoryWrapper->getTrackedService()), *logger);
+                            managedServiceFactoryWrapper->removeLastUpdatedChangeCount(pid);
+                        }
+                        else if (managedServiceFactoryWrapper->needsAnUpdateNotification(pid, changeCount))
                         {
-                            // The ServiceTracker will return a default constructed shared_ptr for each
-                            // ManagedServiceFactory that we aren't tracking. We must be careful not to dereference
-                            // these!
-                            if ((managedServiceFactoryWrapper)
-                                && (managedServiceFactoryWrapper->getPid() == factoryPid))
-                            {
-                                if (removed)
-                                {
-                                    notifyServiceRemoved(pid,
-                                                         *(managedServiceFactoryWrapper->getTrackedService()),
-                                                         *logger);
-                                    managedServiceFactoryWrapper->removeLastUpdatedChangeCount(pid);
-                                }
-                                else if (managedServiceFactoryWrapper->needsAnUpdateNotification(pid, changeCount))
-                                {
-                                    notifyServiceUpdated(pid,
-                                                         *(managedServiceFactoryWrapper->getTrackedService()),
-                                                         properties,
-                                                         *logger);
-                                    managedServiceFactoryWrapper->setLastUpdatedChangeCount(pid, changeCount);
-                                }
-                            }
-                        });
+                            notifyServiceUpdated(pid,
+                                                 *(managedServiceFactoryWrapper->getTrackedService()),
+                                                 properties,
+                                                 *logger);
+                            managedServiceFactoryWrapper->setLastUpdatedChangeCount(pid, changeCount);
+                        }
+                    }
                 });
         }
 
@@ -770,6 +880,7 @@ namespace cppmicroservices
                 configurationToInvalidate = it->second;
                 hasBeenUpdated = it->second->HasBeenUpdatedAtLeastOnce();
                 configurations.erase(it);
+                index->Remove(pid);
                 RemoveFactoryInstanceIfRequired(pid);
             }
             if (configurationToInvalidate && hasBeenUpdated)
@@ -1062,7 +1173,8 @@ namespace cppmicroservices
             std::shared_future<void> fut = task.get_future().share();
             incompleteFutures.emplace(id, fut);
 
-            asyncWorkService->post(std::move(task));
+            // configuration notifications are background work
+            asyncWorkService->postWithPriority(std::move(task), cppmicroservices::async::TaskPriority::Low);
 
             return fut;
         }
@@ -1080,6 +1192,35 @@ namespace cppmicroservices
             return randomString;
         }
 
+        void
+        ConfigurationAdminImpl::RestoreConfigurations()
+        {
+            if (!store)
+            {
+                return;
+            }
+            auto entries = store->GetEntries();
+            {
+                std::lock_guard<std::mutex> lk { configurationsMutex };
+                for (auto& entry : entries)
+                {
+                    auto factoryPid = getFactoryPid(entry.pid);
+                    AddFactoryInstanceIfRequired(entry.pid, factoryPid);
+                    configurations.emplace(entry.pid,
+                                           std::make_shared<ConfigurationImpl>(this,
+                                                                               entry.pid,
+                                                                               std::move(factoryPid),
+                                                                               std::move(entry.properties),
+                                                                               entry.changeCount,
+                                                                               store,
+                                                                               index));
+                }
+            }
+            logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+                        "Restored " + std::to_string(entries.size()) + " Configurations from "
+                            + store->GetDirectory());
+        }
+
         void
         ConfigurationAdminImpl::AddFactoryInstanceIfRequired(std::string const& pid, std::string const& factoryPid)
         {
@@ -1123,5 +1264,11 @@ namespace cppmicroservices
                 futuresCV.wait(ul, [this] { return incompleteFutures.empty(); });
             }
         }
+
+        ConfigurationAdminImpl::UpdateNotificationStatistics
+        ConfigurationAdminImpl::GetUpdateNotificationStatistics() const
+        {
+            return UpdateNotificationStatistics { scheduledUpdates.load(), coalescedUpdates.load() };
+        }
     } // namespace cmimpl
 } // namespace cppmicroservices
@@ -23,6 +23,7 @@
 #ifndef CONFIGURATIONADMINIMPL_HPP
 #define CONFIGURATIONADMINIMPL_HPP
 
+#include <atomic>
 #include <cstdint>
 #include <future>
 #include <memory>
@@ -42,6 +43,8 @@
 
 #include "ConfigurationAdminPrivate.hpp"
 #include "ConfigurationImpl.hpp"
+#include "ConfigurationIndex.hpp"
+#include "ConfigurationStore.hpp"
 
 namespace cppmicroservices
 {
@@ -127,9 +130,17 @@ namespace cppmicroservices
                   TrackedServiceWrapper<cppmicroservices::service::cm::ManagedServiceFactory>>
         {
           public:
+            /**
+             * If a store is given, the Configurations persisted in it are restored, with their change
+             * counts, and all changes to the Configurations are persisted in it.
+             *
+             * The property keys to index for ListConfigurations, besides the pid, are read from
+             * the framework property {@code CM_INDEXED_PROPERTIES}.
+             */
             ConfigurationAdminImpl(cppmicroservices::BundleContext cmContext,
                                    std::shared_ptr<cppmicroservices::logservice::LogService> const& logger,
-                                   std::shared_ptr<cppmicroservices::async::AsyncWorkService> const& asyncWorkService);
+                                   std::shared_ptr<cppmicroservices::async::AsyncWorkService> const& asyncWorkService,
+                                   std::shared_ptr<ConfigurationStore> store = nullptr);
             ~ConfigurationAdminImpl() override;
             ConfigurationAdminImpl(ConfigurationAdminImpl const&) = delete;
             ConfigurationAdminImpl& operator=(ConfigurationAdminImpl const&) = delete;
@@ -173,6 +184,14 @@ namespace cppmicroservices
             std::vector<std::shared_ptr<cppmicroservices::service::cm::Configuration>> ListConfigurations(
                 std::string const& filter = std::string {}) override;
 
+            /**
+             * Returns the counters of the update notifications which have been scheduled and of the
+             * updates which have been coalesced into a pending one.
+             *
+             * See {@code ConfigurationAdmin#GetUpdateNotificationStatistics}
+             */
+            UpdateNotificationStatistics GetUpdateNotificationStatistics() const override;
+
             /**
              * Internal method used by {@code CMBundleExtension} to add new {@code Configuration} objects
              *
@@ -194,6 +213,10 @@ namespace cppmicroservices
              * {@code ConfigurationListener} of an update to a {@code Configuration}. Performs the
              * notifications asynchronously with the latest state of the properties at the time.
              *
+             * If the framework property {@code CM_COALESCE_UPDATES} is true and a notification for the same
+             * pid is still pending, no new notification is scheduled. The pending one will notify the latest
+             * properties with the highest change count, and its future is returned.
+             *
              * See {@code ConfigurationAdminPrivate#NotifyConfigurationUpdated}
              */
             std::shared_future<void> NotifyConfigurationUpdated(std::string const& pid,
@@ -239,6 +262,9 @@ namespace cppmicroservices
             void WaitForAllAsync();
 
           private:
+            // Notify the listeners and the services of the current state of the Configuration with the given pid
+            void DeliverConfigurationUpdated(std::string const& pid, unsigned long const changeCount);
+
             // Convenience wrapper which is used to perform asyncronous operations
             template <typename Functor>
             std::shared_future<void> PerformAsync(Functor&& f);
@@ -246,6 +272,9 @@ namespace cppmicroservices
             // Used to generate a random instance name for CreateFactoryConfiguration
             std::string RandomInstanceName();
 
+            // Create the Configurations persisted in the store
+            void RestoreConfigurations();
+
             // Used to keep track of the instances of each ManagedServiceFactory
             void AddFactoryInstanceIfRequired(std::string const& pid, std::string const& factoryPid);
             void RemoveFactoryInstanceIfRequired(std::string const& pid);
@@ -253,6 +282,8 @@ namespace cppmicroservices
             cppmicroservices::BundleContext cmContext;
             std::shared_ptr<cppmicroservices::logservice::LogService> logger;
             std::shared_ptr<cppmicroservices::async::AsyncWorkService> asyncWorkService;
+            std::shared_ptr<ConfigurationStore> store;
+            std::shared_ptr<ConfigurationIndex> index;
             std::mutex configurationsMutex;
             std::unordered_map<std::string, std::shared_ptr<ConfigurationImpl>> configurations;
             std::unordered_map<std::string, std::set<std::string>> factoryInstances;
@@ -261,6 +292,17 @@ namespace cppmicroservices
             std::condition_variable futuresCV;
             std::vector<std::shared_future<void>> completeFutures;
             std::unordered_map<std::uint64_t, std::shared_future<void>> incompleteFutures;
+            bool const coalesceUpdates;
+            std::mutex pendingUpdatesMutex;
+            struct PendingUpdate
+            {
+                unsigned long changeCount;
+                std::uint64_t coalesced;
+                std::shared_future<void> notified;
+            };
+            std::unordered_map<std::string, PendingUpdate> pendingUpdates; ///< the notifications not yet started
+            std::atomic<std::uint64_t> scheduledUpdates;
+            std::atomic<std::uint64_t> coalescedUpdates;
             cppmicroservices::ServiceTracker<cppmicroservices::service::cm::ManagedService,
                                              TrackedServiceWrapper<cppmicroservices::service::cm::ManagedService>>
                 managedServiceTracker;
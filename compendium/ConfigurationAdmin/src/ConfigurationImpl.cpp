@@ -39,13 +39,17 @@ namespace cppmicroservices
                                              std::string thePid,
                                              std::string theFactoryPid,
                                              AnyMap props,
-                                             unsigned long const cCount)
+                                             unsigned long const cCount,
+                                             std::shared_ptr<ConfigurationStore> configurationStore,
+                                             std::shared_ptr<ConfigurationIndex> configurationIndex)
             : configAdminImpl(configAdmin)
             , pid(std::move(thePid))
             , factoryPid(std::move(theFactoryPid))
             , properties(std::move(props))
             , changeCount { cCount }
             , removed { false }
+            , store(std::move(configurationStore))
+            , index(std::move(configurationIndex))
         {
             assert(configAdminImpl != nullptr && "Invalid ConfigurationAdminPrivate pointer");
             // constructing a configuration object with properties is the equivalent
@@ -54,6 +58,10 @@ namespace cppmicroservices
             {
                 changeCount++;
             }
+            if (index)
+            {
+                index->Insert(reinterpret_cast<std::uintptr_t>(this), pid, properties);
+            }
         }
 
         std::string
@@ -111,6 +119,7 @@ namespace cppmicroservices
                 }
                 properties = std::move(newProperties);
                 ++changeCount;
+                PropertiesUpdated_unlocked();
             }
             std::lock_guard<std::mutex> lk { configAdminMutex };
             if (configAdminImpl)
@@ -155,6 +164,10 @@ namespace cppmicroservices
                     throw std::runtime_error(REMOVED_EXCEPTION_MESSAGE);
                 }
                 removed = true;
+                if (store)
+                {
+                    store->Remove(pid);
+                }
             }
             std::lock_guard<std::mutex> lk { configAdminMutex };
             if (configAdminImpl)
@@ -184,7 +197,9 @@ namespace cppmicroservices
                 return std::pair<bool, unsigned long> { false, 0u };
             }
             properties = std::move(newProperties);
-            return std::pair<bool, unsigned long> { true, ++changeCount };
+            ++changeCount;
+            PropertiesUpdated_unlocked();
+            return std::pair<bool, unsigned long> { true, changeCount };
         }
 
         bool
@@ -198,6 +213,10 @@ namespace cppmicroservices
             if (expectedChangeCount == changeCount)
             {
                 removed = true;
+                if (store)
+                {
+                    store->Remove(pid);
+                }
                 return true;
             }
             return false;
@@ -206,8 +225,37 @@ namespace cppmicroservices
         void
         ConfigurationImpl::Invalidate()
         {
+            {
+                // Changes after ConfigurationAdmin has let go of this Configuration are not persisted
+                std::lock_guard<std::mutex> lk { propertiesMutex };
+                store = nullptr;
+            }
             std::lock_guard<std::mutex> lk { configAdminMutex };
             configAdminImpl = nullptr;
         }
+
+        bool
+        ConfigurationImpl::MatchesFilter(LDAPFilter const& filter, AnyMap const& pidMap) const
+        {
+            std::lock_guard<std::mutex> lk { propertiesMutex };
+            if (removed)
+            {
+                return false;
+            }
+            return filter.Match(pidMap) || filter.Match(properties) || filter.Match(properties, pidMap);
+        }
+
+        void
+        ConfigurationImpl::PropertiesUpdated_unlocked()
+        {
+            if (store)
+            {
+                store->Put(pid, changeCount, properties);
+            }
+            if (index)
+            {
+                index->Update(reinterpret_cast<std::uintptr_t>(this), pid, properties);
+            }
+        }
     } // namespace cmimpl
 } // namespace cppmicroservices
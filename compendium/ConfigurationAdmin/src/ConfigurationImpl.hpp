@@ -25,10 +25,13 @@
 
 #include <mutex>
 
+#include "cppmicroservices/LDAPFilter.h"
 #include "cppmicroservices/cm/Configuration.hpp"
 
 #include "ConfigurationAdminPrivate.hpp"
+#include "ConfigurationIndex.hpp"
 #include "ConfigurationPrivate.hpp"
+#include "ConfigurationStore.hpp"
 
 namespace cppmicroservices
 {
@@ -47,7 +50,9 @@ namespace cppmicroservices
                               std::string pid,
                               std::string factoryPid,
                               AnyMap properties,
-                              unsigned long const cCount = 0);
+                              unsigned long const cCount = 0,
+                              std::shared_ptr<ConfigurationStore> store = nullptr,
+                              std::shared_ptr<ConfigurationIndex> index = nullptr);
             ~ConfigurationImpl() override = default;
             ConfigurationImpl(ConfigurationImpl const&) = delete;
             ConfigurationImpl& operator=(ConfigurationImpl const&) = delete;
@@ -145,7 +150,20 @@ namespace cppmicroservices
                 }
             }
 
+            /**
+             * Internal method used by {@code ConfigurationAdminImpl} to match a filter. The filter
+             * matches if it matches \c pidMap, which holds the pid of this Configuration under the
+             * key "pid", or the properties. It also matches if it matches the properties together
+             * with the pid, which is only used if the properties have no "pid" key of their own,
+             * so that a filter can combine both. The properties are not copied. Returns false if
+             * this Configuration has been removed.
+             */
+            bool MatchesFilter(LDAPFilter const& filter, AnyMap const& pidMap) const;
+
           private:
+            // Persist and index the properties, if there is a store or an index. propertiesMutex must be locked.
+            void PropertiesUpdated_unlocked();
+
             std::mutex configAdminMutex;
             ConfigurationAdminPrivate* configAdminImpl;
             mutable std::mutex propertiesMutex;
@@ -154,6 +172,8 @@ namespace cppmicroservices
             AnyMap properties;
             unsigned long changeCount;
             bool removed;
+            std::shared_ptr<ConfigurationStore> store; ///< guarded by propertiesMutex
+            std::shared_ptr<ConfigurationIndex> index;
         };
     } // namespace cmimpl
 } // namespace cppmicroservices
@@ -0,0 +1,399 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ConfigurationIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+namespace cppmicroservices
+{
+    namespace cmimpl
+    {
+        namespace
+        {
+            // A simple term of a filter, (key=value) or (key=value*), which a configuration must satisfy to
+            // match the filter.
+            struct Term
+            {
+                std::string key; // lower case
+                std::string value;
+                bool isPrefix;
+            };
+
+            std::string
+            ToLower(std::string str)
+            {
+                std::transform(str.begin(),
+                               str.end(),
+                               str.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                return str;
+            }
+
+            class FilterParser
+            {
+              public:
+                explicit FilterParser(std::string_view theFilter) : filter(theFilter), pos(0) {}
+
+                // Collect the simple terms which every match of the filter must satisfy. Follows the
+                // grammar accepted by LDAPFilter; returns false if the filter is malformed.
+                bool
+                Parse(std::vector<Term>& terms)
+                {
+                    if (!ParseExpr(true, terms))
+                    {
+                        return false;
+                    }
+                    SkipWhite();
+                    return pos == filter.size();
+                }
+
+              private:
+                bool
+                ParseExpr(bool required, std::vector<Term>& terms)
+                {
+                    SkipWhite();
+                    if (Peek() != '(')
+                    {
+                        return false;
+                    }
+                    ++pos;
+                    SkipWhite();
+                    auto const op = Peek();
+                    if (op != '&' && op != '|' && op != '!')
+                    {
+                        return ParseSimple(required, terms);
+                    }
+                    ++pos;
+                    // Only the operands of a conjunction must all be satisfied
+                    auto const operandsRequired = required && op == '&';
+                    do
+                    {
+                        if (!ParseExpr(operandsRequired, terms))
+                        {
+                            return false;
+                        }
+                        SkipWhite();
+                    } while (Peek() == '(');
+                    if (Peek() != ')')
+                    {
+                        return false;
+                    }
+                    ++pos;
+                    return true;
+                }
+
+                bool
+                ParseSimple(bool required, std::vector<Term>& terms)
+                {
+                    auto const nameStart = pos;
+                    auto nameEnd = pos;
+                    for (char c = Peek(); c != '\0' && std::string_view("()<>=~").find(c) == std::string_view::npos;
+                         c = Peek())
+                    {
+                        if (!std::isspace(static_cast<unsigned char>(c)))
+                        {
+                            nameEnd = pos + 1;
+                        }
+                        ++pos;
+                    }
+                    if (nameEnd == nameStart)
+                    {
+                        return false;
+                    }
+                    auto const isEquality = Peek() == '=';
+                    if (!isEquality)
+                    {
+                        if (Peek() == '\0' || Peek() == '(' || Peek() == ')' || filter.substr(pos + 1, 1) != "=")
+                        {
+                            return false;
+                        }
+                        ++pos;
+                    }
+                    ++pos;
+
+                    std::string value;
+                    std::size_t wildcards = 0;
+                    auto endsWithWildcard = false;
+                    for (int parens = 0;; ++pos)
+                    {
+                        auto const c = Peek();
+                        if (c == '\0')
+                        {
+                            return false;
+                        }
+                        if (c == ')' && parens == 0)
+                        {
+                            break;
+                        }
+                        endsWithWildcard = false;
+                        if (c == '*')
+                        {
+                            ++wildcards;
+                            endsWithWildcard = true;
+                            continue;
+                        }
+                        if (c == '\\')
+                        {
+                            if (++pos == filter.size())
+                            {
+                                return false;
+                            }
+                            value.push_back(filter[pos]);
+                            continue;
+                        }
+                        parens += (c == '(') ? 1 : (c == ')') ? -1 : 0;
+                        value.push_back(c);
+                    }
+                    ++pos;
+
+                    // (key=*) only tests for presence
+                    if (required && isEquality && !value.empty()
+                        && (wildcards == 0 || (wildcards == 1 && endsWithWildcard)))
+                    {
+                        terms.push_back(
+                            Term { ToLower(std::string(filter.substr(nameStart, nameEnd - nameStart))),
+                                   std::move(value),
+                                   wildcards == 1 });
+                    }
+                    return true;
+                }
+
+                char
+                Peek() const
+                {
+                    return pos < filter.size() ? filter[pos] : '\0';
+                }
+
+                void
+                SkipWhite()
+                {
+                    while (std::isspace(static_cast<unsigned char>(Peek())))
+                    {
+                        ++pos;
+                    }
+                }
+
+                std::string_view filter;
+                std::size_t pos;
+            };
+
+            std::string const&
+            KeyOf(std::string const& key)
+            {
+                return key;
+            }
+
+            template <typename T>
+            std::string const&
+            KeyOf(std::pair<std::string const, T> const& element)
+            {
+                return element.first;
+            }
+
+            // Call collect for each element of the sorted container whose key satisfies term
+            template <typename Container, typename Collect>
+            void
+            ForEachMatch(Container const& container, Term const& term, Collect collect)
+            {
+                if (!term.isPrefix)
+                {
+                    if (auto const it = container.find(term.value); it != std::end(container))
+                    {
+                        collect(*it);
+                    }
+                    return;
+                }
+                for (auto it = container.lower_bound(term.value);
+                     it != std::end(container) && KeyOf(*it).compare(0, term.value.size(), term.value) == 0;
+                     ++it)
+                {
+                    collect(*it);
+                }
+            }
+        } // namespace
+
+        ConfigurationIndex::ConfigurationIndex(std::vector<std::string> const& indexedKeys) : keys { "pid" }
+        {
+            for (auto const& key : indexedKeys)
+            {
+                auto lowerKey = ToLower(key);
+                if (!lowerKey.empty() && std::find(keys.begin(), keys.end(), lowerKey) == keys.end())
+                {
+                    keys.push_back(std::move(lowerKey));
+                }
+            }
+            keyIndexes.resize(keys.size());
+        }
+
+        void
+        ConfigurationIndex::Insert(std::uintptr_t owner, std::string const& pid, AnyMap const& properties)
+        {
+            std::lock_guard<std::mutex> lk { indexMutex };
+            auto it = entries.find(pid);
+            if (it == std::end(entries))
+            {
+                it = entries.emplace(pid, Entry {}).first;
+            }
+            else
+            {
+                Unindex_unlocked(pid, it->second);
+            }
+            it->second.owner = owner;
+            Index_unlocked(pid, it->second, properties);
+        }
+
+        void
+        ConfigurationIndex::Update(std::uintptr_t owner, std::string const& pid, AnyMap const& properties)
+        {
+            std::lock_guard<std::mutex> lk { indexMutex };
+            auto const it = entries.find(pid);
+            if (it == std::end(entries) || it->second.owner != owner)
+            {
+                return;
+            }
+            Unindex_unlocked(pid, it->second);
+            Index_unlocked(pid, it->second, properties);
+        }
+
+        void
+        ConfigurationIndex::Remove(std::string const& pid)
+        {
+            std::lock_guard<std::mutex> lk { indexMutex };
+            if (auto const it = entries.find(pid); it != std::end(entries))
+            {
+                Unindex_unlocked(pid, it->second);
+                entries.erase(it);
+            }
+        }
+
+        std::optional<std::vector<std::string>>
+        ConfigurationIndex::FindCandidates(std::string const& filter) const
+        {
+            std::vector<Term> terms;
+            if (!FilterParser(filter).Parse(terms))
+            {
+                return std::nullopt;
+            }
+
+            std::optional<std::vector<std::string>> result;
+            std::lock_guard<std::mutex> lk { indexMutex };
+            for (auto const& term : terms)
+            {
+                auto const keyIt = std::find(keys.begin(), keys.end(), term.key);
+                if (keyIt == keys.end())
+                {
+                    continue;
+                }
+                auto const& keyIndex = keyIndexes[static_cast<std::size_t>(keyIt - keys.begin())];
+
+                // Every term has to be satisfied, so the candidates of the most selective term suffice
+                std::vector<std::string> candidates(keyIndex.unindexed.begin(), keyIndex.unindexed.end());
+                ForEachMatch(keyIndex.values,
+                             term,
+                             [&candidates](auto const& value)
+                             { candidates.insert(candidates.end(), value.second.begin(), value.second.end()); });
+                if (keyIt == keys.begin())
+                {
+                    ForEachMatch(pids, term, [&candidates](std::string const& pid) { candidates.push_back(pid); });
+                }
+                std::sort(candidates.begin(), candidates.end());
+                candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+                if (!result || candidates.size() < result->size())
+                {
+                    result = std::move(candidates);
+                }
+            }
+            return result;
+        }
+
+        void
+        ConfigurationIndex::Index_unlocked(std::string const& pid, Entry& entry, AnyMap const& properties)
+        {
+            entry.values.clear();
+            for (auto const& property : properties)
+            {
+                auto const keyIt = std::find(keys.begin(), keys.end(), ToLower(property.first));
+                if (keyIt == keys.end())
+                {
+                    continue;
+                }
+                auto const keyIndex = static_cast<std::size_t>(keyIt - keys.begin());
+                auto const value = std::find_if(entry.values.begin(),
+                                                entry.values.end(),
+                                                [keyIndex](auto const& v) { return v.first == keyIndex; });
+                if (value != entry.values.end())
+                {
+                    // Case variants of the key; which one a filter uses depends on the type of the map.
+                    value->second.reset();
+                }
+                else if (auto const str = any_cast<std::string>(&property.second))
+                {
+                    entry.values.emplace_back(keyIndex, *str);
+                }
+                else
+                {
+                    entry.values.emplace_back(keyIndex, std::nullopt);
+                }
+            }
+
+            pids.insert(pid);
+            for (auto const& value : entry.values)
+            {
+                auto& keyIndex = keyIndexes[value.first];
+                if (value.second)
+                {
+                    keyIndex.values[*value.second].insert(pid);
+                }
+                else
+                {
+                    keyIndex.unindexed.insert(pid);
+                }
+            }
+        }
+
+        void
+        ConfigurationIndex::Unindex_unlocked(std::string const& pid, Entry const& entry)
+        {
+            pids.erase(pid);
+            for (auto const& value : entry.values)
+            {
+                auto& keyIndex = keyIndexes[value.first];
+                if (!value.second)
+                {
+                    keyIndex.unindexed.erase(pid);
+                }
+                else if (auto const it = keyIndex.values.find(*value.second); it != std::end(keyIndex.values))
+                {
+                    it->second.erase(pid);
+                    if (it->second.empty())
+                    {
+                        keyIndex.values.erase(it);
+                    }
+                }
+            }
+        }
+    } // namespace cmimpl
+} // namespace cppmicroservices
@@ -0,0 +1,123 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CONFIGURATIONINDEX_HPP
+#define CONFIGURATIONINDEX_HPP
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cppmicroservices/AnyMap.h"
+
+namespace cppmicroservices
+{
+    namespace cmimpl
+    {
+
+        /**
+         * Indexes the {@code Configuration} objects of ConfigurationAdmin by pid and by the string values of
+         * selected property keys, so that ListConfigurations does not have to match every configuration.
+         *
+         * The index is only used to narrow down the configurations which can match a filter: every candidate
+         * it returns still has to be matched against the filter. Property keys are compared case insensitively,
+         * like LDAPFilter does. A configuration holding a value of another type than std::string for an indexed
+         * key is a candidate for every filter on that key.
+         *
+         * Each configuration is owned by the object which last inserted it; updates from other objects with the
+         * same pid, e.g. a ConfigurationImpl which has been replaced, are ignored.
+         */
+        class ConfigurationIndex final
+        {
+          public:
+            /**
+             * Create an index for the pid and the given property keys. The "pid" property key is always indexed.
+             */
+            explicit ConfigurationIndex(std::vector<std::string> const& indexedKeys = {});
+            ~ConfigurationIndex() = default;
+            ConfigurationIndex(ConfigurationIndex const&) = delete;
+            ConfigurationIndex& operator=(ConfigurationIndex const&) = delete;
+            ConfigurationIndex(ConfigurationIndex&&) = delete;
+            ConfigurationIndex& operator=(ConfigurationIndex&&) = delete;
+
+            /**
+             * Add the configuration with the given pid, or replace it, and make owner its owner.
+             */
+            void Insert(std::uintptr_t owner, std::string const& pid, AnyMap const& properties);
+
+            /**
+             * Re-index the properties of the configuration with the given pid, if owner is its owner.
+             */
+            void Update(std::uintptr_t owner, std::string const& pid, AnyMap const& properties);
+
+            /**
+             * Remove the configuration with the given pid.
+             */
+            void Remove(std::string const& pid);
+
+            /**
+             * Get the pids of the configurations which can match filter, if the filter requires
+             * an equality or a prefix match of the pid or of an indexed property key. Otherwise,
+             * returns std::nullopt and every configuration has to be matched.
+             */
+            std::optional<std::vector<std::string>> FindCandidates(std::string const& filter) const;
+
+            std::vector<std::string>
+            GetIndexedKeys() const
+            {
+                return keys;
+            }
+
+          private:
+            struct KeyIndex
+            {
+                std::map<std::string, std::set<std::string>> values;
+                std::set<std::string> unindexed; ///< pids with a value which is not a std::string
+            };
+
+            struct Entry
+            {
+                std::uintptr_t owner;
+                // the index in keys and the std::string value, if any, for each indexed key the properties contain
+                std::vector<std::pair<std::size_t, std::optional<std::string>>> values;
+            };
+
+            void Index_unlocked(std::string const& pid, Entry& entry, AnyMap const& properties);
+            void Unindex_unlocked(std::string const& pid, Entry const& entry);
+
+            std::vector<std::string> keys; ///< lower case, "pid" first
+
+            mutable std::mutex indexMutex;
+            std::set<std::string> pids;
+            std::vector<KeyIndex> keyIndexes;
+            std::unordered_map<std::string, Entry> entries;
+        };
+    } // namespace cmimpl
+} // namespace cppmicroservices
+
+#endif // CONFIGURATIONINDEX_HPP
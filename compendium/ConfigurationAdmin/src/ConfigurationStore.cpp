@@ -0,0 +1,384 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ConfigurationStore.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string_view>
+
+#include "cppmicroservices/util/BinaryEncoding.h"
+#include "cppmicroservices/util/FileSystem.h"
+
+using cppmicroservices::logservice::SeverityLevel;
+
+namespace cppmicroservices
+{
+    namespace cmimpl
+    {
+        namespace
+        {
+            // A file starts with its magic. The snapshot then has the sequence number of the last change
+            // it contains. Both files continue with records, each of which is the size and the checksum
+            // of its payload followed by the payload.
+            constexpr std::string_view SNAPSHOT_MAGIC { "CMSNAP01" };
+            constexpr std::string_view LOG_MAGIC { "CMLOG001" };
+            constexpr std::size_t RECORD_HEADER_SIZE = 8;
+
+            enum RecordType : std::uint8_t
+            {
+                RECORD_PUT = 1,
+                RECORD_REMOVE = 2
+            };
+
+            std::string
+            MakeRecord(std::string const& payload)
+            {
+                util::BinaryWriter record;
+                record.buffer.reserve(RECORD_HEADER_SIZE + payload.size());
+                record.WriteSize(payload.size());
+                record.WriteUInt(util::Fnv1a32(payload), 4);
+                record.buffer += payload;
+                return std::move(record.buffer);
+            }
+
+            std::string
+            MakePutRecord(std::uint64_t sequence,
+                          std::string const& pid,
+                          unsigned long changeCount,
+                          std::string const& properties)
+            {
+                util::BinaryWriter payload;
+                payload.WriteUInt(RECORD_PUT, 1);
+                payload.WriteUInt(sequence, 8);
+                payload.WriteString(pid);
+                payload.WriteUInt(changeCount, 8);
+                payload.WriteString(properties);
+                return MakeRecord(payload.buffer);
+            }
+
+            std::string
+            MakeRemoveRecord(std::uint64_t sequence, std::string const& pid)
+            {
+                util::BinaryWriter payload;
+                payload.WriteUInt(RECORD_REMOVE, 1);
+                payload.WriteUInt(sequence, 8);
+                payload.WriteString(pid);
+                return MakeRecord(payload.buffer);
+            }
+        } // namespace
+
+        ConfigurationStore::ConfigurationStore(std::string dir,
+                                               std::shared_ptr<cppmicroservices::logservice::LogService> lggr)
+            : directory(std::move(dir))
+            , snapshotPath(directory + util::DIR_SEP + "configurations.snapshot")
+            , logPath(directory + util::DIR_SEP + "configurations.log")
+            , logger(std::move(lggr))
+            , logRecords(0)
+            , nextSequence(1)
+        {
+            if (!util::Exists(directory))
+            {
+                util::MakePath(directory);
+            }
+            std::lock_guard<std::mutex> lk { storeMutex };
+            Load();
+        }
+
+        std::vector<ConfigurationStore::Entry>
+        ConfigurationStore::GetEntries() const
+        {
+            std::vector<Entry> result;
+            std::lock_guard<std::mutex> lk { storeMutex };
+            result.reserve(entries.size());
+            for (auto const& pidAndEntry : entries)
+            {
+                auto const& properties = pidAndEntry.second.properties;
+                util::BinaryReader reader(properties.data(), properties.size());
+                try
+                {
+                    auto map = reader.ReadMap();
+                    result.push_back(Entry { pidAndEntry.first, pidAndEntry.second.changeCount, std::move(map) });
+                    continue;
+                }
+                catch (std::exception const&)
+                {
+                }
+                logger->Log(SeverityLevel::LOG_ERROR,
+                            "Could not decode the persisted properties of the Configuration with PID "
+                                + pidAndEntry.first);
+            }
+            return result;
+        }
+
+        void
+        ConfigurationStore::Put(std::string const& pid, unsigned long changeCount, AnyMap const& properties)
+        {
+            util::BinaryWriter writer;
+            try
+            {
+                writer.WriteMap(properties);
+            }
+            catch (std::exception const&)
+            {
+                logger->Log(SeverityLevel::LOG_WARNING,
+                            "The properties of the Configuration with PID " + pid
+                                + " contain a value of a type which cannot be persisted.",
+                            std::current_exception());
+                Remove(pid);
+                return;
+            }
+            auto encoded = std::move(writer.buffer);
+
+            std::lock_guard<std::mutex> lk { storeMutex };
+            auto it = entries.find(pid);
+            if (it != std::end(entries) && it->second.changeCount == changeCount && it->second.properties == encoded)
+            {
+                return;
+            }
+            Append(MakePutRecord(nextSequence++, pid, changeCount, encoded));
+            entries[pid] = StoredEntry { changeCount, std::move(encoded) };
+            CompactIfLarge_unlocked();
+        }
+
+        void
+        ConfigurationStore::Remove(std::string const& pid)
+        {
+            std::lock_guard<std::mutex> lk { storeMutex };
+            auto it = entries.find(pid);
+            if (it == std::end(entries))
+            {
+                return;
+            }
+            Append(MakeRemoveRecord(nextSequence++, pid));
+            entries.erase(it);
+            CompactIfLarge_unlocked();
+        }
+
+        void
+        ConfigurationStore::Compact()
+        {
+            std::lock_guard<std::mutex> lk { storeMutex };
+            Compact_unlocked();
+        }
+
+        void
+        ConfigurationStore::Load()
+        {
+            // A crash while replacing the snapshot may leave only the new one behind, which is complete
+            // as the old snapshot is removed after the new one is written.
+            auto const tmpPath = snapshotPath + ".tmp";
+            if (!util::Exists(snapshotPath) && util::Exists(tmpPath))
+            {
+                std::rename(tmpPath.c_str(), snapshotPath.c_str());
+            }
+
+            std::uint64_t snapshotSequence = 0;
+            if (util::Exists(snapshotPath) && !LoadFile(snapshotPath, true, snapshotSequence))
+            {
+                logger->Log(SeverityLevel::LOG_ERROR,
+                            "The configuration snapshot " + snapshotPath
+                                + " is damaged. Configurations after the damaged part are lost.");
+            }
+            nextSequence = snapshotSequence + 1;
+
+            if (!util::Exists(logPath))
+            {
+                OpenLog(true);
+            }
+            else if (LoadFile(logPath, false, snapshotSequence))
+            {
+                OpenLog(false);
+            }
+            else
+            {
+                // Appending to the log would leave the new records behind the incomplete one
+                logger->Log(SeverityLevel::LOG_WARNING,
+                            "Discarding an incomplete record at the end of the configuration log " + logPath);
+                Compact_unlocked();
+            }
+        }
+
+        bool
+        ConfigurationStore::LoadFile(std::string const& path, bool isSnapshot, std::uint64_t& snapshotSequence)
+        {
+            std::string data;
+            {
+                std::ifstream file(path, std::ios_base::binary | std::ios_base::ate);
+                auto const size = file ? static_cast<std::streamoff>(file.tellg()) : std::streamoff(0);
+                data.resize(static_cast<std::size_t>(size > 0 ? size : 0));
+                file.seekg(0);
+                if (!file.read(&data[0], static_cast<std::streamsize>(data.size())))
+                {
+                    return false;
+                }
+            }
+
+            auto const magic = isSnapshot ? SNAPSHOT_MAGIC : LOG_MAGIC;
+            if (data.compare(0, magic.size(), magic) != 0)
+            {
+                return false;
+            }
+            util::BinaryReader reader(data.data() + magic.size(), data.size() - magic.size());
+            try
+            {
+                if (isSnapshot)
+                {
+                    snapshotSequence = reader.ReadUInt(8);
+                }
+
+                while (!reader.AtEnd())
+                {
+                    auto const size = reader.ReadSize();
+                    auto const checksum = reader.ReadUInt(4);
+                    auto const payload = reader.ReadBytes(size);
+                    if (util::Fnv1a32(payload) != checksum)
+                    {
+                        return false;
+                    }
+
+                    util::BinaryReader record(payload.data(), payload.size());
+                    auto const type = record.ReadUInt(1);
+                    auto const sequence = record.ReadUInt(8);
+                    std::string pid(record.ReadString());
+                    if (type == RECORD_PUT)
+                    {
+                        auto const changeCount = static_cast<unsigned long>(record.ReadUInt(8));
+                        std::string properties(record.ReadString());
+                        if (isSnapshot || sequence > snapshotSequence)
+                        {
+                            entries[pid] = StoredEntry { changeCount, std::move(properties) };
+                        }
+                    }
+                    else if (type == RECORD_REMOVE)
+                    {
+                        if (isSnapshot || sequence > snapshotSequence)
+                        {
+                            entries.erase(pid);
+                        }
+                    }
+                    else
+                    {
+                        return false;
+                    }
+
+                    if (!isSnapshot)
+                    {
+                        ++logRecords;
+                        nextSequence = std::max(nextSequence, sequence + 1);
+                    }
+                }
+            }
+            catch (std::runtime_error const&)
+            {
+                // a truncated record
+                return false;
+            }
+            return true;
+        }
+
+        void
+        ConfigurationStore::Append(std::string const& record)
+        {
+            log.write(record.data(), static_cast<std::streamsize>(record.size()));
+            log.flush();
+            if (!log)
+            {
+                log.clear();
+                logger->Log(SeverityLevel::LOG_ERROR, "Could not write to the configuration log " + logPath);
+                return;
+            }
+            ++logRecords;
+        }
+
+        void
+        ConfigurationStore::CompactIfLarge_unlocked()
+        {
+            if (logRecords < MIN_RECORDS_TO_COMPACT || logRecords < 2 * entries.size())
+            {
+                return;
+            }
+            try
+            {
+                Compact_unlocked();
+            }
+            catch (std::exception const&)
+            {
+                logger->Log(SeverityLevel::LOG_ERROR,
+                            "Could not compact the configuration store in " + directory,
+                            std::current_exception());
+            }
+        }
+
+        void
+        ConfigurationStore::Compact_unlocked()
+        {
+            util::BinaryWriter writer;
+            writer.buffer = SNAPSHOT_MAGIC;
+            writer.WriteUInt(nextSequence - 1, 8);
+            for (auto const& pidAndEntry : entries)
+            {
+                auto const& entry = pidAndEntry.second;
+                writer.buffer += MakePutRecord(0, pidAndEntry.first, entry.changeCount, entry.properties);
+            }
+            auto const& data = writer.buffer;
+
+            auto const tmpPath = snapshotPath + ".tmp";
+            {
+                std::ofstream file(tmpPath, std::ios_base::binary | std::ios_base::trunc);
+                file.write(data.data(), static_cast<std::streamsize>(data.size()));
+                file.close();
+                if (!file)
+                {
+                    throw std::runtime_error("Could not write the configuration snapshot " + tmpPath);
+                }
+            }
+            // std::rename does not replace an existing file on every platform
+            if (std::rename(tmpPath.c_str(), snapshotPath.c_str()) != 0
+                && (std::remove(snapshotPath.c_str()) != 0 || std::rename(tmpPath.c_str(), snapshotPath.c_str()) != 0))
+            {
+                throw std::runtime_error("Could not replace the configuration snapshot " + snapshotPath);
+            }
+            // The records left in the log if this fails are in the snapshot and skipped when loading.
+            OpenLog(true);
+        }
+
+        void
+        ConfigurationStore::OpenLog(bool truncate)
+        {
+            log.close();
+            log.clear();
+            log.open(logPath, std::ios_base::binary | (truncate ? std::ios_base::trunc : std::ios_base::app));
+            if (truncate)
+            {
+                log.write(LOG_MAGIC.data(), static_cast<std::streamsize>(LOG_MAGIC.size()));
+                log.flush();
+                logRecords = 0;
+            }
+            if (!log)
+            {
+                throw std::runtime_error("Could not open the configuration log " + logPath);
+            }
+        }
+    } // namespace cmimpl
+} // namespace cppmicroservices
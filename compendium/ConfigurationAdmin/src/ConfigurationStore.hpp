@@ -0,0 +1,142 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CONFIGURATIONSTORE_HPP
+#define CONFIGURATIONSTORE_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cppmicroservices/AnyMap.h"
+#include "cppmicroservices/logservice/LogService.hpp"
+
+namespace cppmicroservices
+{
+    namespace cmimpl
+    {
+
+        /**
+         * Persists the updated {@code Configuration} objects of ConfigurationAdmin in a local directory.
+         *
+         * Every change is appended as one record to a change log. When the log has grown large compared to
+         * the number of configurations, the current state is written to a snapshot and the log is emptied.
+         * Loading the store reads the snapshot and the log once, sequentially.
+         *
+         * Records are checksummed. An incomplete record at the end of the log, e.g. from a crash while
+         * appending, is discarded when the store is opened. The properties of a configuration can be
+         * persisted if they only contain values of type bool, int, unsigned int, long, unsigned long,
+         * long long, unsigned long long, float, double, std::string, AnyMap or std::vector<Any> of these.
+         */
+        class ConfigurationStore final
+        {
+          public:
+            struct Entry
+            {
+                std::string pid;
+                unsigned long changeCount;
+                AnyMap properties;
+            };
+
+            /**
+             * Open the store in directory, creating the directory if it does not exist,
+             * and load the persisted configurations.
+             *
+             * @throws std::runtime_error if the directory cannot be created or the store cannot be written.
+             */
+            ConfigurationStore(std::string directory,
+                               std::shared_ptr<cppmicroservices::logservice::LogService> logger);
+            ~ConfigurationStore() = default;
+            ConfigurationStore(ConfigurationStore const&) = delete;
+            ConfigurationStore& operator=(ConfigurationStore const&) = delete;
+            ConfigurationStore(ConfigurationStore&&) = delete;
+            ConfigurationStore& operator=(ConfigurationStore&&) = delete;
+
+            /**
+             * Get the configurations loaded when the store was opened, or persisted since.
+             */
+            std::vector<Entry> GetEntries() const;
+
+            /**
+             * Append a record for the updated properties of a configuration.
+             *
+             * If the properties contain a value which cannot be persisted, the configuration is removed
+             * from the store instead, so that an outdated state is not restored later. Failures are logged.
+             */
+            void Put(std::string const& pid, unsigned long changeCount, AnyMap const& properties);
+
+            /**
+             * Append a record for the removal of a configuration, if the store contains it.
+             */
+            void Remove(std::string const& pid);
+
+            /**
+             * Write the current state to the snapshot and empty the change log.
+             */
+            void Compact();
+
+            std::string
+            GetDirectory() const
+            {
+                return directory;
+            }
+
+            /**
+             * The log is compacted when it has at least this many records and
+             * twice as many records as there are configurations.
+             */
+            static constexpr std::size_t MIN_RECORDS_TO_COMPACT = 1024;
+
+          private:
+            struct StoredEntry
+            {
+                unsigned long changeCount;
+                std::string properties; // encoded
+            };
+
+            void Load();
+            // Apply the records of the snapshot or the log. Returns false if the file is incomplete.
+            bool LoadFile(std::string const& path, bool isSnapshot, std::uint64_t& snapshotSequence);
+            void Append(std::string const& record);
+            void CompactIfLarge_unlocked();
+            void Compact_unlocked();
+            void OpenLog(bool truncate);
+
+            std::string const directory;
+            std::string const snapshotPath;
+            std::string const logPath;
+            std::shared_ptr<cppmicroservices::logservice::LogService> logger;
+
+            mutable std::mutex storeMutex;
+            std::unordered_map<std::string, StoredEntry> entries;
+            std::ofstream log;
+            std::size_t logRecords;
+            std::uint64_t nextSequence;
+        };
+    } // namespace cmimpl
+} // namespace cppmicroservices
+
+#endif // CONFIGURATIONSTORE_HPP
@@ -1065,5 +1065,97 @@ namespace cppmicroservices
 
             configAdmin.WaitForAllAsync();
         }
+
+        /* With CM_COALESCE_UPDATES, updates made while the notification of a previous update is pending
+         * are delivered with it. The notifications are queued by the AsyncWorkService until the test runs them.
+         */
+        TEST(TestConfigurationAdminImplCoalescing, VerifyPendingUpdatesAreCoalesced)
+        {
+            struct QueueingAsyncWorkService final : public cppmicroservices::async::AsyncWorkService
+            {
+                void
+                post(std::packaged_task<void()>&& task) override
+                {
+                    std::lock_guard<std::mutex> lk { mutex };
+                    tasks.push_back(std::move(task));
+                }
+
+                void
+                RunAll()
+                {
+                    std::vector<std::packaged_task<void()>> toRun;
+                    {
+                        std::lock_guard<std::mutex> lk { mutex };
+                        toRun.swap(tasks);
+                    }
+                    for (auto& task : toRun)
+                    {
+                        task();
+                    }
+                }
+
+                std::mutex mutex;
+                std::vector<std::packaged_task<void()>> tasks;
+            };
+
+            struct CountingListener final : public cppmicroservices::service::cm::ConfigurationListener
+            {
+                void
+                configurationEvent(cppmicroservices::service::cm::ConfigurationEvent const&) noexcept override
+                {
+                    ++events;
+                }
+
+                std::atomic<int> events { 0 };
+            };
+
+            auto framework = cppmicroservices::FrameworkFactory().NewFramework(
+                FrameworkConfiguration { { cppmicroservices::service::cm::CM_COALESCE_UPDATES, true } });
+            framework.Start();
+            auto bundleContext = framework.GetBundleContext();
+            auto listener = std::make_shared<CountingListener>();
+            auto listenerReg
+                = bundleContext.RegisterService<cppmicroservices::service::cm::ConfigurationListener>(listener);
+            auto fakeLogger = std::make_shared<FakeLogger>();
+            auto asyncWorkService = std::make_shared<QueueingAsyncWorkService>();
+            {
+                ConfigurationAdminImpl configAdmin(bundleContext, fakeLogger, asyncWorkService);
+                auto configuration = configAdmin.GetConfiguration("coalesced.pid");
+                AnyMap props { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+
+                std::vector<std::shared_future<void>> updated;
+                for (int i = 0; i < 10; ++i)
+                {
+                    props["count"] = i;
+                    updated.push_back(configuration->Update(props));
+                }
+                EXPECT_EQ(asyncWorkService->tasks.size(), 1u);
+                asyncWorkService->RunAll();
+                for (auto const& fut : updated)
+                {
+                    EXPECT_EQ(fut.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+                }
+                EXPECT_EQ(listener->events, 1);
+
+                // Once the notification has started, the next update is notified separately
+                props["count"] = 10;
+                auto last = configuration->Update(props);
+                asyncWorkService->RunAll();
+                last.get();
+                EXPECT_EQ(listener->events, 2);
+
+                // The counters are available through the ConfigurationAdmin service interface
+                cppmicroservices::service::cm::ConfigurationAdmin const& service = configAdmin;
+                auto const statistics = service.GetUpdateNotificationStatistics();
+                EXPECT_EQ(statistics.scheduled, 2u);
+                EXPECT_EQ(statistics.coalesced, 9u);
+                EXPECT_EQ(configuration->GetChangeCount(), 11u);
+                configAdmin.WaitForAllAsync();
+            }
+
+            listenerReg.Unregister();
+            framework.Stop();
+            framework.WaitForStop(std::chrono::milliseconds::zero());
+        }
     } // namespace cmimpl
 } // namespace cppmicroservices
@@ -0,0 +1,206 @@
+/*=============================================================================
+
+ Library: CppMicroServices
+
+ Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+ file at the top-level directory of this distribution and at
+ https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+
+ =============================================================================*/
+
+
+#include <algorithm>
+#include <chrono>
+
+#include "gmock/gmock.h"
+
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/cm/ConfigurationAdmin.hpp"
+
+#include "../src/CMAsyncWorkService.hpp"
+#include "../src/ConfigurationAdminImpl.hpp"
+#include "../src/ConfigurationIndex.hpp"
+#include "Mocks.hpp"
+
+namespace cppmicroservices
+{
+    namespace cmimpl
+    {
+        namespace
+        {
+            AnyMap
+            MakeProperties(std::string const& key, Any value)
+            {
+                AnyMap props { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+                props[key] = std::move(value);
+                return props;
+            }
+
+            std::vector<std::string>
+            GetPids(std::vector<std::shared_ptr<cppmicroservices::service::cm::Configuration>> const& configurations)
+            {
+                std::vector<std::string> pids;
+                for (auto const& configuration : configurations)
+                {
+                    pids.push_back(configuration->GetPid());
+                }
+                std::sort(pids.begin(), pids.end());
+                return pids;
+            }
+        } // namespace
+
+        TEST(TestConfigurationIndex, VerifyPidAndPropertyCandidates)
+        {
+            using ::testing::ElementsAre;
+
+            ConfigurationIndex index({ "Region" });
+            index.Insert(1u, "billing~a", MakeProperties("region", std::string("emea")));
+            index.Insert(2u, "billing~b", MakeProperties("REGION", std::string("apac")));
+            index.Insert(3u, "other", MakeProperties("pid", std::string("billing~c")));
+            index.Insert(4u, "numeric", MakeProperties("region", 42));
+
+            EXPECT_THAT(*index.FindCandidates("(pid=billing~a)"), ElementsAre("billing~a"));
+            // A "pid" property can match the filter too
+            EXPECT_THAT(*index.FindCandidates("(pid=billing~*)"), ElementsAre("billing~a", "billing~b", "other"));
+            EXPECT_THAT(*index.FindCandidates("(region=apac)"), ElementsAre("billing~b", "numeric"));
+            EXPECT_THAT(*index.FindCandidates(" ( & (x=1) (Region =emea) ) "), ElementsAre("billing~a", "numeric"));
+            EXPECT_THAT(*index.FindCandidates("(&(pid=billing~b)(region=emea))"), ElementsAre("billing~b"));
+            EXPECT_THAT(*index.FindCandidates("(pid=billing\\*)"), ElementsAre());
+        }
+
+        TEST(TestConfigurationIndex, VerifyFiltersWithoutRequiredTerm)
+        {
+            ConfigurationIndex index({ "region" });
+            index.Insert(1u, "billing~a", MakeProperties("region", std::string("emea")));
+
+            EXPECT_FALSE(index.FindCandidates("(|(pid=billing~a)(region=emea))"));
+            EXPECT_FALSE(index.FindCandidates("(!(region=emea))"));
+            EXPECT_FALSE(index.FindCandidates("(region=e*a)"));
+            EXPECT_FALSE(index.FindCandidates("(region=*)"));
+            EXPECT_FALSE(index.FindCandidates("(region~=EMEA)"));
+            EXPECT_FALSE(index.FindCandidates("(pid<=billing)"));
+            EXPECT_FALSE(index.FindCandidates("(unindexed=value)"));
+        }
+
+        TEST(TestConfigurationIndex, VerifyOnlyOwnerUpdates)
+        {
+            using ::testing::ElementsAre;
+
+            ConfigurationIndex index({ "region" });
+            index.Insert(1u, "billing~a", MakeProperties("region", std::string("emea")));
+            index.Update(2u, "billing~a", MakeProperties("region", std::string("apac")));
+            EXPECT_THAT(*index.FindCandidates("(region=emea)"), ElementsAre("billing~a"));
+
+            index.Update(1u, "billing~a", MakeProperties("region", std::string("apac")));
+            EXPECT_THAT(*index.FindCandidates("(region=emea)"), ElementsAre());
+            EXPECT_THAT(*index.FindCandidates("(region=apac)"), ElementsAre("billing~a"));
+
+            // A replacement takes over the pid
+            index.Insert(2u, "billing~a", MakeProperties("region", std::string("emea")));
+            index.Update(1u, "billing~a", MakeProperties("region", std::string("apac")));
+            EXPECT_THAT(*index.FindCandidates("(region=emea)"), ElementsAre("billing~a"));
+
+            index.Remove("billing~a");
+            EXPECT_THAT(*index.FindCandidates("(pid=billing~a)"), ElementsAre());
+            EXPECT_THAT(*index.FindCandidates("(region=emea)"), ElementsAre());
+        }
+
+        TEST(TestConfigurationIndex, VerifyListConfigurationsUsesIndexedProperties)
+        {
+            using ::testing::ElementsAre;
+
+            auto framework = cppmicroservices::FrameworkFactory().NewFramework(
+                FrameworkConfiguration { { cppmicroservices::service::cm::CM_INDEXED_PROPERTIES,
+                                           std::vector<std::string> { "region" } } });
+            framework.Start();
+            auto bundleContext = framework.GetBundleContext();
+            auto logger = std::make_shared<FakeLogger>();
+            auto asyncWorkService = std::make_shared<CMAsyncWorkService>(bundleContext, logger);
+            {
+                ConfigurationAdminImpl configAdmin(bundleContext, logger, asyncWorkService);
+                configAdmin.GetFactoryConfiguration("billing", "a")
+                    ->Update(MakeProperties("region", std::string("emea")))
+                    .get();
+                configAdmin.GetFactoryConfiguration("billing", "b")
+                    ->Update(MakeProperties("region", std::string("apac")))
+                    .get();
+                auto const shipping = configAdmin.GetFactoryConfiguration("shipping", "a");
+                shipping->Update(MakeProperties("region", std::string("apac"))).get();
+                // Never updated, so not listed
+                configAdmin.GetFactoryConfiguration("billing", "c");
+
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(pid=billing~*)")),
+                            ElementsAre("billing~a", "billing~b"));
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(region=apac)")),
+                            ElementsAre("billing~b", "shipping~a"));
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(&(pid=billing~*)(region=apac))")),
+                            ElementsAre("billing~b"));
+
+                shipping->Update(MakeProperties("region", std::string("emea"))).get();
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(region=apac)")), ElementsAre("billing~b"));
+
+                configAdmin.GetConfiguration("billing~b")->Remove().get();
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(region=apac)")), ElementsAre());
+                configAdmin.WaitForAllAsync();
+            }
+            framework.Stop();
+            framework.WaitForStop(std::chrono::milliseconds::zero());
+        }
+
+        TEST(TestConfigurationIndex, VerifyListConfigurationsMatchesPidAndProperties)
+        {
+            using ::testing::ElementsAre;
+
+            auto framework = cppmicroservices::FrameworkFactory().NewFramework();
+            framework.Start();
+            auto bundleContext = framework.GetBundleContext();
+            auto logger = std::make_shared<FakeLogger>();
+            auto asyncWorkService = std::make_shared<CMAsyncWorkService>(bundleContext, logger);
+            {
+                ConfigurationAdminImpl configAdmin(bundleContext, logger, asyncWorkService);
+                configAdmin.GetFactoryConfiguration("billing", "a")
+                    ->Update(MakeProperties("region", std::string("emea")))
+                    .get();
+                configAdmin.GetFactoryConfiguration("billing", "b")
+                    ->Update(MakeProperties("region", std::string("apac")))
+                    .get();
+                auto properties = MakeProperties("pid", std::string("billing~c"));
+                properties["region"] = std::string("apac");
+                configAdmin.GetConfiguration("other")->Update(properties).get();
+
+                // The pid and the properties can be combined
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(&(pid=billing~*)(region=apac))")),
+                            ElementsAre("billing~b", "other"));
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(&(pid=billing~a)(!(region=apac)))")),
+                            ElementsAre("billing~a"));
+                // A "pid" property is not replaced by the pid of the configuration
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(&(pid=other)(region=apac))")), ElementsAre());
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(pid=other)")), ElementsAre("other"));
+                // A negated filter matches if it matches the pid or the properties on their own
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(!(pid=billing~a))")),
+                            ElementsAre("billing~a", "billing~b", "other"));
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(!(pid=*))")),
+                            ElementsAre("billing~a", "billing~b"));
+                EXPECT_THAT(GetPids(configAdmin.ListConfigurations("(!(region=*))")),
+                            ElementsAre("billing~a", "billing~b", "other"));
+                configAdmin.WaitForAllAsync();
+            }
+            framework.Stop();
+            framework.WaitForStop(std::chrono::milliseconds::zero());
+        }
+    } // namespace cmimpl
+} // namespace cppmicroservices
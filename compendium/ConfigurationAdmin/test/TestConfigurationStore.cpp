@@ -0,0 +1,221 @@
+/*=============================================================================
+
+ Library: CppMicroServices
+
+ Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+ file at the top-level directory of this distribution and at
+ https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+
+ =============================================================================*/
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "gmock/gmock.h"
+
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+
+#include "../src/CMAsyncWorkService.hpp"
+#include "../src/ConfigurationAdminImpl.hpp"
+#include "../src/ConfigurationStore.hpp"
+#include "Mocks.hpp"
+
+namespace cppmicroservices
+{
+    namespace cmimpl
+    {
+        // The fixture for testing class ConfigurationStore. Each test uses a new directory.
+        class TestConfigurationStore : public ::testing::Test
+        {
+          protected:
+            TestConfigurationStore()
+                : directory((std::filesystem::temp_directory_path()
+                             / ("cm_store_test_" + std::to_string(std::random_device {}())))
+                                .string())
+                , logger(std::make_shared<FakeLogger>())
+            {
+            }
+
+            ~TestConfigurationStore() override
+            {
+                std::error_code ec;
+                std::filesystem::remove_all(directory, ec);
+            }
+
+            static AnyMap
+            MakeProperties()
+            {
+                AnyMap nested { AnyMap::ORDERED_MAP };
+                nested["list"] = std::vector<Any> { Any(1), Any(std::string("two")), Any(3.0) };
+                AnyMap props { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+                props["bool"] = true;
+                props["int"] = -42;
+                props["long"] = 1234567890123L;
+                props["unsigned"] = 7u;
+                props["double"] = 0.25;
+                props["string"] = std::string("value");
+                props["nested"] = nested;
+                return props;
+            }
+
+            std::string directory;
+            std::shared_ptr<FakeLogger> logger;
+        };
+
+        TEST_F(TestConfigurationStore, VerifyPutAndRemoveArePersisted)
+        {
+            auto const props = MakeProperties();
+            {
+                ConfigurationStore store(directory, logger);
+                EXPECT_THAT(store.GetEntries(), testing::IsEmpty());
+                store.Put("pid1", 1u, props);
+                store.Put("pid2", 1u, props);
+                store.Put("factory~instance", 3u, props);
+                store.Remove("pid2");
+            }
+
+            ConfigurationStore store(directory, logger);
+            auto entries = store.GetEntries();
+            ASSERT_EQ(entries.size(), 2u);
+            std::sort(entries.begin(), entries.end(), [](auto const& l, auto const& r) { return l.pid < r.pid; });
+            EXPECT_EQ(entries[0].pid, "factory~instance");
+            EXPECT_EQ(entries[0].changeCount, 3u);
+            EXPECT_EQ(entries[1].pid, "pid1");
+            EXPECT_EQ(entries[1].changeCount, 1u);
+
+            // The types of the values are preserved
+            auto const& restored = entries[1].properties;
+            EXPECT_EQ(restored.GetType(), AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+            EXPECT_EQ(restored, props);
+            EXPECT_EQ(any_cast<long>(restored.at("LONG")), 1234567890123L);
+            EXPECT_EQ(any_cast<unsigned int>(restored.at("unsigned")), 7u);
+            EXPECT_EQ(ref_any_cast<AnyMap>(restored.at("nested")).GetType(), AnyMap::ORDERED_MAP);
+        }
+
+        TEST_F(TestConfigurationStore, VerifyUnsupportedValueRemovesConfiguration)
+        {
+            {
+                ConfigurationStore store(directory, logger);
+                store.Put("pid", 1u, MakeProperties());
+                AnyMap props { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+                props["pointer"] = std::make_shared<int>(1);
+                store.Put("pid", 2u, props);
+            }
+            ConfigurationStore store(directory, logger);
+            EXPECT_THAT(store.GetEntries(), testing::IsEmpty());
+        }
+
+        TEST_F(TestConfigurationStore, VerifyIncompleteRecordIsDiscarded)
+        {
+            {
+                ConfigurationStore store(directory, logger);
+                store.Put("pid", 1u, MakeProperties());
+                store.Put("pid", 2u, MakeProperties());
+            }
+            auto const logPath = std::filesystem::path(directory) / "configurations.log";
+            std::filesystem::resize_file(logPath, std::filesystem::file_size(logPath) - 1);
+            {
+                ConfigurationStore store(directory, logger);
+                auto const entries = store.GetEntries();
+                ASSERT_EQ(entries.size(), 1u);
+                EXPECT_EQ(entries[0].changeCount, 1u);
+                store.Put("pid", 3u, MakeProperties());
+            }
+            // Records appended after the incomplete one was discarded are read
+            ConfigurationStore store(directory, logger);
+            auto const entries = store.GetEntries();
+            ASSERT_EQ(entries.size(), 1u);
+            EXPECT_EQ(entries[0].changeCount, 3u);
+        }
+
+        TEST_F(TestConfigurationStore, VerifyLogIsCompacted)
+        {
+            auto const logPath = std::filesystem::path(directory) / "configurations.log";
+            unsigned long changeCount = 0;
+            {
+                ConfigurationStore store(directory, logger);
+                store.Put("other", 5u, MakeProperties());
+                auto const sizeBefore = std::filesystem::file_size(logPath);
+                store.Put("pid", ++changeCount, MakeProperties());
+                auto const recordSize = std::filesystem::file_size(logPath) - sizeBefore;
+                for (std::size_t i = 0; i < 3 * ConfigurationStore::MIN_RECORDS_TO_COMPACT; ++i)
+                {
+                    store.Put("pid", ++changeCount, MakeProperties());
+                }
+                // Without compaction, the log would have all the records
+                EXPECT_LT(std::filesystem::file_size(logPath), ConfigurationStore::MIN_RECORDS_TO_COMPACT * recordSize);
+            }
+            EXPECT_TRUE(std::filesystem::exists(std::filesystem::path(directory) / "configurations.snapshot"));
+
+            ConfigurationStore store(directory, logger);
+            auto entries = store.GetEntries();
+            ASSERT_EQ(entries.size(), 2u);
+            std::sort(entries.begin(), entries.end(), [](auto const& l, auto const& r) { return l.pid < r.pid; });
+            EXPECT_EQ(entries[0].pid, "other");
+            EXPECT_EQ(entries[0].changeCount, 5u);
+            EXPECT_EQ(entries[1].pid, "pid");
+            EXPECT_EQ(entries[1].changeCount, changeCount);
+
+            // Compacting again leaves an empty log and the same state
+            store.Compact();
+            ConfigurationStore reopened(directory, logger);
+            EXPECT_EQ(reopened.GetEntries().size(), 2u);
+        }
+
+        TEST_F(TestConfigurationStore, VerifyConfigurationAdminRestoresConfigurations)
+        {
+            auto framework = cppmicroservices::FrameworkFactory().NewFramework();
+            framework.Start();
+            auto bundleContext = framework.GetBundleContext();
+            auto asyncWorkService = std::make_shared<CMAsyncWorkService>(bundleContext, logger);
+
+            AnyMap props { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+            props["foo"] = std::string("bar");
+            {
+                auto store = std::make_shared<ConfigurationStore>(directory, logger);
+                ConfigurationAdminImpl configAdmin(bundleContext, logger, asyncWorkService, store);
+                configAdmin.GetConfiguration("test.pid")->Update(props).get();
+                configAdmin.GetConfiguration("test.pid")->Update(props).get();
+                configAdmin.GetFactoryConfiguration("factory", "instance")->Update(props).get();
+                auto removed = configAdmin.GetConfiguration("removed.pid");
+                removed->Update(props).get();
+                removed->Remove().get();
+                // Never updated, so not persisted
+                configAdmin.GetConfiguration("empty.pid");
+                configAdmin.WaitForAllAsync();
+            }
+
+            auto store = std::make_shared<ConfigurationStore>(directory, logger);
+            ConfigurationAdminImpl configAdmin(bundleContext, logger, asyncWorkService, store);
+            auto const configurations = configAdmin.ListConfigurations();
+            EXPECT_EQ(configurations.size(), 2u);
+
+            auto const conf = configAdmin.GetConfiguration("test.pid");
+            EXPECT_EQ(conf->GetChangeCount(), 2u);
+            EXPECT_EQ(conf->GetProperties(), props);
+            auto const factoryConf = configAdmin.ListConfigurations("(pid=factory~instance)");
+            ASSERT_EQ(factoryConf.size(), 1u);
+            EXPECT_EQ(factoryConf[0]->GetFactoryPid(), "factory");
+            EXPECT_EQ(configAdmin.GetConfiguration("removed.pid")->GetChangeCount(), 0u);
+
+            framework.Stop();
+            framework.WaitForStop(std::chrono::milliseconds::zero());
+        }
+    } // namespace cmimpl
+} // namespace cppmicroservices
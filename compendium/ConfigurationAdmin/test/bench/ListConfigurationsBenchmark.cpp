@@ -0,0 +1,126 @@
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/cm/ConfigurationAdmin.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "../../src/CMAsyncWorkService.hpp"
+#include "../../src/CMLogger.hpp"
+#include "../../src/ConfigurationAdminImpl.hpp"
+#include "benchmark/benchmark.h"
+
+using cppmicroservices::service::cm::CM_INDEXED_PROPERTIES;
+
+namespace
+{
+    constexpr int FACTORY_COUNT = 100;
+    constexpr int REGION_COUNT = 10;
+} // namespace
+
+/**
+ * Creates a ConfigurationAdminImpl with as many factory configurations as the
+ * benchmark argument, spread over FACTORY_COUNT factory pids. Each configuration
+ * has an indexed "region" property and an unindexed "tier" property.
+ */
+class ListConfigurationsFixture : public ::benchmark::Fixture
+{
+  public:
+    using benchmark::Fixture::SetUp;
+    using benchmark::Fixture::TearDown;
+
+    void
+    SetUp(::benchmark::State const& state)
+    {
+        using namespace cppmicroservices;
+
+        FrameworkConfiguration config { { CM_INDEXED_PROPERTIES, std::vector<std::string> { "region" } } };
+        framework = std::make_shared<Framework>(FrameworkFactory().NewFramework(config));
+        framework->Start();
+        auto context = framework->GetBundleContext();
+        auto logger = std::make_shared<cmimpl::CMLogger>(context);
+        configAdmin = std::make_shared<cmimpl::ConfigurationAdminImpl>(
+            context,
+            logger,
+            std::make_shared<cmimpl::CMAsyncWorkService>(context, logger));
+
+        for (int i = 0; i < state.range(0); ++i)
+        {
+            AnyMap props { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+            props["region"] = "region" + std::to_string(i % REGION_COUNT);
+            props["tier"] = std::string(i % 2 == 0 ? "gold" : "silver");
+            props["index"] = i;
+            auto configuration = std::static_pointer_cast<cmimpl::ConfigurationImpl>(
+                configAdmin->GetFactoryConfiguration("factory" + std::to_string(i % FACTORY_COUNT),
+                                                     "instance" + std::to_string(i)));
+            // Skip the notifications, there is nobody to notify.
+            configuration->UpdateWithoutNotificationIfDifferent(std::move(props));
+        }
+    }
+
+    void
+    TearDown(::benchmark::State const&)
+    {
+        using namespace std::chrono;
+
+        configAdmin.reset();
+        framework->Stop();
+        framework->WaitForStop(milliseconds::zero());
+    }
+
+    ~ListConfigurationsFixture() { framework.reset(); };
+
+    void
+    List(benchmark::State& state, std::string const& filter)
+    {
+        std::size_t found = 0;
+        for (auto _ : state)
+        {
+            found = configAdmin->ListConfigurations(filter).size();
+            benchmark::DoNotOptimize(found);
+        }
+        state.counters["found"] = static_cast<double>(found);
+    }
+
+    std::shared_ptr<cppmicroservices::Framework> framework;
+    std::shared_ptr<cppmicroservices::cmimpl::ConfigurationAdminImpl> configAdmin;
+};
+
+/// Benchmark listing a configuration by its pid
+BENCHMARK_DEFINE_F(ListConfigurationsFixture, ListByPid)
+(benchmark::State& state) { List(state, "(pid=factory7~instance7)"); }
+
+/// Benchmark listing the configurations of a factory pid
+BENCHMARK_DEFINE_F(ListConfigurationsFixture, ListByFactoryPid)
+(benchmark::State& state) { List(state, "(pid=factory7~*)"); }
+
+/// Benchmark listing the configurations with a value of an indexed property and of a property which is not indexed
+BENCHMARK_DEFINE_F(ListConfigurationsFixture, ListByIndexedProperty)
+(benchmark::State& state) { List(state, "(&(region=region3)(tier=silver))"); }
+
+/// Benchmark listing the configurations with a value of a property which is not indexed
+BENCHMARK_DEFINE_F(ListConfigurationsFixture, ListByUnindexedProperty)
+(benchmark::State& state) { List(state, "(tier=gold)"); }
+
+BENCHMARK_REGISTER_F(ListConfigurationsFixture, ListByPid)
+    ->ArgName("configurations")
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(ListConfigurationsFixture, ListByFactoryPid)
+    ->ArgName("configurations")
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(ListConfigurationsFixture, ListByIndexedProperty)
+    ->ArgName("configurations")
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(ListConfigurationsFixture, ListByUnindexedProperty)
+    ->ArgName("configurations")
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
@@ -24,6 +24,7 @@
 #define __COMPONENT_REGISTRY_HPP__
 
 #include "manager/ComponentManager.hpp"
+#include "manager/ReferenceEventBatch.hpp"
 #include <memory>
 #include <vector>
 
@@ -122,9 +123,20 @@ namespace cppmicroservices
              */
             size_t Count() const;
 
+            /**
+             * Returns the event batch shared by the reference managers of the components
+             * stored in this registry
+             */
+            std::shared_ptr<ReferenceEventBatch>
+            GetReferenceEventBatch() const
+            {
+                return mReferenceEventBatch;
+            }
+
           private:
             std::map<std::pair<unsigned long, std::string>, std::shared_ptr<ComponentManager>> mComponentsByName;
             mutable std::mutex mMapsMutex;
+            std::shared_ptr<ReferenceEventBatch> const mReferenceEventBatch = std::make_shared<ReferenceEventBatch>();
         };
     } // namespace scrimpl
 } // namespace cppmicroservices
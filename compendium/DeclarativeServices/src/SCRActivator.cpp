@@ -43,6 +43,7 @@
 #include "cppmicroservices/detail/ScopeGuard.h"
 
 using cppmicroservices::logservice::SeverityLevel;
+using cppmicroservices::service::component::ComponentConstants::DS_COALESCE_BUNDLE_EVENTS;
 using cppmicroservices::service::component::ComponentConstants::SERVICE_COMPONENT;
 
 namespace cppmicroservices
@@ -67,6 +68,9 @@ namespace cppmicroservices
             // Create configuration object notifier
             configNotifier = std::make_shared<ConfigurationNotifier>(context, logger, asyncWorkService);
 
+            auto const coalesceProp = context.GetProperty(DS_COALESCE_BUNDLE_EVENTS);
+            coalesceBundleEvents = (coalesceProp.Type() == typeid(bool)) && any_cast<bool>(coalesceProp);
+
             // Add bundle listener
             bundleListenerToken
                 = context.AddBundleListener(std::bind(&SCRActivator::BundleChanged, this, std::placeholders::_1));
@@ -117,6 +121,11 @@ namespace cppmicroservices
                     std::lock_guard<std::mutex> l(bundleRegMutex);
                     bundleRegistry.clear();
                 }
+                // end the event batches of bundles still starting or stopping
+                for (auto const& bundle : bundles)
+                {
+                    EndBundleEventBatch(bundle);
+                }
                 // clear component registry
                 componentRegistry->Clear();
 
@@ -220,6 +229,32 @@ namespace cppmicroservices
             }
         }
 
+        void
+        SCRActivator::BeginBundleEventBatch(cppmicroservices::Bundle const& bundle)
+        {
+            {
+                std::lock_guard<std::mutex> l(eventBatchMutex);
+                if (!bundlesInEventBatch.insert(bundle.GetBundleId()).second)
+                {
+                    return;
+                }
+            }
+            componentRegistry->GetReferenceEventBatch()->Begin();
+        }
+
+        void
+        SCRActivator::EndBundleEventBatch(cppmicroservices::Bundle const& bundle)
+        {
+            {
+                std::lock_guard<std::mutex> l(eventBatchMutex);
+                if (bundlesInEventBatch.erase(bundle.GetBundleId()) == 0)
+                {
+                    return;
+                }
+            }
+            componentRegistry->GetReferenceEventBatch()->End();
+        }
+
         void
         SCRActivator::BundleChanged(cppmicroservices::BundleEvent const& evt)
         {
@@ -230,6 +265,27 @@ namespace cppmicroservices
                 return;
             }
 
+            // The services registered by the bundle activator and by the components of the
+            // bundle are applied to the references as one change once the bundle has started.
+            // The same goes for the services unregistered while the bundle stops. The batch
+            // is ended by any other event for the bundle, so a failed start does not leave
+            // it open.
+            if (coalesceBundleEvents
+                && (eventType == cppmicroservices::BundleEvent::BUNDLE_STARTING
+                    || eventType == cppmicroservices::BundleEvent::BUNDLE_STOPPING))
+            {
+                BeginBundleEventBatch(bundle);
+            }
+            cppmicroservices::detail::ScopeGuard endBatch(
+                [this, &bundle, eventType]()
+                {
+                    if (eventType != cppmicroservices::BundleEvent::BUNDLE_STARTING
+                        && eventType != cppmicroservices::BundleEvent::BUNDLE_STOPPING)
+                    {
+                        EndBundleEventBatch(bundle);
+                    }
+                });
+
             // TODO: revisit to include LAZY_ACTIVATION when supported by the framework
             if (eventType == cppmicroservices::BundleEvent::BUNDLE_STARTED)
             {
@@ -33,6 +33,7 @@
 #include "cppmicroservices/servicecomponent/runtime/ServiceComponentRuntime.hpp"
 #include "manager/ConfigurationNotifier.hpp"
 #include <map>
+#include <unordered_set>
 #include <vector>
 
 using cppmicroservices::service::component::runtime::ServiceComponentRuntime;
@@ -71,6 +72,12 @@ namespace cppmicroservices
              * with declarative services metadata
              */
             void DisposeExtension(cppmicroservices::Bundle const& bundle);
+            /*
+             * These methods open and end the reference event batch which coalesces
+             * the reference changes caused by starting or stopping a bundle
+             */
+            void BeginBundleEventBatch(cppmicroservices::Bundle const& bundle);
+            void EndBundleEventBatch(cppmicroservices::Bundle const& bundle);
 
           private:
             cppmicroservices::BundleContext runtimeContext;
@@ -84,6 +91,9 @@ namespace cppmicroservices
             cppmicroservices::ServiceRegistration<cppmicroservices::service::cm::ConfigurationListener>
                 configListenerReg;
             std::shared_ptr<ConfigurationNotifier> configNotifier;
+            bool coalesceBundleEvents = false;
+            std::mutex eventBatchMutex;
+            std::unordered_set<long> bundlesInEventBatch; ///< bundles starting or stopping in an event batch
         };
     } // namespace scrimpl
 } // namespace cppmicroservices
@@ -22,10 +22,7 @@
 
 #include "SCRAsyncWorkService.hpp"
 
-#include "boost/asio/async_result.hpp"
-#include "boost/asio/packaged_task.hpp"
-#include "boost/asio/post.hpp"
-#include "boost/asio/thread_pool.hpp"
+#include "cppmicroservices/asyncworkservice/WorkStealingAsyncWorkService.hpp"
 
 namespace cppmicroservices
 {
@@ -39,7 +36,9 @@ namespace cppmicroservices
          * a user-provided service was not given or if the user-provided service
          * which implements the AsyncWorkService interface was unregistered.
          */
-        class FallbackAsyncWorkService final : public cppmicroservices::async::AsyncWorkService
+        class FallbackAsyncWorkService final
+            : public cppmicroservices::async::AsyncWorkService
+            , public cppmicroservices::async::PriorityAsyncWorkService
         {
           public:
             FallbackAsyncWorkService(std::shared_ptr<cppmicroservices::logservice::LogService> const& logger_)
@@ -51,7 +50,7 @@ namespace cppmicroservices
             void
             Initialize()
             {
-                threadpool = std::make_shared<boost::asio::thread_pool>(2);
+                threadpool = std::make_shared<cppmicroservices::async::WorkStealingAsyncWorkService>(2);
             }
 
             void
@@ -61,8 +60,7 @@ namespace cppmicroservices
                 {
                     try
                     {
-                        threadpool->join();
-                        threadpool->stop();
+                        threadpool->Shutdown();
                         threadpool.reset();
                     }
                     catch (...)
@@ -83,20 +81,22 @@ namespace cppmicroservices
             {
                 if (threadpool)
                 {
-                    using Sig = void();
-                    using Result = boost::asio::async_result<decltype(task), Sig>;
-                    using Handler = typename Result::completion_handler_type;
-
-                    Handler handler(std::forward<decltype(task)>(task));
-                    Result result(handler);
+                    threadpool->post(std::move(task));
+                }
+            }
 
-                    boost::asio::post(threadpool->get_executor(),
-                                      [handler = std::move(handler)]() mutable { handler(); });
+            void
+            postWithPriority(std::packaged_task<void()>&& task,
+                             cppmicroservices::async::TaskPriority priority) override
+            {
+                if (threadpool)
+                {
+                    threadpool->postWithPriority(std::move(task), priority);
                 }
             }
 
           private:
-            std::shared_ptr<boost::asio::thread_pool> threadpool;
+            std::shared_ptr<cppmicroservices::async::WorkStealingAsyncWorkService> threadpool;
             std::shared_ptr<cppmicroservices::logservice::LogService> logger;
         };
 
@@ -192,5 +192,13 @@ namespace cppmicroservices
             currAsync->post(std::move(task));
         }
 
+        void
+        SCRAsyncWorkService::postWithPriority(std::packaged_task<void()>&& task,
+                                              cppmicroservices::async::TaskPriority priority)
+        {
+            auto currAsync = std::atomic_load(&asyncWorkService);
+            currAsync->postWithPriority(std::move(task), priority);
+        }
+
     } // namespace scrimpl
 } // namespace cppmicroservices
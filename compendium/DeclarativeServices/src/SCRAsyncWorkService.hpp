@@ -46,6 +46,7 @@ namespace cppmicroservices
          */
         class SCRAsyncWorkService final
             : public cppmicroservices::async::AsyncWorkService
+            , public cppmicroservices::async::PriorityAsyncWorkService
             , public cppmicroservices::ServiceTrackerCustomizer<cppmicroservices::async::AsyncWorkService>
         {
           public:
@@ -60,6 +61,10 @@ namespace cppmicroservices
             // methods from the cppmicroservices::async::AsyncWorkService interface
             void post(std::packaged_task<void()>&& task) override;
 
+            // methods from the cppmicroservices::async::PriorityAsyncWorkService interface
+            void postWithPriority(std::packaged_task<void()>&& task,
+                                  cppmicroservices::async::TaskPriority priority) override;
+
             // methods from the cppmicroservices::ServiceTrackerCustomizer interface
             std::shared_ptr<TrackedParamType> AddingService(
                 ServiceReference<cppmicroservices::async::AsyncWorkService> const& reference) override;
@@ -25,6 +25,7 @@
 #include "cppmicroservices/SharedLibraryException.h"
 #include "cppmicroservices/cm/ConfigurationAdmin.hpp"
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
+#include "manager/ComponentActivationGraph.hpp"
 #include "manager/ComponentManagerImpl.hpp"
 #include "manager/ConfigurationNotifier.hpp"
 #include "metadata/ComponentMetadata.hpp"
@@ -64,8 +65,13 @@ namespace cppmicroservices
             auto metadataparser = metadata::MetadataParserFactory::Create(version, logger);
             std::vector<std::shared_ptr<ComponentMetadata>> componentsMetadata;
             componentsMetadata = metadataparser->ParseAndGetComponentsMetadata(scrMetadata);
-            for (auto& oneCompMetadata : componentsMetadata)
+
+            // Providers are enabled before the components of this bundle which reference
+            // them. The components are enabled one after another: enabling a component may
+            // activate it, and an activation may start bundles.
+            for (auto index : GetActivationOrder(componentsMetadata))
             {
+                auto const& oneCompMetadata = componentsMetadata[index];
                 try
                 {
                     auto compManager = std::make_shared<ComponentManagerImpl>(oneCompMetadata,
@@ -0,0 +1,115 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "ComponentActivationGraph.hpp"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace cppmicroservices
+{
+    namespace scrimpl
+    {
+        std::vector<std::size_t>
+        GetActivationOrder(std::vector<std::shared_ptr<metadata::ComponentMetadata>> const& components)
+        {
+            std::size_t const count = components.size();
+
+            std::unordered_map<std::string, std::vector<std::size_t>> providers;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (components[i]->enabled)
+                {
+                    for (auto const& interfaceName : components[i]->serviceMetadata.interfaces)
+                    {
+                        providers[interfaceName].push_back(i);
+                    }
+                }
+            }
+
+            // dependencies[i] holds the components providing a service referenced by component i
+            std::vector<std::vector<std::size_t>> dependencies(count);
+            for (std::size_t consumer = 0; consumer < count; ++consumer)
+            {
+                auto& edges = dependencies[consumer];
+                for (auto const& ref : components[consumer]->refsMetadata)
+                {
+                    auto it = providers.find(ref.interfaceName);
+                    if (it == providers.end())
+                    {
+                        continue;
+                    }
+                    for (auto provider : it->second)
+                    {
+                        if (provider != consumer && std::find(edges.begin(), edges.end(), provider) == edges.end())
+                        {
+                            edges.push_back(provider);
+                        }
+                    }
+                }
+            }
+
+            // Depth-first search in the original order, appending each component after
+            // its providers. A provider which is already being visited closes a cycle and
+            // is skipped.
+            enum class State
+            {
+                NotVisited,
+                Visiting,
+                Done
+            };
+            std::vector<State> state(count, State::NotVisited);
+            std::vector<std::size_t> order;
+            order.reserve(count);
+            std::vector<std::pair<std::size_t, std::size_t>> stack; // component, next dependency
+            for (std::size_t root = 0; root < count; ++root)
+            {
+                if (state[root] != State::NotVisited)
+                {
+                    continue;
+                }
+                state[root] = State::Visiting;
+                stack.emplace_back(root, 0);
+                while (!stack.empty())
+                {
+                    auto& [index, next] = stack.back();
+                    if (next < dependencies[index].size())
+                    {
+                        auto const provider = dependencies[index][next++];
+                        if (state[provider] == State::NotVisited)
+                        {
+                            state[provider] = State::Visiting;
+                            stack.emplace_back(provider, 0);
+                        }
+                        continue;
+                    }
+                    state[index] = State::Done;
+                    order.push_back(index);
+                    stack.pop_back();
+                }
+            }
+            return order;
+        }
+    } // namespace scrimpl
+} // namespace cppmicroservices
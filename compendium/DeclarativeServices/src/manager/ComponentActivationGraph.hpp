@@ -0,0 +1,59 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef __COMPONENTACTIVATIONGRAPH_HPP__
+#define __COMPONENTACTIVATIONGRAPH_HPP__
+
+#include "../metadata/ComponentMetadata.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace cppmicroservices
+{
+    namespace scrimpl
+    {
+        /**
+         * Orders the components of a bundle for enabling, so that the components
+         * providing a service are enabled before the components of the same bundle
+         * which reference it. Enabling the consumers first would create them in the
+         * unsatisfied state, only to re-evaluate them once the provider registers
+         * its service.
+         *
+         * The order is stable: a component only moves in front of the components
+         * listed before it if they reference one of its services, directly or
+         * indirectly. A bundle whose components do not reference each other keeps
+         * the order of its metadata, and with it the order in which the services
+         * are registered. Only providers which are enabled by default are taken
+         * into account. The components of a reference cycle are ordered as if the
+         * reference closing the cycle did not exist.
+         *
+         * \param components the metadata of the components of one bundle
+         * \return the indices into \c components, in the order to enable them
+         */
+        std::vector<std::size_t> GetActivationOrder(
+            std::vector<std::shared_ptr<metadata::ComponentMetadata>> const& components);
+    } // namespace scrimpl
+} // namespace cppmicroservices
+
+#endif // __COMPONENTACTIVATIONGRAPH_HPP__
@@ -22,7 +22,9 @@
 
 #include "cppmicroservices/FrameworkFactory.h"
 #include "cppmicroservices/SecurityException.h"
+#include "cppmicroservices/Trace.h"
 
+#include "../ComponentRegistry.hpp"
 #include "../ConfigurationListenerImpl.hpp"
 #include "BundleLoader.hpp"
 #include "ComponentConfigurationImpl.hpp"
@@ -92,7 +94,8 @@ namespace cppmicroservices
                 auto refManager = std::make_shared<ReferenceManagerImpl>(refMetadata,
                                                                          bundle.GetBundleContext(),
                                                                          this->logger,
-                                                                         this->metadata->name);
+                                                                         this->metadata->name,
+                                                                         this->registry->GetReferenceEventBatch());
                 referenceManagers.emplace(refMetadata.name, refManager);
             }
             if ((this->metadata->configurationPids.size() > 0)
@@ -489,6 +492,8 @@ namespace cppmicroservices
         InstanceContextPair
         ComponentConfigurationImpl::CreateAndActivateComponentInstanceHelper(cppmicroservices::Bundle const& bundle)
         {
+            cppmicroservices::detail::TraceSpan span("ComponentConfiguration::Activate", GetMetadata()->name);
+
             Any func = this->bundle.GetBundleContext().GetProperty(
                 cppmicroservices::Constants::FRAMEWORK_BUNDLE_VALIDATION_FUNC);
 
@@ -191,7 +191,8 @@ namespace cppmicroservices
 
             if (succeeded) // succeeded in changing the state
             {
-                asyncWorkService->post(std::move(post_task));
+                // component activation is latency sensitive, run it ahead of background work
+                asyncWorkService->postWithPriority(std::move(post_task), cppmicroservices::async::TaskPriority::High);
                 return enabledState->GetFuture();
             }
 
@@ -0,0 +1,84 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef __REFERENCEEVENTBATCH_HPP__
+#define __REFERENCEEVENTBATCH_HPP__
+
+#include "ConcurrencyUtil.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace cppmicroservices
+{
+    namespace scrimpl
+    {
+        class ReferenceManagerBaseImpl;
+
+        /**
+         * Event batch shared by the reference managers of one runtime. While a batch
+         * is open, the notifications a reference manager would send to its listeners
+         * are queued. When the last open batch is ended, the queued notifications of
+         * each reference manager are reduced to the ones needed to reach its current
+         * state and sent. For example, a static reference is reactivated once for a
+         * whole burst of service registrations.
+         *
+         * Batches may be nested and may be ended on another thread. Reference managers
+         * which are not owned by a \c std::shared_ptr do not take part in batches.
+         */
+        class ReferenceEventBatch
+        {
+          public:
+            ReferenceEventBatch() = default;
+            ReferenceEventBatch(ReferenceEventBatch const&) = delete;
+            ReferenceEventBatch& operator=(ReferenceEventBatch const&) = delete;
+            ReferenceEventBatch(ReferenceEventBatch&&) = delete;
+            ReferenceEventBatch& operator=(ReferenceEventBatch&&) = delete;
+
+            /**
+             * Opens an event batch
+             */
+            void Begin();
+
+            /**
+             * Ends an event batch opened with #Begin. Ending the last open batch
+             * sends the queued notifications on the calling thread.
+             */
+            void End();
+
+          private:
+            friend class ReferenceManagerBaseImpl;
+
+            struct State
+            {
+                std::size_t depth = 0; ///< number of open batches
+                std::vector<std::weak_ptr<ReferenceManagerBaseImpl>>
+                    pending; ///< reference managers with queued notifications
+            };
+
+            Guarded<State> state;
+        };
+    } // namespace scrimpl
+} // namespace cppmicroservices
+
+#endif // __REFERENCEEVENTBATCH_HPP__
@@ -64,12 +64,14 @@ namespace cppmicroservices
             metadata::ReferenceMetadata const& metadata,
             cppmicroservices::BundleContext const& bc,
             std::shared_ptr<cppmicroservices::logservice::LogService> logger,
-            std::string const& configName)
+            std::string const& configName,
+            std::shared_ptr<ReferenceEventBatch> eventBatch)
             : ReferenceManagerBaseImpl(metadata,
                                        bc,
                                        logger,
                                        configName,
-                                       CreateBindingPolicy(*this, metadata.policy, metadata.policyOption))
+                                       CreateBindingPolicy(*this, metadata.policy, metadata.policyOption),
+                                       std::move(eventBatch))
         {
         }
 
@@ -78,11 +80,13 @@ namespace cppmicroservices
             cppmicroservices::BundleContext const& bc,
             std::shared_ptr<cppmicroservices::logservice::LogService> logger,
             std::string const& configName,
-            std::unique_ptr<BindingPolicy> policy)
+            std::unique_ptr<BindingPolicy> policy,
+            std::shared_ptr<ReferenceEventBatch> eventBatch)
             : metadata(metadata)
             , tracker(nullptr)
             , logger(std::move(logger))
             , configName(configName)
+            , eventBatch(std::move(eventBatch))
             , bindingPolicy(std::move(policy))
         {
             if (!bc || !this->logger)
@@ -273,6 +277,25 @@ namespace cppmicroservices
                 return;
             }
 
+            try
+            {
+                if (QueueNotifications(notifications))
+                {
+                    return;
+                }
+            }
+            catch (...)
+            {
+                logger->Log(SeverityLevel::LOG_ERROR,
+                            "Exception caught while queueing notifications for reference name " + metadata.name,
+                            std::current_exception());
+            }
+            SendToAllListeners(notifications);
+        }
+
+        void
+        ReferenceManagerBaseImpl::SendToAllListeners(std::vector<RefChangeNotification> const& notifications) noexcept
+        {
             RefMgrListenerMap listenersMapCopy;
             {
                 auto listenerMapHandle = listenersMap.lock();
@@ -299,6 +322,145 @@ namespace cppmicroservices
             }
         }
 
+        bool
+        ReferenceManagerBaseImpl::QueueNotifications(std::vector<RefChangeNotification> const& notifications)
+        {
+            if (!eventBatch)
+            {
+                return false;
+            }
+            auto batchStateHandle = eventBatch->state.lock();
+            auto queuedHandle = queuedNotifications.lock();
+            if (batchStateHandle->depth == 0)
+            {
+                // the batch has ended but the queued notifications are not all sent yet,
+                // keep the order by letting the thread ending the batch send these too.
+                if (queuedHandle->empty())
+                {
+                    return false;
+                }
+            }
+            else if (queuedHandle->empty())
+            {
+                auto self = weak_from_this();
+                if (self.expired())
+                {
+                    return false;
+                }
+                batchStateHandle->pending.push_back(std::move(self));
+            }
+            queuedHandle->insert(queuedHandle->end(), notifications.begin(), notifications.end());
+            return true;
+        }
+
+        void
+        ReferenceManagerBaseImpl::SendQueuedNotifications() noexcept
+        {
+            while (true)
+            {
+                std::vector<RefChangeNotification> notifications;
+                {
+                    auto queuedHandle = queuedNotifications.lock();
+                    if (queuedHandle->empty())
+                    {
+                        return;
+                    }
+                    // notifications queued by other threads while the listeners are
+                    // called are sent by the next iteration
+                    try
+                    {
+                        notifications = CoalesceNotifications(*queuedHandle);
+                    }
+                    catch (...)
+                    {
+                        notifications = std::move(*queuedHandle);
+                    }
+                    queuedHandle->clear();
+                }
+                SendToAllListeners(notifications);
+            }
+        }
+
+        std::vector<RefChangeNotification>
+        ReferenceManagerBaseImpl::CoalesceNotifications(std::vector<RefChangeNotification> const& notifications)
+        {
+            if (notifications.empty())
+            {
+                return {};
+            }
+
+            // The listeners were satisfied before the first notification unless it tells
+            // them that the reference became satisfied.
+            bool const wasSatisfied = (notifications.front().event != RefEvent::BECAME_SATISFIED);
+            bool isSatisfied = wasSatisfied;
+            RefChangeNotification const* unsatisfied = nullptr;
+            RefChangeNotification const* satisfied = nullptr;
+            for (auto const& notification : notifications)
+            {
+                if (notification.event == RefEvent::BECAME_UNSATISFIED)
+                {
+                    isSatisfied = false;
+                    if (unsatisfied == nullptr)
+                    {
+                        unsatisfied = &notification;
+                    }
+                }
+                else if (notification.event == RefEvent::BECAME_SATISFIED)
+                {
+                    isSatisfied = true;
+                    satisfied = &notification;
+                }
+            }
+
+            if (unsatisfied == nullptr && wasSatisfied)
+            {
+                // only rebinds of a dynamic reference, each one is needed
+                return notifications;
+            }
+
+            // The component is (re)activated with the bound references at that time, so the
+            // rebinds in between are not needed.
+            std::vector<RefChangeNotification> coalesced;
+            if (unsatisfied != nullptr && wasSatisfied)
+            {
+                coalesced.push_back(*unsatisfied);
+            }
+            if (isSatisfied)
+            {
+                coalesced.push_back(*satisfied);
+            }
+            return coalesced;
+        }
+
+        void
+        ReferenceEventBatch::Begin()
+        {
+            ++(state.lock()->depth);
+        }
+
+        void
+        ReferenceEventBatch::End()
+        {
+            std::vector<std::weak_ptr<ReferenceManagerBaseImpl>> pending;
+            {
+                auto batchStateHandle = state.lock();
+                assert(batchStateHandle->depth > 0);
+                if (--(batchStateHandle->depth) > 0)
+                {
+                    return;
+                }
+                pending.swap(batchStateHandle->pending);
+            }
+
+            for (auto const& weakMgr : pending)
+            {
+                if (auto mgr = weakMgr.lock())
+                {
+                    mgr->SendQueuedNotifications();
+                }
+            }
+        }
+
         // util method to extract service-id from a given reference
         long
         ReferenceManagerBaseImpl::GetServiceId(ServiceReferenceBase const& sRef)
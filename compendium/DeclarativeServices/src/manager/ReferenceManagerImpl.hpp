@@ -23,7 +23,9 @@
 #ifndef __REFERENCEMANAGERIMPL_HPP__
 #define __REFERENCEMANAGERIMPL_HPP__
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #if defined(USING_GTEST)
 #    include "gtest/gtest_prod.h"
@@ -31,6 +33,7 @@
 #    define FRIEND_TEST(x, y)
 #endif
 #include "ConcurrencyUtil.hpp"
+#include "ReferenceEventBatch.hpp"
 #include "ReferenceManager.hpp"
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/ServiceTracker.h"
@@ -55,6 +58,7 @@ namespace cppmicroservices
         class ReferenceManagerBaseImpl
             : public ReferenceManager
             , public cppmicroservices::ServiceTrackerCustomizer<void>
+            , public std::enable_shared_from_this<ReferenceManagerBaseImpl>
         {
           public:
             /**
@@ -63,13 +67,16 @@ namespace cppmicroservices
              * \param metadata - the reference description as specified in the component description
              * \param bc - the {@link BundleContext} of the bundle containing the component
              * \param logger - the logger object used to log information from this class.
+             * \param eventBatch - the event batch of the runtime. The notifications are never
+             *        batched if it is null.
              *
              * \throws \c std::runtime_error if \c bc or \c logger is invalid
              */
             ReferenceManagerBaseImpl(metadata::ReferenceMetadata const& metadata,
                                      cppmicroservices::BundleContext const& bc,
                                      std::shared_ptr<cppmicroservices::logservice::LogService> logger,
-                                     std::string const& configName);
+                                     std::string const& configName,
+                                     std::shared_ptr<ReferenceEventBatch> eventBatch = nullptr);
             ReferenceManagerBaseImpl(ReferenceManagerBaseImpl const&) = delete;
             ReferenceManagerBaseImpl(ReferenceManagerBaseImpl&&) = delete;
             ReferenceManagerBaseImpl& operator=(ReferenceManagerBaseImpl const&) = delete;
@@ -247,11 +254,13 @@ namespace cppmicroservices
                                      cppmicroservices::BundleContext const& bc,
                                      std::shared_ptr<cppmicroservices::logservice::LogService> logger,
                                      std::string const& configName,
-                                     std::unique_ptr<BindingPolicy> policy);
+                                     std::unique_ptr<BindingPolicy> policy,
+                                     std::shared_ptr<ReferenceEventBatch> eventBatch = nullptr);
 
           private:
             friend class ReferenceManagerImplTest;
             friend class BindingPolicyTest;
+            friend class ReferenceEventBatch;
 
             static long GetServiceId(ServiceReferenceBase const& sRef);
 
@@ -265,10 +274,38 @@ namespace cppmicroservices
             bool UpdateBoundRefs();
 
             /**
-             * Method used to send notifications to all the listeners
+             * Method used to send notifications to all the listeners. The notifications
+             * are queued instead if an event batch is open.
              */
             void BatchNotifyAllListeners(std::vector<RefChangeNotification> const& notification) noexcept;
 
+            /**
+             * Calls all the listeners with the given notifications
+             */
+            void SendToAllListeners(std::vector<RefChangeNotification> const& notifications) noexcept;
+
+            /**
+             * Queues the notifications if the event batch is open, or if earlier
+             * notifications are still waiting to be sent.
+             *
+             * \return true if the notifications were queued, false otherwise.
+             */
+            bool QueueNotifications(std::vector<RefChangeNotification> const& notifications);
+
+            /**
+             * Sends the notifications queued during an event batch, coalesced
+             */
+            void SendQueuedNotifications() noexcept;
+
+            /**
+             * Reduces the notifications sent by a reference manager to the ones needed
+             * to move its listeners from the state before the first notification to the
+             * state after the last one. Rebinds are dropped if the component is
+             * reactivated or becomes satisfied anyway.
+             */
+            static std::vector<RefChangeNotification> CoalesceNotifications(
+                std::vector<RefChangeNotification> const& notifications);
+
             const metadata::ReferenceMetadata metadata;    ///< reference information from the component description
             std::unique_ptr<ServiceTracker<void>> tracker; ///< used to track service availability
             std::shared_ptr<cppmicroservices::logservice::LogService> logger; ///< logger for this runtime
@@ -281,6 +318,9 @@ namespace cppmicroservices
                 matchedRefs; ///< guarded set of matched references
 
             mutable Guarded<RefMgrListenerMap> listenersMap;                    ///< guarded map of listeners
+            std::shared_ptr<ReferenceEventBatch> eventBatch; ///< event batch of the runtime, may be null
+            Guarded<std::vector<RefChangeNotification>> queuedNotifications; ///< notifications held back by an
+                                                                            /// event batch
             static std::atomic<cppmicroservices::ListenerTokenId> tokenCounter; ///< used to
                                                                                 /// generate unique
                                                                                 /// tokens for
@@ -297,8 +337,9 @@ namespace cppmicroservices
             ReferenceManagerImpl(metadata::ReferenceMetadata const& metadata,
                                  cppmicroservices::BundleContext const& bc,
                                  std::shared_ptr<cppmicroservices::logservice::LogService> logger,
-                                 std::string const& configName)
-                : ReferenceManagerBaseImpl(metadata, bc, logger, configName)
+                                 std::string const& configName,
+                                 std::shared_ptr<ReferenceEventBatch> eventBatch = nullptr)
+                : ReferenceManagerBaseImpl(metadata, bc, logger, configName, std::move(eventBatch))
             {
             }
         };
@@ -4,6 +4,7 @@
 #ifndef US_BUILD_SHARED_LIBS
 CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(system_bundle)
 CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(BenchmarkDS)
+CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(BenchmarkDSProviders)
 CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(DSFrenchDictionary)
 CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(DSGraph01)
 CPPMICROSERVICES_INITIALIZE_STATIC_BUNDLE(DSGraph02)
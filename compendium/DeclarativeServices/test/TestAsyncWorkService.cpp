@@ -38,11 +38,15 @@
 #include "boost/asio/packaged_task.hpp"
 #include "boost/asio/post.hpp"
 #include "boost/asio/thread_pool.hpp"
+#include "cppmicroservices/asyncworkservice/WorkStealingAsyncWorkService.hpp"
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 #include "cppmicroservices/servicecomponent/runtime/ServiceComponentRuntime.hpp"
 
+#include <atomic>
 #include <future>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace test
 {
@@ -310,12 +314,116 @@ namespace test
         });
     }
 
+    TEST(TestWorkStealingAsyncWorkService, RunsAllTasks)
+    {
+        async::WorkStealingAsyncWorkService workService(4);
+        std::atomic<int> count(0);
+        std::vector<std::future<void>> futures;
+        std::vector<std::future<void>> nestedFutures(100);
+        for (std::size_t i = 0; i < nestedFutures.size(); ++i)
+        {
+            // tasks posted by a task are queued on the same worker and may be stolen
+            std::packaged_task<void()> task(
+                [&workService, &count, &nestedFutures, i]()
+                {
+                    std::packaged_task<void()> nested([&count]() { ++count; });
+                    nestedFutures[i] = nested.get_future();
+                    workService.post(std::move(nested));
+                    ++count;
+                });
+            futures.push_back(task.get_future());
+            workService.post(std::move(task));
+        }
+        for (auto& f : futures)
+        {
+            f.get();
+        }
+        for (auto& f : nestedFutures)
+        {
+            f.get();
+        }
+        EXPECT_EQ(count, 200);
+
+        auto metrics = workService.GetMetrics();
+        EXPECT_EQ(metrics.workerCount, 4u);
+        EXPECT_EQ(metrics.queueDepth, 0u);
+        EXPECT_EQ(metrics.executed, 200u);
+        EXPECT_LE(metrics.averageLatency, metrics.maxLatency);
+    }
+
+    TEST(TestWorkStealingAsyncWorkService, RunsHigherPriorityFirst)
+    {
+        async::WorkStealingAsyncWorkService workService(1);
+
+        // keep the only worker busy until all tasks are queued
+        std::promise<void> started;
+        std::promise<void> release;
+        std::packaged_task<void()> blocker(
+            [&started, f = release.get_future().share()]()
+            {
+                started.set_value();
+                f.wait();
+            });
+        workService.post(std::move(blocker));
+        started.get_future().wait();
+
+        std::mutex orderMutex;
+        std::vector<async::TaskPriority> order;
+        std::vector<std::future<void>> futures;
+        for (auto priority : { async::TaskPriority::Low, async::TaskPriority::Normal, async::TaskPriority::High })
+        {
+            std::packaged_task<void()> task(
+                [&orderMutex, &order, priority]()
+                {
+                    std::lock_guard<std::mutex> l(orderMutex);
+                    order.push_back(priority);
+                });
+            futures.push_back(task.get_future());
+            // posting through the AsyncWorkService interface keeps the priority
+            static_cast<async::AsyncWorkService&>(workService).postWithPriority(std::move(task), priority);
+        }
+        EXPECT_EQ(workService.GetMetrics().queueDepth, 3u);
+
+        release.set_value();
+        for (auto& f : futures)
+        {
+            f.get();
+        }
+        std::vector<async::TaskPriority> const expected
+            = { async::TaskPriority::High, async::TaskPriority::Normal, async::TaskPriority::Low };
+        EXPECT_EQ(order, expected);
+    }
+
+    TEST(TestWorkStealingAsyncWorkService, ShutdownRunsQueuedTasks)
+    {
+        async::WorkStealingAsyncWorkService workService(2);
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < 50; ++i)
+        {
+            std::packaged_task<void()> task([]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+            futures.push_back(task.get_future());
+            workService.post(std::move(task));
+        }
+        workService.Shutdown();
+        for (auto& f : futures)
+        {
+            EXPECT_EQ(f.wait_for(std::chrono::seconds::zero()), std::future_status::ready);
+        }
+
+        // tasks posted after the shutdown are discarded
+        std::packaged_task<void()> late([]() {});
+        auto lateFuture = late.get_future();
+        workService.post(std::move(late));
+        EXPECT_THROW(lateFuture.get(), std::future_error);
+    }
+
     INSTANTIATE_TEST_SUITE_P(AsyncWorkServiceEndToEndParameterized,
                              TestAsyncWorkServiceEndToEnd,
                              testing::Values(std::make_shared<AsyncWorkServiceInline>(),
                                              std::make_shared<AsyncWorkServiceStdAsync>(),
                                              std::make_shared<AsyncWorkServiceThreadPool>(1),
-                                             std::make_shared<AsyncWorkServiceThreadPool>(2)));
+                                             std::make_shared<AsyncWorkServiceThreadPool>(2),
+                                             std::make_shared<async::WorkStealingAsyncWorkService>(4)));
 
     TEST_P(TestAsyncWorkServiceEndToEnd, TestEndToEndBehaviorWithAsyncWorkService)
     {
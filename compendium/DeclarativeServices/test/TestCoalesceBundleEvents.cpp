@@ -0,0 +1,122 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include <chrono>
+#include <string>
+
+#include <TestInterfaces/Interfaces.hpp>
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/servicecomponent/ComponentConstants.hpp>
+#include <gtest/gtest.h>
+
+#include "TestUtils.hpp"
+
+using cppmicroservices::service::component::ComponentConstants::DS_COALESCE_BUNDLE_EVENTS;
+
+namespace test
+{
+#if defined(US_BUILD_SHARED_LIBS)
+    /**
+     * The parameter is the value of the DS_COALESCE_BUNDLE_EVENTS framework property
+     */
+    class TestCoalesceBundleEvents : public ::testing::TestWithParam<bool>
+    {
+      protected:
+        TestCoalesceBundleEvents()
+            : ::testing::TestWithParam<bool>()
+            , framework(cppmicroservices::FrameworkFactory().NewFramework(
+                  cppmicroservices::FrameworkConfiguration { { DS_COALESCE_BUNDLE_EVENTS, GetParam() } }))
+        {
+        }
+        ~TestCoalesceBundleEvents() override = default;
+
+        void
+        SetUp() override
+        {
+            framework.Start();
+        }
+
+        void
+        TearDown() override
+        {
+            framework.Stop();
+            framework.WaitForStop(std::chrono::milliseconds::zero());
+        }
+
+        // The number of times the consumer component of the BenchmarkDS bundle was activated
+        int
+        GetConsumerActivations()
+        {
+            auto context = framework.GetBundleContext();
+            auto refs = context.GetServiceReferences<test::Interface1>("(component.name=sample::DSBenchmarkConsumer)");
+            EXPECT_EQ(refs.size(), 1ul) << "The consumer component must be registered";
+            if (refs.empty())
+            {
+                return 0;
+            }
+            return std::stoi(context.GetService(refs.front())->Description());
+        }
+
+        cppmicroservices::Framework framework;
+    };
+
+    INSTANTIATE_TEST_SUITE_P(CoalesceBundleEvents, TestCoalesceBundleEvents, testing::Values(false, true));
+
+    /**
+     * A component with a static, greedy reference of multiple cardinality is reactivated
+     * once per service registered by a starting bundle, or once for the whole bundle if
+     * the bundle events are coalesced. The same goes for the services unregistered when
+     * the bundle stops.
+     */
+    TEST_P(TestCoalesceBundleEvents, StaticReferenceReactivations)
+    {
+        auto context = framework.GetBundleContext();
+        test::InstallAndStartDS(context);
+        test::InstallAndStartBundle(context, "BenchmarkDS");
+        auto const initialActivations = GetConsumerActivations();
+
+        auto providers = test::InstallAndStartBundle(context, "BenchmarkDSProviders");
+        ASSERT_TRUE(providers);
+        ASSERT_GT(providers.GetRegisteredServices().size(), 1ul);
+        auto const startActivations = GetConsumerActivations() - initialActivations;
+
+        providers.Stop();
+        auto const stopActivations = GetConsumerActivations() - initialActivations - startActivations;
+
+        if (GetParam())
+        {
+            EXPECT_EQ(startActivations, 1) << "One reactivation expected for the started bundle";
+            EXPECT_EQ(stopActivations, 1) << "One reactivation expected for the stopped bundle";
+        }
+        else
+        {
+            EXPECT_GT(startActivations, 1) << "Several reactivations expected while the services are registered";
+            EXPECT_GT(stopActivations, 1) << "Several reactivations expected while the services are unregistered";
+        }
+    }
+#endif
+} // namespace test
@@ -0,0 +1,120 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "../src/manager/ComponentActivationGraph.hpp"
+#include "../src/metadata/ComponentMetadata.hpp"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cppmicroservices
+{
+    namespace scrimpl
+    {
+        namespace
+        {
+            using metadata::ComponentMetadata;
+            using Order = std::vector<std::size_t>;
+
+            std::shared_ptr<ComponentMetadata>
+            MakeComponent(std::string const& name,
+                          std::vector<std::string> const& provides,
+                          std::vector<std::string> const& references,
+                          bool enabled = true)
+            {
+                auto component = std::make_shared<ComponentMetadata>();
+                component->name = name;
+                component->enabled = enabled;
+                component->serviceMetadata.interfaces = provides;
+                for (auto const& interfaceName : references)
+                {
+                    metadata::ReferenceMetadata ref;
+                    ref.name = interfaceName;
+                    ref.interfaceName = interfaceName;
+                    component->refsMetadata.push_back(ref);
+                }
+                return component;
+            }
+        } // namespace
+
+        TEST(ComponentActivationGraphTest, IndependentComponentsKeepTheirOrder)
+        {
+            std::vector<std::shared_ptr<ComponentMetadata>> components
+                = { MakeComponent("B", { "IB" }, { "IExternal" }),
+                    MakeComponent("A", { "IA" }, {}),
+                    MakeComponent("C", {}, { "IExternal" }) };
+            EXPECT_EQ(GetActivationOrder(components), (Order { 0, 1, 2 }));
+            EXPECT_TRUE(GetActivationOrder({}).empty());
+        }
+
+        TEST(ComponentActivationGraphTest, ProvidersComeFirst)
+        {
+            // C -> B -> A and C -> A, listed consumers first
+            std::vector<std::shared_ptr<ComponentMetadata>> components
+                = { MakeComponent("C", {}, { "IB", "IA" }),
+                    MakeComponent("B", { "IB" }, { "IA" }),
+                    MakeComponent("A", { "IA" }, {}),
+                    MakeComponent("D", { "ID" }, {}) };
+            EXPECT_EQ(GetActivationOrder(components), (Order { 2, 1, 0, 3 }));
+        }
+
+        TEST(ComponentActivationGraphTest, RegistrationOrderIsStable)
+        {
+            // providers listed before their consumers do not change the order
+            std::vector<std::shared_ptr<ComponentMetadata>> ordered
+                = { MakeComponent("P", { "IP" }, {}),
+                    MakeComponent("X", { "IX" }, {}),
+                    MakeComponent("C", { "IC" }, { "IP" }),
+                    MakeComponent("Y", { "IY" }, { "IC" }) };
+            EXPECT_EQ(GetActivationOrder(ordered), (Order { 0, 1, 2, 3 }));
+
+            // only the provider moves in front of its consumer, the others keep their place
+            std::vector<std::shared_ptr<ComponentMetadata>> unordered
+                = { MakeComponent("X", { "IX" }, {}),
+                    MakeComponent("C", { "IC" }, { "IP" }),
+                    MakeComponent("Y", { "IY" }, {}),
+                    MakeComponent("P", { "IP" }, {}) };
+            EXPECT_EQ(GetActivationOrder(unordered), (Order { 0, 3, 1, 2 }));
+        }
+
+        TEST(ComponentActivationGraphTest, DisabledProvidersAndSelfReferences)
+        {
+            // B references a disabled provider and its own interface, neither orders it
+            std::vector<std::shared_ptr<ComponentMetadata>> components
+                = { MakeComponent("B", { "IB" }, { "IA", "IB" }), MakeComponent("A", { "IA" }, {}, false) };
+            EXPECT_EQ(GetActivationOrder(components), (Order { 0, 1 }));
+        }
+
+        TEST(ComponentActivationGraphTest, Cycles)
+        {
+            // A <-> B is a cycle and C depends on it
+            std::vector<std::shared_ptr<ComponentMetadata>> components
+                = { MakeComponent("C", {}, { "IA" }),
+                    MakeComponent("A", { "IA" }, { "IB" }),
+                    MakeComponent("B", { "IB" }, { "IA" }),
+                    MakeComponent("D", { "ID" }, {}) };
+            EXPECT_EQ(GetActivationOrder(components), (Order { 2, 1, 0, 3 }));
+        }
+    } // namespace scrimpl
+} // namespace cppmicroservices
@@ -27,6 +27,7 @@
 #include "cppmicroservices/FrameworkFactory.h"
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 #include "cppmicroservices/servicecomponent/runtime/ServiceComponentRuntime.hpp"
+#include <algorithm>
 #include <random>
 
 #include "ConcurrencyTestUtil.hpp"
@@ -722,5 +723,89 @@ namespace cppmicroservices
             reg.Unregister();
         }
 
+        // The notifications held back by an event batch are coalesced into at most one
+        // reactivation when the batch ends.
+        TEST_P(ReferenceManagerImplTest, TestEventBatch)
+        {
+            auto fakeMetadata = GetParam();
+            auto bc = GetFramework().GetBundleContext();
+            auto fakeLogger = std::make_shared<FakeLogger>();
+            auto eventBatch = std::make_shared<ReferenceEventBatch>();
+            // only reference managers owned by a shared_ptr take part in event batches
+            auto refManager = std::make_shared<ReferenceManagerImpl>(fakeMetadata,
+                                                                     bc,
+                                                                     fakeLogger,
+                                                                     FakeComponentConfigName,
+                                                                     eventBatch);
+            // a reference manager of another runtime is not held back by the batch
+            auto otherRefManager = std::make_shared<ReferenceManagerImpl>(fakeMetadata,
+                                                                          bc,
+                                                                          fakeLogger,
+                                                                          FakeComponentConfigName,
+                                                                          std::make_shared<ReferenceEventBatch>());
+
+            std::size_t otherNotificationCount = 0;
+            auto otherToken = otherRefManager->RegisterListener([&otherNotificationCount](RefChangeNotification const&)
+                                                                { ++otherNotificationCount; });
+            otherNotificationCount = 0;
+
+            std::vector<RefChangeNotification> notifications;
+            auto token = refManager->RegisterListener([&notifications](RefChangeNotification const& notification)
+                                                      { notifications.push_back(notification); });
+            notifications.clear();
+            auto countEvents = [&notifications](RefEvent event)
+            {
+                return std::count_if(notifications.begin(),
+                                     notifications.end(),
+                                     [event](RefChangeNotification const& notification)
+                                     { return notification.event == event; });
+            };
+
+            std::vector<ServiceRegistration<dummy::Reference1>> regs;
+            eventBatch->Begin();
+            for (int i = 0; i < 10; ++i)
+            {
+                regs.push_back(bc.RegisterService<dummy::Reference1>(std::make_shared<dummy::Reference1>(),
+                                                                     {
+                                                                         {Constants::SERVICE_RANKING, Any(i)}
+                }));
+            }
+            EXPECT_TRUE(notifications.empty()) << "No notifications expected before the batch ends";
+            if (!otherRefManager->IsOptional())
+            {
+                EXPECT_GT(otherNotificationCount, 0ul) << "Notifications of another batch expected immediately";
+            }
+            eventBatch->End();
+
+            EXPECT_TRUE(refManager->IsSatisfied());
+            EXPECT_LE(countEvents(RefEvent::BECAME_UNSATISFIED), 1) << "At most one UNSATISFIED notification expected";
+            EXPECT_LE(countEvents(RefEvent::BECAME_SATISFIED), 1) << "At most one SATISFIED notification expected";
+            if (!refManager->IsOptional())
+            {
+                ASSERT_EQ(notifications.size(), 1ul);
+                EXPECT_EQ(notifications.front().event, RefEvent::BECAME_SATISFIED);
+            }
+
+            notifications.clear();
+            eventBatch->Begin();
+            for (auto& reg : regs)
+            {
+                reg.Unregister();
+            }
+            EXPECT_TRUE(notifications.empty()) << "No notifications expected before the batch ends";
+            eventBatch->End();
+
+            EXPECT_EQ(refManager->IsSatisfied(), refManager->IsOptional());
+            EXPECT_LE(countEvents(RefEvent::BECAME_UNSATISFIED), 1) << "At most one UNSATISFIED notification expected";
+            EXPECT_LE(countEvents(RefEvent::BECAME_SATISFIED), 1) << "At most one SATISFIED notification expected";
+            if (!refManager->IsOptional())
+            {
+                ASSERT_EQ(notifications.size(), 1ul);
+                EXPECT_EQ(notifications.front().event, RefEvent::BECAME_UNSATISFIED);
+            }
+            refManager->UnregisterListener(token);
+            otherRefManager->UnregisterListener(otherToken);
+        }
+
     } // namespace scrimpl
 } // namespace cppmicroservices
@@ -0,0 +1,99 @@
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/servicecomponent/ComponentConstants.hpp>
+
+#include <chrono>
+#include <string>
+
+#include "TestInterfaces/Interfaces.hpp"
+#include "TestUtils.hpp"
+#include "benchmark/benchmark.h"
+
+using cppmicroservices::service::component::ComponentConstants::DS_COALESCE_BUNDLE_EVENTS;
+
+/**
+ * Starts DS and the BenchmarkDS bundle, whose consumer component has a static
+ * reference of multiple cardinality to the services registered by the
+ * BenchmarkDSProviders bundle. The benchmark argument is the value of the
+ * DS_COALESCE_BUNDLE_EVENTS framework property.
+ */
+class ReferenceEventBatchFixture : public ::benchmark::Fixture
+{
+  public:
+    using benchmark::Fixture::SetUp;
+    using benchmark::Fixture::TearDown;
+
+    void
+    SetUp(::benchmark::State const& state)
+    {
+        using namespace cppmicroservices;
+
+        FrameworkConfiguration config { { DS_COALESCE_BUNDLE_EVENTS, state.range(0) != 0 } };
+        framework = std::make_shared<Framework>(FrameworkFactory().NewFramework(config));
+        framework->Start();
+        auto context = framework->GetBundleContext();
+        test::InstallAndStartDS(context);
+        test::InstallAndStartBundle(context, "BenchmarkDS");
+        test::InstallLib(context, "BenchmarkDSProviders");
+        for (auto const& bundle : context.GetBundles())
+        {
+            if (bundle.GetSymbolicName() == "BenchmarkDSProviders")
+            {
+                providers = bundle;
+            }
+        }
+    }
+
+    void
+    TearDown(::benchmark::State const&)
+    {
+        using namespace std::chrono;
+
+        providers = {};
+        framework->Stop();
+        framework->WaitForStop(milliseconds::zero());
+    }
+
+    ~ReferenceEventBatchFixture() { framework.reset(); };
+
+    // The number of times the consumer component was activated
+    int
+    GetConsumerActivations()
+    {
+        auto context = framework->GetBundleContext();
+        auto refs = context.GetServiceReferences<test::Interface1>("(component.name=sample::DSBenchmarkConsumer)");
+        return refs.empty() ? 0 : std::stoi(context.GetService(refs.front())->Description());
+    }
+
+    std::shared_ptr<cppmicroservices::Framework> framework;
+    cppmicroservices::Bundle providers;
+};
+
+/// Benchmark starting and stopping a bundle which registers 200 services bound by a static reference
+BENCHMARK_DEFINE_F(ReferenceEventBatchFixture, StartStopProviderBundle)
+(benchmark::State& state)
+{
+    if (!providers)
+    {
+        state.SkipWithError("BenchmarkDSProviders bundle not found");
+        return;
+    }
+
+    auto const activationsBefore = GetConsumerActivations();
+    for (auto _ : state)
+    {
+        providers.Start();
+        providers.Stop();
+    }
+    auto const reactivations = static_cast<double>(GetConsumerActivations() - activationsBefore);
+    state.counters["reactivations"] = benchmark::Counter(reactivations, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_REGISTER_F(ReferenceEventBatchFixture, StartStopProviderBundle)
+    ->ArgName("coalesce")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
@@ -110,6 +110,21 @@ namespace cppmicroservices
                 US_ServiceComponent_EXPORT extern const std::string CONFIG_POLICY_OPTIONAL;
                 US_ServiceComponent_EXPORT extern const std::string CONFIG_POLICY_REQUIRE;
 
+                /**
+                 * \ingroup gr_componentconstants
+                 * Framework property specifying whether Service Component Runtime coalesces
+                 * the reference changes caused by starting or stopping a bundle. If enabled,
+                 * the services registered and unregistered while a bundle starts or stops are
+                 * applied to the references of the components as one change when the bundle
+                 * has started or stopped. For example, a component with a static reference
+                 * of multiple cardinality is reactivated once instead of once per service.
+                 *
+                 * Until then, components depending on these services are not yet activated
+                 * or rebound. The value of this property must be of type \c bool. The
+                 * default value is \c false.
+                 */
+                US_ServiceComponent_EXPORT extern const std::string DS_COALESCE_BUNDLE_EVENTS;
+
             } // namespace ComponentConstants
 
         } // namespace component
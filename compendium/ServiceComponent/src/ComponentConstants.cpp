@@ -92,6 +92,13 @@ namespace cppmicroservices
                 const std::string CONFIG_POLICY_IGNORE = "ignore";
                 const std::string CONFIG_POLICY_REQUIRE = "require";
                 const std::string CONFIG_POLICY_OPTIONAL = "optional";
+
+                /**
+                 * Framework property enabling the coalescing of the reference changes
+                 * caused by starting or stopping a bundle.
+                 */
+                const std::string DS_COALESCE_BUNDLE_EVENTS
+                    = "org.cppmicroservices.declarativeservices.coalesce.bundle.events";
             } // namespace ComponentConstants
         }     // namespace component
     }         // namespace service
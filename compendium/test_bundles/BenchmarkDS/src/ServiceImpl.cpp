@@ -1,10 +1,38 @@
 #include "ServiceImpl.hpp"
 
+#include <algorithm>
+#include <atomic>
+
 namespace sample
 {
+    namespace
+    {
+        std::atomic<int> consumerActivations(0);
+    }
+
     std::string
     DSBenchmarkComponent::Description()
     {
         return STRINGIZE(US_BUNDLE_NAME);
     }
+
+    DSBenchmarkConsumer::DSBenchmarkConsumer() { ++consumerActivations; }
+
+    std::string
+    DSBenchmarkConsumer::Description()
+    {
+        return std::to_string(consumerActivations.load());
+    }
+
+    void
+    DSBenchmarkConsumer::Bindproviders(std::shared_ptr<test::Interface2> const& provider)
+    {
+        providers.push_back(provider);
+    }
+
+    void
+    DSBenchmarkConsumer::Unbindproviders(std::shared_ptr<test::Interface2> const& provider)
+    {
+        providers.erase(std::remove(providers.begin(), providers.end(), provider), providers.end());
+    }
 } // namespace sample
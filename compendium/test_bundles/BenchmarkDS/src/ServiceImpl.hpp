@@ -3,6 +3,9 @@
 
 #include "TestInterfaces/Interfaces.hpp"
 
+#include <memory>
+#include <vector>
+
 namespace sample
 {
     class DSBenchmarkComponent : public test::Interface1
@@ -12,6 +15,25 @@ namespace sample
         ~DSBenchmarkComponent() override = default;
         std::string Description() override;
     };
+
+    /**
+     * Component with a static reference of multiple cardinality to all the
+     * test::Interface2 services. It is reactivated whenever the set of bound
+     * services changes. Description() returns the number of activations.
+     */
+    class DSBenchmarkConsumer : public test::Interface1
+    {
+      public:
+        DSBenchmarkConsumer();
+        ~DSBenchmarkConsumer() override = default;
+        std::string Description() override;
+
+        void Bindproviders(std::shared_ptr<test::Interface2> const&);
+        void Unbindproviders(std::shared_ptr<test::Interface2> const&);
+
+      private:
+        std::vector<std::shared_ptr<test::Interface2>> providers;
+    };
 } // namespace sample
 
 #endif // _SERVICE_IMPL_HPP_
@@ -0,0 +1,84 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+#include "cppmicroservices/BundleActivator.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/ServiceProperties.h"
+
+#include "TestInterfaces/Interfaces.hpp"
+
+#include <vector>
+
+namespace BenchmarkDSProviders
+{
+
+    class Provider final : public test::Interface2
+    {
+      public:
+        std::string
+        ExtendedDescription() override
+        {
+            return "BenchmarkDSProviders";
+        }
+    };
+
+    /**
+     * Registers a burst of test::Interface2 services when started, which
+     * the sample::DSBenchmarkConsumer component of the BenchmarkDS bundle
+     * binds to.
+     */
+    class Activator : public cppmicroservices::BundleActivator
+    {
+      public:
+        static constexpr int ServiceCount = 200;
+
+        Activator() = default;
+        ~Activator() = default;
+
+        void
+        Start(cppmicroservices::BundleContext context)
+        {
+            for (int i = 0; i < ServiceCount; ++i)
+            {
+                cppmicroservices::ServiceProperties props;
+                props[cppmicroservices::Constants::SERVICE_RANKING] = i;
+                regs.push_back(context.RegisterService<test::Interface2>(std::make_shared<Provider>(), props));
+            }
+        }
+
+        void
+        Stop(cppmicroservices::BundleContext /*context*/)
+        {
+            for (auto& reg : regs)
+            {
+                reg.Unregister();
+            }
+            regs.clear();
+        }
+
+      private:
+        std::vector<cppmicroservices::ServiceRegistration<test::Interface2>> regs;
+    };
+
+} // namespace BenchmarkDSProviders
+
+CPPMICROSERVICES_EXPORT_BUNDLE_ACTIVATOR(BenchmarkDSProviders::Activator)
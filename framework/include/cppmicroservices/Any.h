@@ -41,8 +41,11 @@ DEALINGS IN THE SOFTWARE.
 #include <list>
 #include <map>
 #include <memory>
+#include <new>
 #include <set>
 #include <sstream>
+#include <string>
+#include <type_traits>
 #include <typeinfo>
 #include <utility>
 #include <vector>
@@ -278,6 +281,11 @@ namespace cppmicroservices
      * of the internally stored data.
      *
      * Code taken from the Boost 1.46.1 library. Original copyright by Kevlin Henney. Modified for CppMicroServices.
+     *
+     * Values of small types which cannot throw when moved, like integral types,
+     * bool and (on most platforms) std::string, are stored inside the Any object
+     * itself. Values of other types are allocated on the heap. Moving or swapping
+     * an Any therefore invalidates references to its value obtained with ref_any_cast.
      */
     class US_Framework_EXPORT Any
     {
@@ -287,6 +295,8 @@ namespace cppmicroservices
          */
         Any();
 
+        ~Any() { Destroy(); }
+
         /**
          * Creates an Any which stores the init parameter inside.
          *
@@ -299,7 +309,7 @@ namespace cppmicroservices
          * \endcode
          */
         template <typename ValueType>
-        Any(ValueType const& value) : _content(new Holder<ValueType>(value))
+        Any(ValueType const& value) : _content(Holder<ValueType>::Create(_buffer, value))
         {
         }
 
@@ -308,14 +318,14 @@ namespace cppmicroservices
          *
          * \param other The Any to copy
          */
-        Any(Any const& other) : _content(other._content ? other._content->Clone() : nullptr) {}
+        Any(Any const& other) : _content(other._content ? other._content->Clone(_buffer) : nullptr) {}
 
         /**
          * Move constructor.
          *
          * @param other The Any to move
          */
-        Any(Any&& other) noexcept : _content(std::move(other._content)) {}
+        Any(Any&& other) noexcept { MoveFrom(other); }
 
         /**
          * Swaps the content of the two Anys.
@@ -325,7 +335,12 @@ namespace cppmicroservices
         Any&
         Swap(Any& rhs)
         {
-            std::swap(_content, rhs._content);
+            if (this != &rhs)
+            {
+                Any tmp(std::move(rhs));
+                rhs.MoveFrom(*this);
+                MoveFrom(tmp);
+            }
             return *this;
         }
 
@@ -420,7 +435,11 @@ namespace cppmicroservices
         Any&
         operator=(Any&& rhs) noexcept
         {
-            _content = std::move(rhs._content);
+            if (this != &rhs)
+            {
+                Destroy();
+                MoveFrom(rhs);
+            }
             return *this;
         }
 
@@ -493,6 +512,12 @@ namespace cppmicroservices
         }
 
       private:
+        // Room for the holder of a small value, e.g. a std::string. Together with the
+        // content pointer this makes an Any 48 bytes large on typical 64-bit platforms.
+        static constexpr std::size_t SMALL_BUFFER_SIZE = sizeof(void*) + sizeof(std::string);
+        static constexpr std::size_t SMALL_BUFFER_ALIGN
+            = alignof(double) > alignof(void*) ? alignof(double) : alignof(void*);
+
         class Placeholder
         {
           public:
@@ -502,7 +527,13 @@ namespace cppmicroservices
             virtual std::string ToJSON(const uint8_t increment = 0, const int32_t indent = 0) const = 0;
 
             virtual std::type_info const& Type() const = 0;
-            virtual std::unique_ptr<Placeholder> Clone() const = 0;
+
+            //! Copy the value into buffer if it is small enough, otherwise onto the heap.
+            virtual Placeholder* Clone(void* buffer) const = 0;
+
+            //! Move an inline stored value into buffer.
+            virtual Placeholder* MoveTo(void* buffer) noexcept = 0;
+
             virtual bool compare(Any const& lhs) const = 0;
         };
 
@@ -514,6 +545,26 @@ namespace cppmicroservices
 
             Holder(ValueType&& value) : _held(std::move(value)) {}
 
+            static constexpr bool
+            IsInline()
+            {
+                return sizeof(Holder) <= SMALL_BUFFER_SIZE && alignof(Holder) <= SMALL_BUFFER_ALIGN
+                       && std::is_nothrow_move_constructible<ValueType>::value;
+            }
+
+            static Placeholder*
+            Create(void* buffer, ValueType const& value)
+            {
+                if constexpr (IsInline())
+                {
+                    return new (buffer) Holder(value);
+                }
+                else
+                {
+                    return new Holder(value);
+                }
+            }
+
             std::string
             ToString() const override
             {
@@ -536,10 +587,25 @@ namespace cppmicroservices
                 return typeid(ValueType);
             }
 
-            std::unique_ptr<Placeholder>
-            Clone() const override
+            Placeholder*
+            Clone(void* buffer) const override
             {
-                return std::unique_ptr<Placeholder>(new Holder(_held));
+                return Create(buffer, _held);
+            }
+
+            Placeholder*
+            MoveTo(void* buffer) noexcept override
+            {
+                if constexpr (IsInline())
+                {
+                    return new (buffer) Holder(std::move(_held));
+                }
+                else
+                {
+                    // heap allocated values are never moved
+                    static_cast<void>(buffer);
+                    return nullptr;
+                }
             }
 
             ValueType _held;
@@ -566,7 +632,47 @@ namespace cppmicroservices
         template <typename ValueType>
         friend ValueType* unsafe_any_cast(Any*);
 
-        std::unique_ptr<Placeholder> _content;
+        bool
+        IsInline() const noexcept
+        {
+            // std::less gives a total order even for pointers into different objects
+            std::less<void const*> const less;
+            void const* content = _content;
+            return !less(content, _buffer) && less(content, _buffer + SMALL_BUFFER_SIZE);
+        }
+
+        void
+        Destroy() noexcept
+        {
+            if (IsInline())
+            {
+                _content->~Placeholder();
+            }
+            else
+            {
+                delete _content;
+            }
+            _content = nullptr;
+        }
+
+        //! Take the content of other, which must be empty afterwards. This Any must be empty.
+        void
+        MoveFrom(Any& other) noexcept
+        {
+            if (other.IsInline())
+            {
+                _content = other._content->MoveTo(_buffer);
+                other.Destroy();
+            }
+            else
+            {
+                _content = other._content;
+                other._content = nullptr;
+            }
+        }
+
+        alignas(SMALL_BUFFER_ALIGN) unsigned char _buffer[SMALL_BUFFER_SIZE];
+        Placeholder* _content { nullptr };
     };
 
     /**
@@ -629,7 +735,7 @@ namespace cppmicroservices
     any_cast(Any* operand)
     {
         return operand && operand->Type() == typeid(ValueType)
-                   ? &static_cast<Any::Holder<ValueType>*>(operand->_content.get())->_held
+                   ? &static_cast<Any::Holder<ValueType>*>(operand->_content)->_held
                    : nullptr;
     }
 
@@ -769,7 +875,7 @@ namespace cppmicroservices
     ValueType*
     unsafe_any_cast(Any* operand)
     {
-        return &static_cast<Any::Holder<ValueType>*>(operand->_content.get())->_held;
+        return &static_cast<Any::Holder<ValueType>*>(operand->_content)->_held;
     }
 
     /**
@@ -46,6 +46,8 @@ namespace cppmicroservices
             bool operator()(std::string const& l, std::string const& r) const;
         };
 
+        class flat_any_cimap;
+
     } // namespace detail
 
     /**
@@ -59,6 +61,12 @@ namespace cppmicroservices
      * - \c any_map::ordered_any_map (a STL map)
      * - \c any_map::unordered_any_map (a STL unordered map)
      * - \c any_map::unordered_any_cimap (a STL unordered map with case insensitive key comparison)
+     * - a flat map with case insensitive key comparison, storing its entries
+     *   contiguously (\c FLAT_MAP_CASEINSENSITIVE_KEYS). Entries are iterated
+     *   in insertion order, except that erasing an entry moves the last entry
+     *   into its place. It needs no allocation per entry, which makes it the
+     *   most compact choice for small maps like service properties. Inserting
+     *   into or erasing from it invalidates references to its entries.
      *
      * This class provides most of the STL functions for associated containers,
      * including forward iterators. It is typically not instantiated by clients
@@ -88,7 +96,8 @@ namespace cppmicroservices
         {
             ORDERED_MAP,
             UNORDERED_MAP,
-            UNORDERED_MAP_CASEINSENSITIVE_KEYS
+            UNORDERED_MAP_CASEINSENSITIVE_KEYS,
+            FLAT_MAP_CASEINSENSITIVE_KEYS
         };
 
       private:
@@ -102,7 +111,8 @@ namespace cppmicroservices
                 NONE,
                 ORDERED,
                 UNORDERED,
-                UNORDERED_CI
+                UNORDERED_CI,
+                FLAT_CI
             };
 
             iter_type type { NONE };
@@ -143,6 +153,7 @@ namespace cppmicroservices
 
             const_iter(ociter&& it);
             const_iter(uociter&& it, iter_type type);
+            const_iter(pointer it);
 
             reference operator*() const;
             pointer operator->() const;
@@ -166,6 +177,7 @@ namespace cppmicroservices
                 ociter* o;
                 uociter* uo;
                 uocciiter* uoci;
+                pointer f;
             } it;
         };
 
@@ -188,6 +200,7 @@ namespace cppmicroservices
 
             iter(oiter&& it);
             iter(uoiter&& it, iter_type type);
+            iter(pointer it);
 
             reference operator*() const;
             pointer operator->() const;
@@ -213,6 +226,7 @@ namespace cppmicroservices
                 oiter* o;
                 uoiter* uo;
                 uociiter* uoci;
+                pointer f;
             } it;
         };
 
@@ -247,6 +261,12 @@ namespace cppmicroservices
         size_type count(key_type const& key) const;
         void clear();
 
+        /**
+         * Reserve space for at least count elements. This has no effect on
+         * maps of type ORDERED_MAP.
+         */
+        void reserve(size_type count);
+
         mapped_type& at(key_type const& key);
         mapped_type const& at(key_type const& key) const;
 
@@ -275,6 +295,10 @@ namespace cppmicroservices
                     auto p = uoci_m().emplace(std::forward<Args>(args)...);
                     return { iterator(std::move(p.first), iterator::UNORDERED_CI), p.second };
                 }
+                case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                {
+                    return emplaceF(value_type(std::forward<Args>(args)...));
+                }
                 default:
                     throw std::logic_error("invalid map type");
             }
@@ -328,6 +352,7 @@ namespace cppmicroservices
         unordered_any_cimap::const_iterator beginUOCI_TypeChecked() const;
         unordered_any_cimap::const_iterator endUOCI_TypeChecked() const;
         unordered_any_cimap::const_iterator findUOCI_TypeChecked(key_type const& key) const;
+        detail::flat_any_cimap const& F_TypeChecked() const;
         // =========================================================================
 
         ordered_any_map const& o_m() const;
@@ -336,6 +361,10 @@ namespace cppmicroservices
         unordered_any_map& uo_m();
         unordered_any_cimap const& uoci_m() const;
         unordered_any_cimap& uoci_m();
+        detail::flat_any_cimap const& f_m() const;
+        detail::flat_any_cimap& f_m();
+
+        std::pair<iterator, bool> emplaceF(value_type&& value);
 
         inline void copy_from(any_map const& m);
         inline void move_from(any_map&& m) noexcept;
@@ -346,6 +375,7 @@ namespace cppmicroservices
             ordered_any_map* o;
             unordered_any_map* uo;
             unordered_any_cimap* uoci;
+            detail::flat_any_cimap* f;
         } map;
     };
 
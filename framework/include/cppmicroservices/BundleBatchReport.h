@@ -0,0 +1,96 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLEBATCHREPORT_H
+#define CPPMICROSERVICES_BUNDLEBATCHREPORT_H
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace cppmicroservices
+{
+
+    /**
+     * \ingroup MicroServices
+     *
+     * Timing of one install location in a batch install.
+     *
+     * @see BundleContext::InstallBundles(std::vector<std::string> const&, BundleBatchReport*)
+     */
+    struct BundleInstallTiming
+    {
+        /// The install location
+        std::string location;
+
+        /// The number of bundles installed from the location
+        std::size_t bundleCount = 0;
+
+        /// Time spent opening the bundle file, reading the manifests and installing the bundles
+        std::chrono::nanoseconds duration { 0 };
+
+        /// The exception which made installing the location fail, if any
+        std::exception_ptr exception;
+    };
+
+    /**
+     * \ingroup MicroServices
+     *
+     * Timing of one bundle in a batch start.
+     *
+     * @see BundleContext::StartBundles
+     */
+    struct BundleStartTiming
+    {
+        /// The id of the bundle
+        long bundleId = -1;
+
+        /// The symbolic name of the bundle
+        std::string symbolicName;
+
+        /// Time spent validating the bundle and loading its shared library ahead of Bundle::Start()
+        std::chrono::nanoseconds loadDuration { 0 };
+
+        /// Time spent in Bundle::Start(), including the bundle activator
+        std::chrono::nanoseconds startDuration { 0 };
+
+        /// The exception thrown by Bundle::Start(), if any
+        std::exception_ptr exception;
+    };
+
+    /**
+     * \ingroup MicroServices
+     *
+     * Per-bundle timings of batch install and start operations. The same
+     * report can be passed to several calls; each call appends its entries.
+     */
+    struct BundleBatchReport
+    {
+        std::vector<BundleInstallTiming> installs;
+        std::vector<BundleStartTiming> starts;
+    };
+
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_BUNDLEBATCHREPORT_H
@@ -37,6 +37,7 @@ namespace cppmicroservices
 
     class AnyMap;
     class Bundle;
+    struct BundleBatchReport;
     class BundleContext;
     class BundleContextPrivate;
     class ServiceFactory;
@@ -1112,6 +1113,54 @@ namespace cppmicroservices
                                            cppmicroservices::AnyMap const& bundleManifest = cppmicroservices::AnyMap(
                                                cppmicroservices::any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS));
 
+        /**
+         * Installs all bundles from the bundle libraries at the specified locations.
+         *
+         * The locations are installed concurrently, i.e. the bundle files are
+         * opened, their manifests are read and the bundles are installed on several
+         * threads. Each location is installed like with InstallBundles(std::string const&, AnyMap const&).
+         *
+         * If installing a location fails, the remaining locations are still installed
+         * and the first failure is rethrown after all locations were processed.
+         *
+         * @param locations The locations of the bundle libraries to install.
+         * @param report <b>OPTIONAL</b> - if not null, the install time and outcome of each
+         *        location is appended to <code>report->installs</code>, in the order of locations.
+         * @return The Bundle objects of the installed bundle libraries, in the order of locations.
+         * @throws std::runtime_error If the BundleContext is no longer valid, or if the installation failed.
+         * @throws std::logic_error If the framework instance is no longer active
+         * @throws std::invalid_argument If a location is not a valid UTF8 string
+         *
+         * @see BundleBatchReport
+         */
+        std::vector<Bundle> InstallBundles(std::vector<std::string> const& locations,
+                                           BundleBatchReport* report = nullptr);
+
+        /**
+         * Starts the given bundles.
+         *
+         * The bundles are validated and their shared libraries are loaded concurrently
+         * first, so the function set with Constants::FRAMEWORK_BUNDLE_VALIDATION_FUNC
+         * may be called for several bundles at the same time. Then the bundles are
+         * started on the calling thread, in the given order, like with Bundle::Start().
+         * The order is the only start order the framework knows of, so list bundles
+         * before the bundles which depend on them.
+         * A bundle listed more than once is started once, at its first position.
+         *
+         * If starting a bundle fails, the remaining bundles are still started and
+         * the first failure is rethrown after all bundles were processed.
+         *
+         * @param bundles The bundles to start.
+         * @param report <b>OPTIONAL</b> - if not null, the load and start times and the outcome
+         *        of each bundle are appended to <code>report->starts</code>, in the start order.
+         * @throws std::runtime_error If the BundleContext is no longer valid, or if a bundle could not be started.
+         * @throws std::invalid_argument If one of the bundles is invalid
+         *
+         * @see Bundle::Start()
+         * @see BundleBatchReport
+         */
+        void StartBundles(std::vector<Bundle> const& bundles, BundleBatchReport* report = nullptr);
+
       private:
         friend US_Framework_EXPORT BundleContext MakeBundleContext(BundleContextPrivate*);
         friend BundleContext MakeBundleContext(std::shared_ptr<BundleContextPrivate> const&);
@@ -35,8 +35,14 @@ namespace cppmicroservices
 {
 
     class BundleResourcePrivate;
+    class BundleResourceInflater;
     struct BundleArchive;
 
+    namespace detail
+    {
+        class BundleResourceBuffer;
+    }
+
     /**
     \defgroup gr_bundleresource BundleResource
 
@@ -310,6 +316,7 @@ namespace cppmicroservices
         friend struct BundleArchive;
         friend class BundleResourceContainer;
         friend class BundleResourceStream;
+        friend class detail::BundleResourceBuffer;
 
         friend struct ::std::hash<BundleResource>;
 
@@ -317,6 +324,15 @@ namespace cppmicroservices
 
         std::unique_ptr<void, void (*)(void*)> GetData() const;
 
+        /// Like GetData(), but uncompressed resources may refer to the
+        /// memory mapped bundle instead of a copy.
+        std::shared_ptr<void const> GetSharedData() const;
+
+        /// Get an inflater which reads a compressed resource of a memory
+        /// mapped bundle incrementally, or null if there is none for this
+        /// resource.
+        std::unique_ptr<BundleResourceInflater> GetInflater() const;
+
         std::shared_ptr<BundleResourcePrivate> d;
     };
 
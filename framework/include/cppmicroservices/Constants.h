@@ -317,6 +317,86 @@ namespace cppmicroservices
         US_Framework_EXPORT extern const std::string
             FRAMEWORK_BUNDLE_VALIDATION_FUNC; // = "org.cppmicroservices.framework.bundle.validation.function"
 
+        /**
+         * Framework launching property specifying whether service lookups read
+         * immutable snapshots of the service registry instead of taking the
+         * registry lock. The snapshots are kept per service class: registering,
+         * modifying or unregistering a service drops the snapshots of its classes
+         * and of all services, and the next lookup of one of them rebuilds it.
+         * Snapshots of other classes are not affected. This improves the
+         * throughput of concurrent lookups in lookup-heavy applications at the
+         * cost of copying the services of a class on the first lookup after a
+         * change to it.
+         *
+         * This property's default value is off (boolean 'false').
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_SERVICE_REGISTRY_SNAPSHOT; // = "org.cppmicroservices.framework.service.registry.snapshot"
+
+        /**
+         * Framework launching property specifying whether service events are
+         * delivered asynchronously. If enabled, the events for each service
+         * listener are queued and delivered in order on a pool of framework
+         * threads, so a slow listener does not stall the thread registering,
+         * modifying or unregistering a service. Pending events which became
+         * redundant are coalesced: a MODIFIED event directly following a pending
+         * REGISTERED or MODIFIED event for the same service is dropped, and
+         * an UNREGISTERING event for a service whose REGISTERED event is still
+         * pending cancels all pending events for that service.
+         *
+         * Listeners receive UNREGISTERING events after the service has been
+         * unregistered. ServiceEventListenerHook services are still called
+         * synchronously.
+         *
+         * This property's default value is off (boolean 'false').
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_SERVICE_EVENTS_ASYNC; // = "org.cppmicroservices.framework.service.events.async"
+
+        /**
+         * Framework launching property specifying whether the parsed manifests
+         * of installed bundles are cached on disk. The cache is kept in the
+         * "cache" directory of the framework storage location (see
+         * #FRAMEWORK_STORAGE) and consulted when a bundle is installed without
+         * an injected manifest. An entry is only used while the size,
+         * modification time and inode of the bundle file are unchanged, in which
+         * case the bundle is installed without opening its resources and
+         * without parsing its manifest.json files.
+         *
+         * This property's default value is off (boolean 'false').
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_BUNDLE_METADATA_CACHE; // = "org.cppmicroservices.framework.bundle.metadata.cache"
+
+        /**
+         * Framework launching property specifying whether tracing spans are
+         * recorded from the start of the framework, see Tracer. The spans
+         * cover installing and starting bundles, parsing manifests, loading
+         * shared libraries and the work of extenders which record spans, and
+         * can be exported with Tracer::WriteChromeTrace.
+         *
+         * The spans are recorded process wide. Setting this property to
+         * 'false' does not stop recording if it was started otherwise.
+         *
+         * This property's default value is off (boolean 'false').
+         */
+        US_Framework_EXPORT extern const std::string FRAMEWORK_TRACE; // = "org.cppmicroservices.framework.trace"
+
+        /**
+         * Framework launching property specifying whether the service registry
+         * collects metrics, see Framework::GetServiceRegistryMetrics. The metrics
+         * count registrations, lookups, filter evaluations and listener calls,
+         * record how long threads wait for the registry, listener and service
+         * properties locks, and track the most queried interfaces and filters.
+         *
+         * When the metrics are off, the registry only tests a null pointer
+         * where it would record them.
+         *
+         * This property's default value is off (boolean 'false').
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_SERVICE_REGISTRY_METRICS; // = "org.cppmicroservices.framework.service.registry.metrics"
+
         /*
          * Service properties.
          */
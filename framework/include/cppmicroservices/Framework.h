@@ -25,8 +25,10 @@
 
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/FrameworkConfig.h"
+#include "cppmicroservices/ServiceRegistryMetrics.h"
 
 #include <chrono>
+#include <cstddef>
 #include <map>
 #include <ostream>
 #include <string>
@@ -134,6 +136,21 @@ namespace cppmicroservices
          */
         FrameworkEvent WaitForStop(std::chrono::milliseconds const& timeout);
 
+        /**
+         * Returns the metrics collected so far by the service registry of this
+         * Framework.
+         *
+         * The metrics are only collected if the
+         * {@link Constants#FRAMEWORK_SERVICE_REGISTRY_METRICS} launch property
+         * was set to \c true. Otherwise the returned metrics are empty and not
+         * {@link ServiceRegistryMetrics#enabled enabled}.
+         *
+         * @param topN The maximum number of most queried interfaces and filters
+         *        to return.
+         * @return A snapshot of the service registry metrics.
+         */
+        ServiceRegistryMetrics GetServiceRegistryMetrics(std::size_t topN = 10) const;
+
         /**
          * Start this Framework.
          *
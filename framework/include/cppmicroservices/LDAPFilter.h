@@ -25,6 +25,8 @@
 
 #include "cppmicroservices/AnyMap.h"
 
+#include <cstdint>
+
 #ifdef _MSC_VER
 #    pragma warning(push)
 #    pragma warning(disable : 4251)
@@ -68,6 +70,21 @@ namespace cppmicroservices
     {
 
       public:
+        /**
+         * Counters of the process-wide cache of compiled filter expressions,
+         * which is shared by all <code>LDAPFilter</code> objects, service
+         * lookups and service listeners.
+         *
+         * @see GetCacheStatistics()
+         */
+        struct CacheStatistics
+        {
+            std::uint64_t hits;   ///< Number of filter strings found in the cache
+            std::uint64_t misses; ///< Number of filter strings which had to be parsed
+            std::size_t size;     ///< Number of cached expressions
+            std::size_t capacity; ///< Maximum number of cached expressions
+        };
+
         /**
          * Creates a valid <code>LDAPFilter</code> object that
          * matches nothing.
@@ -143,6 +160,26 @@ namespace cppmicroservices
          */
         bool Match(AnyMap const& dictionary) const;
 
+        /**
+         * Filter using a <code>AnyMap</code> and a second <code>AnyMap</code> with
+         * default values. Keys which are not in <code>dictionary</code> are looked
+         * up in <code>defaults</code>, so the filter can combine the values of both
+         * without copying them into one <code>AnyMap</code>. The keys are looked
+         * up in a case insensitive manner.
+         *
+         * @param dictionary The <code>AnyMap</code> whose key/value pairs are used
+         *        in the match.
+         * @param defaults The <code>AnyMap</code> whose key/value pairs are used
+         *        for the keys missing from <code>dictionary</code>.
+         * @return <code>true</code> if the values match this filter;
+         *         <code>false</code> otherwise.
+         * @throws std::runtime_error If the number of keys in an <code>AnyMap</code>
+         *         exceeds the value returned by std::numeric_limits<int>::max().
+         * @throws std::runtime_error If an <code>AnyMap</code> contains case variants
+         *         of the same key name.
+         */
+        bool Match(AnyMap const& dictionary, AnyMap const& defaults) const;
+
         /**
          * Filter using a <code>AnyMap</code>. This <code>LDAPFilter</code> is executed using
          * the specified <code>AnyMap</code>'s keys and values. The keys are looked
@@ -184,6 +221,15 @@ namespace cppmicroservices
 
         LDAPFilter& operator=(LDAPFilter const& filter);
 
+        /**
+         * Returns the current counters of the compiled filter expression cache.
+         * Malformed filter strings are never cached and count as a miss each
+         * time they are parsed.
+         *
+         * @return A snapshot of the cache counters.
+         */
+        static CacheStatistics GetCacheStatistics();
+
       protected:
         std::shared_ptr<LDAPFilterData> d;
     };
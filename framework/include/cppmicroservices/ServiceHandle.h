@@ -0,0 +1,161 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_SERVICEHANDLE_H
+#define CPPMICROSERVICES_SERVICEHANDLE_H
+
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/FrameworkExport.h"
+#include "cppmicroservices/ServiceInterface.h"
+#include "cppmicroservices/ServiceReference.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cppmicroservices
+{
+
+    class ServiceHandleBasePrivate;
+
+    class US_Framework_EXPORT ServiceHandleBase
+    {
+
+      protected:
+        ServiceHandleBase(BundleContext const& context, std::string const& interfaceId);
+
+        ServiceHandleBase(ServiceHandleBase const& other);
+        ServiceHandleBase& operator=(ServiceHandleBase const& other);
+
+        ~ServiceHandleBase();
+
+        // True if the service registry did not change since the last Resolve() call
+        bool
+        IsCurrent() const noexcept
+        {
+            return generation->load(std::memory_order_acquire) == resolvedGeneration;
+        }
+
+        // Look up the best ranked service again. Returns true and sets service if
+        // it is not the service found by the previous call.
+        bool Resolve(std::shared_ptr<void>& service) const;
+
+        ServiceReferenceBase GetReference() const;
+
+      private:
+        std::shared_ptr<ServiceHandleBasePrivate> d;
+        std::shared_ptr<std::atomic<std::uint64_t> const> generation;
+        mutable std::uint64_t resolvedGeneration;
+        mutable ServiceReferenceU reference;
+    };
+
+    /**
+    \defgroup gr_servicehandle ServiceHandle
+
+    \brief Groups ServiceHandle class related symbols.
+    */
+
+    /**
+     * @ingroup MicroServices
+     * @ingroup gr_servicehandle
+     *
+     * A cached handle to the highest ranked service implementing \c S.
+     *
+     * The handle looks up the service once and then only checks a counter which
+     * the framework advances whenever a service is registered, unregistered or
+     * re-ranked. While no such change happened, Get() does not lock, allocate or
+     * look up anything. This makes ServiceHandle suitable for code which fetches
+     * a service for every request. Use a ServiceTracker to be notified about
+     * changes instead.
+     *
+     * A ServiceHandle keeps the service object it returned last, so the bundle of
+     * the BundleContext used to create the handle stays a user of that service
+     * until the handle is destroyed or a different service is returned.
+     *
+     * A ServiceHandle object must not be used from multiple threads concurrently.
+     * Copies are independent of each other, so give each thread its own copy.
+     *
+     * @tparam S The service interface type.
+     */
+    template <class S>
+    class ServiceHandle : private ServiceHandleBase
+    {
+
+      public:
+        /**
+         * Create a handle for the highest ranked service implementing \c S. The
+         * service is looked up on the first call to Get().
+         *
+         * @param context The BundleContext used to look up and get the service.
+         *
+         * @throw std::runtime_error If \c context is no longer valid.
+         */
+        explicit ServiceHandle(BundleContext const& context) : ServiceHandleBase(context, us_service_interface_iid<S>())
+        {
+        }
+
+        /**
+         * Returns the service object of the highest ranked service implementing
+         * \c S, looking it up again only if the service registry changed since
+         * the last call.
+         *
+         * @return A \c shared_ptr to the service object, which is empty if no
+         *         such service is registered or the service object could not be
+         *         obtained.
+         *
+         * @throw std::runtime_error If the service must be looked up again and the
+         *        BundleContext used to create this handle is no longer valid.
+         */
+        std::shared_ptr<S>
+        Get() const
+        {
+            if (!IsCurrent())
+            {
+                std::shared_ptr<void> newService;
+                if (Resolve(newService))
+                {
+                    service = std::static_pointer_cast<S>(newService);
+                }
+            }
+            return service;
+        }
+
+        /**
+         * Returns the ServiceReference of the service returned by the last call
+         * to Get().
+         *
+         * @return The ServiceReference, which is invalid if Get() was not called
+         *         yet or did not find a service.
+         */
+        ServiceReference<S>
+        GetServiceReference() const
+        {
+            return this->ServiceHandleBase::GetReference();
+        }
+
+      private:
+        mutable std::shared_ptr<S> service;
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_SERVICEHANDLE_H
@@ -0,0 +1,109 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_SERVICEREGISTRYMETRICS_H
+#define CPPMICROSERVICES_SERVICEREGISTRYMETRICS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cppmicroservices
+{
+
+    /**
+     * \ingroup MicroServices
+     *
+     * Distribution of the time threads waited to acquire a lock.
+     *
+     * Bucket \c i of \c counts holds the waits shorter than \c upperBounds[i]
+     * and not shorter than the previous bound. The last bucket of \c counts
+     * has no upper bound, so \c counts has one element more than \c upperBounds.
+     */
+    struct LockWaitHistogram
+    {
+        /// The exclusive upper bounds of the buckets, in increasing order
+        std::vector<std::chrono::nanoseconds> upperBounds;
+
+        /// The number of waits in each bucket
+        std::vector<std::uint64_t> counts;
+
+        /// The number of times the lock was acquired
+        std::uint64_t acquisitions = 0;
+
+        /// The sum of all waits
+        std::chrono::nanoseconds totalWait { 0 };
+
+        /// The longest wait
+        std::chrono::nanoseconds maxWait { 0 };
+    };
+
+    /**
+     * \ingroup MicroServices
+     *
+     * A snapshot of the metrics collected by the service registry of a
+     * framework.
+     *
+     * @see Constants::FRAMEWORK_SERVICE_REGISTRY_METRICS
+     * @see Framework::GetServiceRegistryMetrics
+     */
+    struct ServiceRegistryMetrics
+    {
+        /// Whether the framework collects metrics. All other members are empty if not.
+        bool enabled = false;
+
+        /// The number of services registered
+        std::uint64_t registrations = 0;
+
+        /// The number of services unregistered
+        std::uint64_t unregistrations = 0;
+
+        /// The number of service lookups which named an interface
+        std::uint64_t lookupsByClass = 0;
+
+        /// The number of times a filter was evaluated against the properties of a service
+        std::uint64_t filterEvaluations = 0;
+
+        /// The number of times a service listener was called
+        std::uint64_t listenerInvocations = 0;
+
+        /// Waits for the lock of the service registry
+        LockWaitHistogram serviceRegistryLock;
+
+        /// Waits for the lock of the service listeners
+        LockWaitHistogram serviceListenersLock;
+
+        /// Waits for the locks of the service properties
+        LockWaitHistogram propertiesLock;
+
+        /// The most queried interfaces and their number of lookups, most queried first
+        std::vector<std::pair<std::string, std::uint64_t>> topInterfaces;
+
+        /// The most used lookup filters and their number of lookups, most used first
+        std::vector<std::pair<std::string, std::uint64_t>> topFilters;
+    };
+
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_SERVICEREGISTRYMETRICS_H
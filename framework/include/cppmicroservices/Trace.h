@@ -0,0 +1,148 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_TRACE_H
+#define CPPMICROSERVICES_TRACE_H
+
+#include "cppmicroservices/FrameworkExport.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace cppmicroservices
+{
+
+    /**
+     * \ingroup MicroServices
+     *
+     * Records where time is spent in the framework and its extenders, e.g.
+     * installing bundles, parsing manifests, loading shared libraries,
+     * starting bundles, activating components and notifying configuration
+     * listeners.
+     *
+     * Completed spans are kept in a process wide ring buffer, so the oldest
+     * spans are dropped once it is full. Recording is off by default and can
+     * be switched on with Enable() or with the Constants::FRAMEWORK_TRACE
+     * launching property. While it is off, an instrumented code path only
+     * reads an atomic flag.
+     */
+    class US_Framework_EXPORT Tracer
+    {
+      public:
+        /// The default number of spans kept in the ring buffer
+        static constexpr std::size_t DEFAULT_CAPACITY = 65536;
+
+        /**
+         * Start recording spans.
+         *
+         * @param capacity The number of spans to keep. If recording is already
+         *        on, the recorded spans are kept if the capacity is unchanged.
+         */
+        static void Enable(std::size_t capacity = DEFAULT_CAPACITY);
+
+        /// Stop recording spans. The recorded spans are kept.
+        static void Disable();
+
+        /// Discard all recorded spans.
+        static void Clear();
+
+        static bool
+        IsEnabled() noexcept
+        {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Write the recorded spans, oldest first, as Chrome trace-event JSON,
+         * which can be loaded into chrome://tracing or Perfetto.
+         */
+        static void WriteChromeTrace(std::ostream& os);
+
+        /// The length of the longest span name which is recorded without being truncated.
+        static constexpr std::size_t MAX_NAME_LENGTH = 63;
+
+        /**
+         * Record a completed span. name is copied, and truncated to
+         * MAX_NAME_LENGTH characters, so it only needs to stay valid during
+         * the call.
+         */
+        static void Record(char const* name,
+                           std::string const& detail,
+                           std::chrono::steady_clock::time_point start,
+                           std::chrono::steady_clock::time_point end);
+
+      private:
+        static std::atomic<bool> enabled;
+    };
+
+    namespace detail
+    {
+
+        /**
+         * Records the time between its construction and its destruction as a
+         * span, if recording was on when it was constructed.
+         */
+        class TraceSpan
+        {
+          public:
+            explicit TraceSpan(char const* name) : name(Tracer::IsEnabled() ? name : nullptr)
+            {
+                if (this->name)
+                {
+                    start = std::chrono::steady_clock::now();
+                }
+            }
+
+            TraceSpan(char const* name, std::string const& detail) : name(Tracer::IsEnabled() ? name : nullptr)
+            {
+                if (this->name)
+                {
+                    this->detail = detail;
+                    start = std::chrono::steady_clock::now();
+                }
+            }
+
+            TraceSpan(TraceSpan const&) = delete;
+            TraceSpan& operator=(TraceSpan const&) = delete;
+
+            ~TraceSpan()
+            {
+                if (name)
+                {
+                    Tracer::Record(name, detail, start, std::chrono::steady_clock::now());
+                }
+            }
+
+          private:
+            char const* const name;
+            std::string detail;
+            std::chrono::steady_clock::time_point start;
+        };
+
+    } // namespace detail
+
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_TRACE_H
@@ -31,6 +31,8 @@
 namespace cppmicroservices
 {
 
+    class BundleResource;
+
     namespace detail
     {
 
@@ -47,6 +49,16 @@ namespace cppmicroservices
                                           std::size_t size,
                                           std::ios_base::openmode mode);
 
+            /// The buffer shares ownership of data, which is not modified.
+            explicit BundleResourceBuffer(std::shared_ptr<void const> data,
+                                          std::size_t size,
+                                          std::ios_base::openmode mode);
+
+            /// Compressed resources of memory mapped bundles which are read in
+            /// binary mode are inflated incrementally, through a window of fixed
+            /// size, instead of being extracted completely first.
+            explicit BundleResourceBuffer(BundleResource const& resource, std::ios_base::openmode mode);
+
             ~BundleResourceBuffer() override;
 
           private:
@@ -64,6 +76,12 @@ namespace cppmicroservices
             pos_type seekpos(pos_type sp,
                              std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
 
+            // Fill the get area with the next inflated block, see BundleResourceInflater.
+            int_type InflatingUnderflow();
+
+            // Move the get area to an absolute position of the inflated data.
+            pos_type InflatingSeek(off_type pos);
+
           private:
             std::unique_ptr<BundleResourceBufferPrivate> d;
         };
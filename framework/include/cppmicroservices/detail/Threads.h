@@ -94,6 +94,12 @@ namespace cppmicroservices
                     m_Lock.unlock();
                 }
 
+                bool
+                TryLock()
+                {
+                    return m_Lock.try_lock();
+                }
+
                 template <typename Rep, typename Period>
                 bool
                 TryLockFor(std::chrono::duration<Rep, Period> const& duration)
@@ -109,6 +115,7 @@ namespace cppmicroservices
                 }
                 explicit UniqueLock(MutexLockingStrategy const&) {}
                 explicit UniqueLock(MutexLockingStrategy const*) {}
+                UniqueLock(MutexLockingStrategy const&, std::defer_lock_t) {}
                 void
                 Lock()
                 {
@@ -117,6 +124,11 @@ namespace cppmicroservices
                 UnLock()
                 {
                 }
+                bool
+                TryLock()
+                {
+                    return true;
+                }
                 template <typename Rep, typename Period>
                 bool
                 TryLockFor(std::chrono::duration<Rep, Period> const&)
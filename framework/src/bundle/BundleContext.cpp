@@ -23,6 +23,7 @@
 #include "cppmicroservices/BundleContext.h"
 
 #include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleBatchReport.h"
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/util/Error.h"
 #include "cppmicroservices/util/FileSystem.h"
@@ -33,9 +34,14 @@
 #include "CoreBundleContext.h"
 #include "ServiceReferenceBasePrivate.h"
 #include "ServiceRegistry.h"
+#include "Utils.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <iterator>
 #include <memory>
+#include <unordered_set>
 #include <utility>
 
 namespace cppmicroservices
@@ -529,4 +535,130 @@ namespace cppmicroservices
         return b->coreCtx->bundleRegistry.Install(location, b.get(), bundleManifest);
     }
 
+    std::vector<Bundle>
+    BundleContext::InstallBundles(std::vector<std::string> const& locations, BundleBatchReport* report)
+    {
+        if (!d)
+        {
+            throw std::runtime_error("The bundle context is no longer valid");
+        }
+
+        d->CheckValid();
+        auto b = GetAndCheckBundlePrivate(d);
+
+        std::vector<std::vector<Bundle>> installed(locations.size());
+        std::vector<BundleInstallTiming> timings(locations.size());
+        AnyMap const noManifest(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        RunConcurrently(locations.size(),
+                        [&](std::size_t i)
+                        {
+                            auto& timing = timings[i];
+                            timing.location = locations[i];
+                            auto const start = std::chrono::steady_clock::now();
+                            try
+                            {
+                                installed[i] = b->coreCtx->bundleRegistry.Install(locations[i], b.get(), noManifest);
+                            }
+                            catch (...)
+                            {
+                                timing.exception = std::current_exception();
+                            }
+                            timing.duration = std::chrono::steady_clock::now() - start;
+                            timing.bundleCount = installed[i].size();
+                        });
+
+        std::vector<Bundle> bundles;
+        for (auto& i : installed)
+        {
+            bundles.insert(bundles.end(), i.begin(), i.end());
+        }
+
+        auto const failed = std::find_if(timings.begin(),
+                                         timings.end(),
+                                         [](BundleInstallTiming const& timing) { return timing.exception; });
+        auto const exception = (failed != timings.end()) ? failed->exception : nullptr;
+        if (report)
+        {
+            report->installs.insert(report->installs.end(),
+                                    std::make_move_iterator(timings.begin()),
+                                    std::make_move_iterator(timings.end()));
+        }
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+        return bundles;
+    }
+
+    void
+    BundleContext::StartBundles(std::vector<Bundle> const& bundles, BundleBatchReport* report)
+    {
+        if (!d)
+        {
+            throw std::runtime_error("The bundle context is no longer valid");
+        }
+
+        d->CheckValid();
+        GetAndCheckBundlePrivate(d);
+
+        // a bundle listed more than once is started at its first position only
+        std::vector<std::shared_ptr<BundlePrivate>> privates;
+        std::unordered_set<BundlePrivate const*> listed;
+        privates.reserve(bundles.size());
+        for (auto const& bundle : bundles)
+        {
+            if (!bundle)
+            {
+                throw std::invalid_argument("invalid bundle");
+            }
+            auto b = GetPrivate(bundle);
+            if (listed.insert(b.get()).second)
+            {
+                privates.push_back(std::move(b));
+            }
+        }
+
+        std::vector<BundleStartTiming> timings(privates.size());
+        RunConcurrently(privates.size(),
+                        [&](std::size_t i)
+                        {
+                            auto const start = std::chrono::steady_clock::now();
+                            privates[i]->PreloadLibrary();
+                            timings[i].loadDuration = std::chrono::steady_clock::now() - start;
+                        });
+
+        std::exception_ptr exception;
+        for (std::size_t i = 0; i < privates.size(); ++i)
+        {
+            auto& timing = timings[i];
+            timing.bundleId = privates[i]->id;
+            timing.symbolicName = privates[i]->symbolicName;
+            auto const start = std::chrono::steady_clock::now();
+            try
+            {
+                privates[i]->Start(0);
+            }
+            catch (...)
+            {
+                timing.exception = std::current_exception();
+                if (!exception)
+                {
+                    exception = timing.exception;
+                }
+            }
+            timing.startDuration = std::chrono::steady_clock::now() - start;
+        }
+
+        if (report)
+        {
+            report->starts.insert(report->starts.end(),
+                                  std::make_move_iterator(timings.begin()),
+                                  std::make_move_iterator(timings.end()));
+        }
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
 } // namespace cppmicroservices
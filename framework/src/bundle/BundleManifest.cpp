@@ -24,8 +24,10 @@
 
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
-#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/reader.h>
 
+#include <iterator>
+#include <limits>
 #include <stdexcept>
 #include <typeinfo>
 
@@ -161,47 +163,256 @@ namespace cppmicroservices
             }
         }
 
+        /**
+         * SAX handler which converts the scalar members of the root object the
+         * same way as ParseJsonValue, and records the JSON text of object and
+         * array members instead of parsing them.
+         */
+        class TopLevelHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, TopLevelHandler>
+        {
+          public:
+            TopLevelHandler(rapidjson::StringStream const& stream, AnyMap& headers, AnyMap& deferredHeaders)
+                : m_Stream(stream)
+                , m_Headers(headers)
+                , m_DeferredHeaders(deferredHeaders)
+            {
+            }
+
+            bool
+            IsRootObject() const
+            {
+                return m_IsRootObject;
+            }
+
+            bool
+            Default()
+            {
+                return CheckRoot();
+            }
+
+            bool
+            Bool(bool b)
+            {
+                return AddValue(Any(b));
+            }
+
+            bool
+            Int(int i)
+            {
+                return AddValue(Any(i));
+            }
+
+            bool
+            Uint(unsigned u)
+            {
+                // Only values which fit into an int are kept, like in ParseJsonValue
+                if (u <= static_cast<unsigned>((std::numeric_limits<int>::max)()))
+                {
+                    return AddValue(Any(static_cast<int>(u)));
+                }
+                return CheckRoot();
+            }
+
+            bool
+            Double(double d)
+            {
+                return AddValue(Any(d));
+            }
+
+            bool
+            String(char const* str, rapidjson::SizeType length, bool)
+            {
+                // We do not support attribute localization yet, so we just
+                // always remove the leading '%' character.
+                if (length > 0 && str[0] == '%')
+                {
+                    ++str;
+                    --length;
+                }
+                return AddValue(Any(std::string(str, length)));
+            }
+
+            bool
+            Key(char const* str, rapidjson::SizeType length, bool)
+            {
+                if (1 == m_Depth)
+                {
+                    m_Key.assign(str, length);
+                }
+                return true;
+            }
+
+            bool
+            StartObject()
+            {
+                return Start();
+            }
+
+            bool
+            EndObject(rapidjson::SizeType)
+            {
+                return End();
+            }
+
+            bool
+            StartArray()
+            {
+                return (0 == m_Depth) ? CheckRoot() : Start();
+            }
+
+            bool
+            EndArray(rapidjson::SizeType)
+            {
+                return End();
+            }
+
+          private:
+            bool
+            CheckRoot()
+            {
+                m_IsRootObject = (0 != m_Depth);
+                return m_IsRootObject;
+            }
+
+            bool
+            AddValue(Any value)
+            {
+                if (1 == m_Depth && 0 == m_DeferredHeaders.count(m_Key))
+                {
+                    m_Headers.emplace(m_Key, std::move(value));
+                }
+                return CheckRoot();
+            }
+
+            bool
+            Start()
+            {
+                if (1 == m_Depth)
+                {
+                    // the opening bracket was already consumed
+                    m_ValueBegin = m_Stream.Tell() - 1;
+                }
+                ++m_Depth;
+                return true;
+            }
+
+            bool
+            End()
+            {
+                if (1 == --m_Depth && 0 == m_Headers.count(m_Key))
+                {
+                    auto const* json = m_Stream.head_ + m_ValueBegin;
+                    m_DeferredHeaders.emplace(m_Key, std::string(json, m_Stream.Tell() - m_ValueBegin));
+                }
+                return true;
+            }
+
+            rapidjson::StringStream const& m_Stream;
+            AnyMap& m_Headers;
+            AnyMap& m_DeferredHeaders;
+            std::string m_Key;
+            std::size_t m_ValueBegin = 0;
+            int m_Depth = 0;
+            bool m_IsRootObject = true;
+        };
+
     } // namespace
 
-    BundleManifest::BundleManifest() : m_Headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS) {}
+    BundleManifest::BundleManifest()
+        : m_Headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+        , m_DeferredHeaders(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+        , m_HeadersComplete(true)
+    {
+    }
 
-    BundleManifest::BundleManifest(AnyMap const& m) : m_Headers(m) {}
+    BundleManifest::BundleManifest(AnyMap const& m)
+        : m_Headers(m)
+        , m_DeferredHeaders(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+        , m_HeadersComplete(true)
+    {
+    }
 
     void
     BundleManifest::Parse(std::istream& is)
     {
-        rapidjson::IStreamWrapper jsonStream(is);
-        rapidjson::Document root;
-        if (root.ParseStream(jsonStream).HasParseError())
-        {
-            throw std::runtime_error(rapidjson::GetParseError_En(root.GetParseError()));
-        }
-
-        if (!root.IsObject())
+        std::string const json { std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+        rapidjson::StringStream jsonStream(json.c_str());
+        TopLevelHandler handler(jsonStream, m_Headers, m_DeferredHeaders);
+        rapidjson::Reader reader;
+        if (reader.Parse(jsonStream, handler).IsError())
         {
-            throw std::runtime_error("The Json root element must be an object.");
+            if (!handler.IsRootObject())
+            {
+                throw std::runtime_error("The Json root element must be an object.");
+            }
+            throw std::runtime_error(rapidjson::GetParseError_En(reader.GetParseErrorCode()));
         }
-
-        ParseJsonObject(root, m_Headers);
+        m_HeadersComplete = m_DeferredHeaders.empty();
     }
 
     AnyMap const&
     BundleManifest::GetHeaders() const
     {
+        if (!m_HeadersComplete)
+        {
+            std::lock_guard<std::mutex> lock(m_HeadersMutex);
+            if (!m_HeadersComplete)
+            {
+                for (auto const& deferred : m_DeferredHeaders)
+                {
+                    rapidjson::Document value;
+                    value.Parse(ref_any_cast<std::string>(deferred.second).c_str());
+                    m_Headers.emplace(deferred.first, ParseJsonValue(value, true));
+                }
+                m_DeferredHeaders = AnyMap(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+                m_HeadersComplete = true;
+            }
+        }
         return m_Headers;
     }
 
+    bool
+    BundleManifest::Empty() const
+    {
+        if (m_HeadersComplete)
+        {
+            return m_Headers.empty();
+        }
+        std::lock_guard<std::mutex> lock(m_HeadersMutex);
+        return m_Headers.empty() && m_DeferredHeaders.empty();
+    }
+
     bool
     BundleManifest::Contains(std::string const& key) const
     {
-        return m_Headers.count(key) > 0;
+        if (m_HeadersComplete)
+        {
+            return m_Headers.count(key) > 0;
+        }
+        std::lock_guard<std::mutex> lock(m_HeadersMutex);
+        return m_Headers.count(key) > 0 || m_DeferredHeaders.count(key) > 0;
     }
 
     Any
     BundleManifest::GetValue(std::string const& key) const
     {
-        auto iter = m_Headers.find(key);
-        if (m_Headers.cend() != iter)
+        if (!m_HeadersComplete)
+        {
+            std::lock_guard<std::mutex> lock(m_HeadersMutex);
+            auto iter = m_Headers.find(key);
+            if (m_Headers.cend() != iter)
+            {
+                return iter->second;
+            }
+            if (m_DeferredHeaders.count(key) == 0)
+            {
+                return Any();
+            }
+        }
+
+        auto const& headers = GetHeaders();
+        auto iter = headers.find(key);
+        if (headers.cend() != iter)
         {
             return iter->second;
         }
@@ -212,7 +423,7 @@ namespace cppmicroservices
     BundleManifest::CopyDeprecatedProperties() const
     {
         std::call_once(m_DidCopyDeprecatedProperties,
-                       [&]() { copy_deprecated_properties(m_Headers, m_PropertiesDeprecated); });
+                       [&]() { copy_deprecated_properties(GetHeaders(), m_PropertiesDeprecated); });
     }
 
     Any
@@ -25,6 +25,7 @@
 
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/AnyMap.h"
+#include <atomic>
 #include <mutex>
 
 namespace cppmicroservices
@@ -37,10 +38,18 @@ namespace cppmicroservices
         BundleManifest();
         explicit BundleManifest(AnyMap const& m);
 
+        /**
+         * Parses the top-level values of the manifest. Object and array values,
+         * e.g. the component descriptions of extenders, are kept as raw JSON
+         * text until the full headers are requested.
+         */
         void Parse(std::istream& is);
 
+        /// Returns all headers. Materializes the deferred values on first use.
         AnyMap const& GetHeaders() const;
 
+        bool Empty() const;
+
         bool Contains(std::string const& key) const;
         Any GetValue(std::string const& key) const;
 
@@ -55,7 +64,17 @@ namespace cppmicroservices
         // GetPropertiesDeprecated() is called.
         mutable std::map<std::string, Any> m_PropertiesDeprecated;
         mutable std::once_flag m_DidCopyDeprecatedProperties;
-        AnyMap m_Headers;
+        // The headers parsed so far. The deferred headers are added once, after
+        // which m_Headers is not modified anymore.
+        mutable AnyMap m_Headers;
+
+        // Top-level object and array values which have not been parsed yet,
+        // as raw JSON text. Released once they are parsed.
+        mutable AnyMap m_DeferredHeaders;
+        // true if m_DeferredHeaders is empty and m_Headers is complete
+        mutable std::atomic<bool> m_HeadersComplete;
+        // guards m_Headers and m_DeferredHeaders until m_HeadersComplete is set
+        mutable std::mutex m_HeadersMutex;
 
         /** copies m_Headers to m_PropertiesDeprecated exactly once per BundleManifest using
          * std::call_once. Needs to be a const method because it's called from other const
@@ -0,0 +1,171 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "BundleMetadataCache.h"
+
+#include "cppmicroservices/Any.h"
+#include "cppmicroservices/util/BinaryEncoding.h"
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+
+namespace cppmicroservices
+{
+
+    namespace
+    {
+        // "UBMC" in little-endian byte order
+        constexpr uint32_t CACHE_MAGIC = 0x434d4255;
+        // Increment when changing the file layout
+        constexpr uint32_t CACHE_VERSION = 2;
+
+        void
+        WriteKey(util::BinaryWriter& writer, BundleMetadataCache::Key const& key)
+        {
+            writer.WriteUInt(key.size, 8);
+            writer.WriteUInt(static_cast<uint64_t>(key.modified), 8);
+            writer.WriteUInt(key.inode, 8);
+        }
+
+        bool
+        ReadKey(util::BinaryReader& reader, BundleMetadataCache::Key const& key)
+        {
+            auto const size = reader.ReadUInt(8);
+            auto const modified = static_cast<int64_t>(reader.ReadUInt(8));
+            auto const inode = reader.ReadUInt(8);
+            return size == key.size && modified == key.modified && inode == key.inode;
+        }
+    } // namespace
+
+    BundleMetadataCache::BundleMetadataCache(std::string cacheDir) : cacheDir(std::move(cacheDir)) {}
+
+    bool
+    BundleMetadataCache::GetKey(std::string const& location, Key& key) const
+    {
+        try
+        {
+            return util::GetFileStatus(location, key);
+        }
+        catch (std::exception const&)
+        {
+            return false;
+        }
+    }
+
+    AnyMap
+    BundleMetadataCache::Load(std::string const& location, Key const& key) const
+    {
+        AnyMap manifests(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+
+        std::ifstream file(GetCacheFile(location), std::ifstream::binary);
+        if (!file)
+        {
+            return manifests;
+        }
+        std::string const content { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+        try
+        {
+            util::BinaryReader reader(content.data(), content.size());
+            if (reader.ReadUInt(4) != CACHE_MAGIC || reader.ReadUInt(4) != CACHE_VERSION
+                || reader.ReadString() != location || !ReadKey(reader, key))
+            {
+                return manifests;
+            }
+
+            auto cached = reader.ReadMap();
+            if (reader.AtEnd())
+            {
+                manifests = std::move(cached);
+            }
+        }
+        catch (std::exception const&)
+        {
+            // a truncated or otherwise invalid cache file, ignore it
+        }
+        return manifests;
+    }
+
+    void
+    BundleMetadataCache::Store(std::string const& location, Key const& key, AnyMap const& manifests) const
+    {
+        try
+        {
+            util::BinaryWriter writer;
+            writer.WriteUInt(CACHE_MAGIC, 4);
+            writer.WriteUInt(CACHE_VERSION, 4);
+            writer.WriteString(location);
+            WriteKey(writer, key);
+            writer.WriteMap(manifests);
+
+            // Do not associate the manifests with a file which changed while
+            // they were read.
+            Key current;
+            if (!GetKey(location, current) || current.size != key.size || current.modified != key.modified
+                || current.inode != key.inode)
+            {
+                return;
+            }
+
+            // Write a temporary file and rename it, so that concurrent readers
+            // never see a partially written cache file.
+            auto const cacheFile = GetCacheFile(location);
+            auto const tmpFile
+                = cacheFile + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+            {
+                std::ofstream file(tmpFile, std::ofstream::binary | std::ofstream::trunc);
+                if (!file.write(writer.buffer.data(), static_cast<std::streamsize>(writer.buffer.size())))
+                {
+                    file.close();
+                    std::remove(tmpFile.c_str());
+                    return;
+                }
+            }
+#ifdef US_PLATFORM_WINDOWS
+            std::remove(cacheFile.c_str());
+#endif
+            if (std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0)
+            {
+                std::remove(tmpFile.c_str());
+            }
+        }
+        catch (std::exception const&)
+        {
+            // the manifests are parsed again next time
+        }
+    }
+
+    std::string
+    BundleMetadataCache::GetCacheFile(std::string const& location) const
+    {
+        // the location is stored in the file to detect collisions
+        auto const hash = util::Fnv1a64(location);
+
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+        return cacheDir + util::DIR_SEP + name + ".cache";
+    }
+} // namespace cppmicroservices
@@ -0,0 +1,81 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLEMETADATACACHE_H
+#define CPPMICROSERVICES_BUNDLEMETADATACACHE_H
+
+#include "cppmicroservices/AnyMap.h"
+#include "cppmicroservices/util/FileSystem.h"
+
+#include <string>
+
+namespace cppmicroservices
+{
+
+    /**
+     * On-disk cache of the parsed manifests of the bundles at a location,
+     * see Constants::FRAMEWORK_BUNDLE_METADATA_CACHE.
+     *
+     * Each location has its own cache file in a compact binary format. An
+     * entry is only used while the size, modification time and inode of
+     * the bundle file are unchanged. The manifests are keyed by the top-level
+     * directories of the bundle's zip archive, which makes them suitable for
+     * installing the bundles with an injected manifest.
+     */
+    class BundleMetadataCache
+    {
+      public:
+        using Key = util::FileStatus;
+
+        explicit BundleMetadataCache(std::string cacheDir);
+
+        BundleMetadataCache(BundleMetadataCache const&) = delete;
+        BundleMetadataCache& operator=(BundleMetadataCache const&) = delete;
+
+        /**
+         * Get the key identifying the current content of the bundle file at
+         * location. Returns false if the file cannot be accessed.
+         */
+        bool GetKey(std::string const& location, Key& key) const;
+
+        /**
+         * Read the cached manifests for location. Returns an empty map if
+         * there is no valid entry for key.
+         */
+        AnyMap Load(std::string const& location, Key const& key) const;
+
+        /**
+         * Write the manifests for location. Nothing is written if the bundle
+         * file was changed since key was taken or if a manifest contains a
+         * value which cannot be cached. Errors are not reported, a missing
+         * entry only means the manifests are parsed again.
+         */
+        void Store(std::string const& location, Key const& key, AnyMap const& manifests) const;
+
+      private:
+        std::string GetCacheFile(std::string const& location) const;
+
+        std::string const cacheDir;
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_BUNDLEMETADATACACHE_H
@@ -36,6 +36,7 @@
 #include "cppmicroservices/SecurityException.h"
 #include "cppmicroservices/ServiceRegistration.h"
 #include "cppmicroservices/SharedLibraryException.h"
+#include "cppmicroservices/Trace.h"
 
 #include "cppmicroservices/util/Error.h"
 #include "cppmicroservices/util/FileSystem.h"
@@ -234,6 +235,7 @@ namespace cppmicroservices
         }
 
         state = Bundle::STATE_INSTALLED;
+        preValidated = false;
         if (sendEvent)
         {
             operation = OP_UNRESOLVING;
@@ -375,6 +377,7 @@ namespace cppmicroservices
                         { BundleEvent::BUNDLE_UNRESOLVED, MakeBundle(shared_from_this()) });
                     bactivator = nullptr;
                     state = Bundle::STATE_UNINSTALLED;
+                    preValidated = false;
 
                     Purge();
                     barchive->SetLastModified(std::chrono::steady_clock::now());
@@ -446,6 +449,8 @@ namespace cppmicroservices
     std::exception_ptr
     BundlePrivate::Start0()
     {
+        detail::TraceSpan span("BundlePrivate::Start0", symbolicName);
+
         // res is used to signal that start did not complete in a normal way
         std::exception_ptr res;
         auto const thisBundle = MakeBundle(this->shared_from_this());
@@ -481,11 +486,12 @@ namespace cppmicroservices
         // Activator in the bundle is not called if 'bundle.activator' property
         // either does not exist or is set to false. If the property is set to true,
         // the actiavtor inside the bundle is called.
+        bool const validated = preValidated.exchange(false);
         if (useActivator)
         {
             try
             {
-                if (coreCtx->validationFunc && (lib.GetFilePath() != util::GetExecutablePath())
+                if (coreCtx->validationFunc && !validated && (lib.GetFilePath() != util::GetExecutablePath())
                     && !coreCtx->validationFunc(thisBundle))
                 {
                     StartFailed();
@@ -561,6 +567,7 @@ namespace cppmicroservices
                 // get a BundleActivator instance
                 bactivator = std::unique_ptr<BundleActivator, DestroyActivatorHook>(createActivatorHook(),
                                                                                     destroyActivatorHook);
+                detail::TraceSpan activatorSpan("BundleActivator::Start", symbolicName);
                 bactivator->Start(MakeBundleContext(ctx));
             }
             catch (std::system_error const& ex)
@@ -643,6 +650,63 @@ namespace cppmicroservices
         return res;
     }
 
+    void
+    BundlePrivate::PreloadLibrary()
+    {
+        // Start() loads the library while holding the bundle lock, as do the
+        // state changes which invalidate the validation result
+        auto const canPreload = [this]()
+        {
+            return (state & (Bundle::STATE_INSTALLED | Bundle::STATE_RESOLVED)) != 0 && !lib.IsLoaded()
+                   && lib.GetFilePath() != util::GetExecutablePath();
+        };
+
+        {
+            auto l = this->Lock();
+            US_UNUSED(l);
+            if (!canPreload())
+            {
+                return;
+            }
+        }
+
+        auto const activatorVal = bundleManifest.GetValue(Constants::BUNDLE_ACTIVATOR);
+        if (activatorVal.Type() != typeid(bool) || !any_cast<bool>(activatorVal))
+        {
+            return;
+        }
+
+        try
+        {
+            // the validation function is user code, so it is called without holding
+            // the bundle lock
+            bool const validated
+                = coreCtx->validationFunc && coreCtx->validationFunc(MakeBundle(this->shared_from_this()));
+            if (coreCtx->validationFunc && !validated)
+            {
+                return;
+            }
+
+            auto l = this->Lock();
+            US_UNUSED(l);
+            if (!canPreload())
+            {
+                return;
+            }
+            preValidated = validated;
+
+            coreCtx->logger->Log(logservice::SeverityLevel::LOG_INFO,
+                                 "Preloading shared library for Bundle #" + util::ToString(id) + " (location="
+                                     + location + ")");
+            lib.Load(coreCtx->libraryLoadOptions);
+        }
+        catch (...)
+        {
+            // Start0() validates and loads the bundle again and reports the failure
+            preValidated = false;
+        }
+    }
+
     void
     BundlePrivate::StartFailed()
     {
@@ -706,7 +770,7 @@ namespace cppmicroservices
     {
         // Only take the time to read the manifest out of the BundleArchive file if we don't already have
         // a manifest.
-        if (true == bundleManifest.GetHeaders().empty())
+        if (true == bundleManifest.Empty())
         {
             // Check if the bundle provides a manifest.json file and if yes, parse it.
             if (ba->IsValid())
@@ -717,6 +781,7 @@ namespace cppmicroservices
                     BundleResourceStream manifestStream(manifestRes);
                     try
                     {
+                        detail::TraceSpan span("BundleManifest::Parse", location);
                         bundleManifest.Parse(manifestStream);
                     }
                     catch (...)
@@ -733,6 +798,11 @@ namespace cppmicroservices
                     {
                         ba->GetResourceContainer()->CloseContainer();
                     }
+                    else
+                    {
+                        // Resources are usually accessed much later, if at all.
+                        ba->GetResourceContainer()->ReleaseMappedPages();
+                    }
                 }
             }
         }
@@ -158,6 +158,16 @@ namespace cppmicroservices
          */
         std::exception_ptr Start0();
 
+        /**
+         * Validate the bundle and load its shared library ahead of Start(),
+         * so that this can be done for several bundles concurrently. Does
+         * nothing if the bundle has no activator, is not installed or resolved,
+         * or its library is already loaded. Failures are left to Start() to report.
+         *
+         * The validation function is called without holding the bundle lock.
+         */
+        void PreloadLibrary();
+
         void StartFailed();
 
         /**
@@ -268,6 +278,11 @@ namespace cppmicroservices
          */
         SharedLibrary lib;
 
+        // Set by PreloadLibrary() if the bundle passed validation, so that
+        // the next Start0() does not validate it again. Cleared when the bundle
+        // is uninstalled or goes back to the installed state.
+        std::atomic<bool> preValidated { false };
+
         using SetBundleContextHook = std::function<void(BundleContextPrivate*)>;
         SetBundleContextHook SetBundleContext;
     };
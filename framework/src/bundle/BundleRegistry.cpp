@@ -25,18 +25,23 @@
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/BundleActivator.h"
 #include "cppmicroservices/BundleEvent.h"
+#include "cppmicroservices/Constants.h"
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/GetBundleContext.h"
+#include "cppmicroservices/Trace.h"
 
+#include "cppmicroservices/detail/Log.h"
 #include "cppmicroservices/util/Error.h"
 #include "cppmicroservices/util/String.h"
 
 #include "BundleContextPrivate.h"
+#include "BundleMetadataCache.h"
 #include "BundlePrivate.h"
 #include "BundleResourceContainer.h"
 #include "BundleStorage.h"
 #include "CoreBundleContext.h"
 #include "FrameworkPrivate.h"
+#include "Utils.h"
 
 #include <cassert>
 #include <deque>
@@ -70,14 +75,36 @@ namespace cppmicroservices
     BundleRegistry::Init()
     {
         bundles.v.insert(std::make_pair(coreCtx->systemBundle->location, coreCtx->systemBundle));
+
+        auto cacheProp = coreCtx->frameworkProperties.find(Constants::FRAMEWORK_BUNDLE_METADATA_CACHE);
+        if (cacheProp != coreCtx->frameworkProperties.end() && cacheProp->second.Type() == typeid(bool)
+            && any_cast<bool>(cacheProp->second))
+        {
+            std::string cacheDir;
+            try
+            {
+                cacheDir = GetPersistentStoragePath(coreCtx, "cache", /*create=*/true);
+            }
+            catch (std::exception const& e)
+            {
+                DIAG_LOG(*coreCtx->sink) << "Bundle metadata cache disabled: " << e.what();
+            }
+            if (!cacheDir.empty())
+            {
+                metadataCache.Lock(), metadataCache.v = std::make_shared<BundleMetadataCache>(cacheDir);
+            }
+        }
     }
 
     void
     BundleRegistry::Clear()
     {
-        auto l = bundles.Lock();
-        US_UNUSED(l);
-        bundles.v.clear();
+        {
+            auto l = bundles.Lock();
+            US_UNUSED(l);
+            bundles.v.clear();
+        }
+        metadataCache.Lock(), metadataCache.v.reset();
     }
 
     /*
@@ -139,7 +166,67 @@ namespace cppmicroservices
     }
 
     std::vector<Bundle>
-    BundleRegistry::Install(std::string const& location, BundlePrivate*, cppmicroservices::AnyMap const& bundleManifest)
+    BundleRegistry::Install(std::string const& location,
+                            BundlePrivate* caller,
+                            cppmicroservices::AnyMap const& bundleManifest)
+    {
+        auto cache = (metadataCache.Lock(), metadataCache.v);
+        BundleMetadataCache::Key key;
+        if (!cache || !bundleManifest.empty() || !cache->GetKey(location, key))
+        {
+            return Install1(location, caller, bundleManifest);
+        }
+
+        // Install unchanged bundles with their cached manifests. The resource
+        // container is then only opened when a resource is accessed.
+        auto const cachedManifest = cache->Load(location, key);
+        if (!cachedManifest.empty())
+        {
+            return Install1(location, caller, cachedManifest);
+        }
+
+        auto installedBundles = Install1(location, caller, bundleManifest);
+        StoreMetadata(*cache, location, key, installedBundles);
+        return installedBundles;
+    }
+
+    void
+    BundleRegistry::StoreMetadata(BundleMetadataCache const& cache,
+                                  std::string const& location,
+                                  BundleMetadataCache::Key const& key,
+                                  std::vector<Bundle> const& installedBundles) const
+    {
+        if (installedBundles.empty())
+        {
+            return;
+        }
+
+        // Only cache complete results. The bundles installed by an earlier
+        // call are missing if some of the bundles at location were already
+        // installed.
+        auto const toplevelDirs = installedBundles.front().d->barchive->GetResourceContainer()->GetTopLevelDirs();
+        AnyMap manifests(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        for (auto const& b : installedBundles)
+        {
+            manifests.emplace(b.d->symbolicName, b.d->bundleManifest.GetHeaders());
+        }
+        for (auto const& dir : toplevelDirs)
+        {
+            if (manifests.count(dir) == 0)
+            {
+                return;
+            }
+        }
+        if (manifests.size() != toplevelDirs.size())
+        {
+            return;
+        }
+
+        cache.Store(location, key, manifests);
+    }
+
+    std::vector<Bundle>
+    BundleRegistry::Install1(std::string const& location, BundlePrivate*, cppmicroservices::AnyMap const& bundleManifest)
     {
         using namespace std::chrono_literals;
 
@@ -307,6 +394,8 @@ namespace cppmicroservices
         using cppms::any_map;
         using cppms::AnyMap;
 
+        detail::TraceSpan span("BundleRegistry::Install0", location);
+
         std::vector<Bundle> installedBundles;
         std::vector<std::shared_ptr<BundleArchive>> barchives;
         std::unordered_set<std::string> exclude { alreadyInstalled.begin(), alreadyInstalled.end() };
@@ -32,6 +32,7 @@
 #include <string>
 #include <vector>
 
+#include "BundleMetadataCache.h"
 #include "BundleResourceContainer.h"
 
 namespace cppmicroservices
@@ -136,6 +137,10 @@ namespace cppmicroservices
         BundleRegistry(BundleRegistry const&) = delete;
         BundleRegistry& operator=(BundleRegistry const&) = delete;
 
+        std::vector<Bundle> Install1(std::string const& location,
+                                     BundlePrivate* caller,
+                                     cppmicroservices::AnyMap const& bundleManifest);
+
         std::vector<Bundle> Install0(std::string const& location,
                                      std::shared_ptr<BundleResourceContainer> const& resCont,
                                      std::vector<std::string> const& alreadyInstalled,
@@ -143,6 +148,15 @@ namespace cppmicroservices
 
         void CheckIllegalState() const;
 
+        /**
+         * Write the manifests of the bundles installed from location to the
+         * metadata cache, if they are all the bundles at that location.
+         */
+        void StoreMetadata(BundleMetadataCache const& cache,
+                           std::string const& location,
+                           BundleMetadataCache::Key const& key,
+                           std::vector<Bundle> const& installedBundles) const;
+
         /** This function populates the res and alreadyInstalled vectors with the appropriate entries so
          * that they can be used by the Install0 call. This was extracted from Install() for convenience.
          *
@@ -195,6 +209,12 @@ namespace cppmicroservices
         {
             BundleMap v;
         } bundles;
+
+        // Set if Constants::FRAMEWORK_BUNDLE_METADATA_CACHE is enabled
+        struct : MultiThreaded<>
+        {
+            std::shared_ptr<BundleMetadataCache> v;
+        } metadataCache;
     };
 } // namespace cppmicroservices
 
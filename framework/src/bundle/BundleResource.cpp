@@ -27,6 +27,7 @@
 
 #include "BundleArchive.h"
 #include "BundleResourceContainer.h"
+#include "BundleResourceInflater.h"
 
 #include <atomic>
 #include <string>
@@ -299,6 +300,35 @@ namespace cppmicroservices
         return data;
     }
 
+    std::shared_ptr<void const>
+    BundleResource::GetSharedData() const
+    {
+        if (!IsValid())
+        {
+            return nullptr;
+        }
+
+        auto data = d->archive->GetResourceContainer()->GetSharedData(d->stat.index);
+        if (!data)
+        {
+            auto sink = GetBundleContext().GetLogSink();
+            DIAG_LOG(*sink) << "Error uncompressing resource data for " << this->GetResourcePath() << " from "
+                            << d->archive->GetBundleLocation();
+        }
+
+        return data;
+    }
+
+    std::unique_ptr<BundleResourceInflater>
+    BundleResource::GetInflater() const
+    {
+        if (!IsValid() || IsDir())
+        {
+            return nullptr;
+        }
+        return d->archive->GetResourceContainer()->GetInflater(d->stat.index);
+    }
+
     std::ostream&
     operator<<(std::ostream& os, BundleResource const& resource)
     {
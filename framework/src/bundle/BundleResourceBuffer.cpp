@@ -22,6 +22,10 @@
 
 #include "cppmicroservices/detail/BundleResourceBuffer.h"
 
+#include "cppmicroservices/BundleResource.h"
+
+#include "BundleResourceInflater.h"
+
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
@@ -45,7 +49,7 @@ namespace cppmicroservices
         class BundleResourceBufferPrivate
         {
           public:
-            BundleResourceBufferPrivate(std::unique_ptr<void, void (*)(void*)> data,
+            BundleResourceBufferPrivate(std::shared_ptr<void const> data,
                                         std::size_t size,
                                         char const* begin,
                                         std::ios_base::openmode mode)
@@ -53,7 +57,7 @@ namespace cppmicroservices
                 , end(begin + size)
                 , current(begin)
                 , mode(mode)
-                , uncompressedData(reinterpret_cast<unsigned char*>(data.release()), data.get_deleter())
+                , data(std::move(data))
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
                 , pos(0)
 #endif
@@ -66,7 +70,13 @@ namespace cppmicroservices
 
             const std::ios_base::openmode mode;
 
-            std::unique_ptr<unsigned char, void (*)(void*)> uncompressedData;
+            // either uncompressed data or a memory mapped bundle
+            std::shared_ptr<void const> data;
+
+            // Set instead of data if the resource is inflated incrementally. The
+            // get area then holds the current block, which starts at windowStart.
+            std::unique_ptr<BundleResourceInflater> inflater;
+            std::streamoff windowStart = 0;
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
             // records the stream position ignoring CR characters
@@ -74,32 +84,75 @@ namespace cppmicroservices
 #endif
         };
 
-        BundleResourceBuffer::BundleResourceBuffer(std::unique_ptr<void, void (*)(void*)> data,
-                                                   std::size_t _size,
-                                                   std::ios_base::openmode mode)
-            : d(nullptr)
+        namespace
         {
-            assert(_size < static_cast<std::size_t>(std::numeric_limits<uint32_t>::max()));
+            std::shared_ptr<void const>
+            ToShared(std::unique_ptr<void, void (*)(void*)> data)
+            {
+                auto deleter = data.get_deleter();
+                return std::shared_ptr<void const>(data.release(), deleter);
+            }
 
-            auto* begin = reinterpret_cast<char*>(data.get());
-            std::size_t size = begin ? _size : 0;
+            std::unique_ptr<BundleResourceBufferPrivate>
+            MakePrivate(std::shared_ptr<void const> data, std::size_t _size, std::ios_base::openmode mode)
+            {
+                assert(_size < static_cast<std::size_t>(std::numeric_limits<uint32_t>::max()));
+
+                auto const* begin = static_cast<char const*>(data.get());
+                std::size_t size = begin ? _size : 0;
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
-            if (begin != nullptr && !(mode & std::ios_base::binary) && begin[0] == '\r')
-            {
-                ++begin;
-                --size;
-            }
+                if (begin != nullptr && !(mode & std::ios_base::binary) && begin[0] == '\r')
+                {
+                    ++begin;
+                    --size;
+                }
 #endif
 
 #ifdef REMOVE_LAST_NEWLINE_IN_TEXT_MODE
-            if (begin != nullptr && !(mode & std::ios_base::binary) && begin[size - 1] == '\n')
+                if (begin != nullptr && !(mode & std::ios_base::binary) && begin[size - 1] == '\n')
+                {
+                    --size;
+                }
+#endif
+
+                return std::make_unique<BundleResourceBufferPrivate>(std::move(data), size, begin, mode);
+            }
+        } // namespace
+
+        BundleResourceBuffer::BundleResourceBuffer(std::unique_ptr<void, void (*)(void*)> data,
+                                                   std::size_t size,
+                                                   std::ios_base::openmode mode)
+            : BundleResourceBuffer(ToShared(std::move(data)), size, mode)
+        {
+        }
+
+        BundleResourceBuffer::BundleResourceBuffer(std::shared_ptr<void const> data,
+                                                   std::size_t size,
+                                                   std::ios_base::openmode mode)
+            : d(MakePrivate(std::move(data), size, mode))
+        {
+        }
+
+        BundleResourceBuffer::BundleResourceBuffer(BundleResource const& resource, std::ios_base::openmode mode)
+            : d(nullptr)
+        {
+            // The newline conversions of text mode need the complete data
+            std::unique_ptr<BundleResourceInflater> inflater;
+            if (mode & std::ios_base::binary)
             {
-                --size;
+                inflater = resource.GetInflater();
             }
-#endif
 
-            d = std::make_unique<BundleResourceBufferPrivate>(std::move(data), size, begin, mode);
+            if (inflater)
+            {
+                d = std::make_unique<BundleResourceBufferPrivate>(nullptr, 0, nullptr, mode);
+                d->inflater = std::move(inflater);
+            }
+            else
+            {
+                d = MakePrivate(resource.GetSharedData(), resource.GetSize(), mode);
+            }
         }
 
         BundleResourceBuffer::~BundleResourceBuffer() = default;
@@ -107,6 +160,11 @@ namespace cppmicroservices
         BundleResourceBuffer::int_type
         BundleResourceBuffer::underflow()
         {
+            if (d->inflater)
+            {
+                return InflatingUnderflow();
+            }
+
             if (d->current == d->end)
                 return traits_type::eof();
 
@@ -132,6 +190,12 @@ namespace cppmicroservices
         BundleResourceBuffer::int_type
         BundleResourceBuffer::uflow()
         {
+            if (d->inflater)
+            {
+                // consumes from the get area, calling underflow() when it is empty
+                return std::streambuf::uflow();
+            }
+
             if (d->current == d->end)
                 return traits_type::eof();
 
@@ -157,6 +221,24 @@ namespace cppmicroservices
         BundleResourceBuffer::int_type
         BundleResourceBuffer::pbackfail(int_type ch)
         {
+            if (d->inflater)
+            {
+                // Within the get area, only a mismatching character ends up here.
+                // At its beginning, step back into the previous block.
+                auto const pos = d->windowStart;
+                if (gptr() != eback() || pos == 0)
+                {
+                    return traits_type::eof();
+                }
+                InflatingSeek(pos - 1);
+                if (ch != traits_type::eof() && !traits_type::eq_int_type(ch, traits_type::to_int_type(*gptr())))
+                {
+                    InflatingSeek(pos);
+                    return traits_type::eof();
+                }
+                return traits_type::to_int_type(*gptr());
+            }
+
             int backOffset = -1;
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
             if (!(d->mode & std::ios_base::binary))
@@ -180,6 +262,12 @@ namespace cppmicroservices
         std::streamsize
         BundleResourceBuffer::showmanyc()
         {
+            if (d->inflater)
+            {
+                return static_cast<std::streamsize>(d->inflater->GetSize())
+                       - (d->windowStart + (gptr() - eback()));
+            }
+
             assert(d->current <= d->end);
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
@@ -203,6 +291,20 @@ namespace cppmicroservices
                                       std::ios_base::seekdir way,
                                       std::ios_base::openmode /*which*/)
         {
+            if (d->inflater)
+            {
+                std::streambuf::off_type base = 0;
+                if (way == std::ios_base::cur)
+                {
+                    base = d->windowStart + (gptr() - eback());
+                }
+                else if (way == std::ios_base::end)
+                {
+                    base = static_cast<std::streambuf::off_type>(d->inflater->GetSize());
+                }
+                return InflatingSeek(base + off);
+            }
+
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
             std::streambuf::off_type step = 1;
             if (way == std::ios_base::beg)
@@ -287,6 +389,56 @@ namespace cppmicroservices
             return this->seekoff(sp, std::ios_base::beg);
         }
 
+        BundleResourceBuffer::int_type
+        BundleResourceBuffer::InflatingUnderflow()
+        {
+            if (gptr() == egptr())
+            {
+                d->windowStart += egptr() - eback();
+                auto const block = d->inflater->Next();
+                // The get area is never written to
+                auto* data = const_cast<char*>(block.data);
+                setg(data, data, data + block.size);
+                if (block.size == 0)
+                {
+                    return traits_type::eof();
+                }
+            }
+            return traits_type::to_int_type(*gptr());
+        }
+
+        std::streambuf::pos_type
+        BundleResourceBuffer::InflatingSeek(std::streambuf::off_type pos)
+        {
+            if (pos < 0 || pos > static_cast<std::streambuf::off_type>(d->inflater->GetSize()))
+            {
+                return std::streambuf::pos_type(std::streambuf::off_type(-1));
+            }
+
+            // Seeking backwards out of the current block inflates the data again
+            if (pos < d->windowStart)
+            {
+                d->inflater->Rewind();
+                d->windowStart = 0;
+                setg(nullptr, nullptr, nullptr);
+            }
+
+            for (;;)
+            {
+                auto const blockSize = egptr() - eback();
+                if (pos - d->windowStart <= blockSize)
+                {
+                    setg(eback(), eback() + (pos - d->windowStart), egptr());
+                    return pos;
+                }
+                setg(eback(), egptr(), egptr());
+                if (traits_type::eq_int_type(InflatingUnderflow(), traits_type::eof()))
+                {
+                    return std::streambuf::pos_type(std::streambuf::off_type(-1));
+                }
+            }
+        }
+
     } // namespace detail
 
 } // namespace cppmicroservices
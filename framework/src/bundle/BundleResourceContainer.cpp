@@ -21,25 +21,109 @@
 =============================================================================*/
 
 #include "BundleResourceContainer.h"
+#include "BundleResourceInflater.h"
 #include "cppmicroservices/util/BundleObjFactory.h"
 #include "cppmicroservices/util/BundleObjFile.h"
 #include "cppmicroservices/util/FileSystem.h"
+#if defined(US_PLATFORM_APPLE) || defined(US_PLATFORM_POSIX)
+#    include "cppmicroservices/util/MappedFile.h"
+#endif
 
 #include "cppmicroservices/BundleResource.h"
 #include "cppmicroservices/GetBundleContext.h"
+#include "cppmicroservices/Trace.h"
 #include "cppmicroservices/detail/Log.h"
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
 #include <cstring>
 #include <exception>
 #include <fstream>
-#include <sstream>
 #include <stdexcept>
 
 namespace cppmicroservices
 {
 
+    namespace
+    {
+        // See the zip file format specification (APPNOTE.TXT)
+        constexpr uint32_t LOCAL_HEADER_SIG = 0x04034b50;
+        constexpr std::size_t LOCAL_HEADER_SIZE = 30;
+        constexpr std::size_t LOCAL_HEADER_NAME_LEN_OFS = 26;
+        constexpr std::size_t LOCAL_HEADER_EXTRA_LEN_OFS = 28;
+        constexpr uint32_t CENTRAL_HEADER_SIG = 0x02014b50;
+        constexpr std::size_t CENTRAL_HEADER_SIZE = 46;
+        constexpr std::size_t CENTRAL_HEADER_NAME_LEN_OFS = 28;
+        constexpr std::size_t CENTRAL_HEADER_EXTRA_LEN_OFS = 30;
+        constexpr std::size_t CENTRAL_HEADER_COMMENT_LEN_OFS = 32;
+
+        inline uint32_t
+        ReadLE16(char const* p)
+        {
+            auto const* b = reinterpret_cast<unsigned char const*>(p);
+            return static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8);
+        }
+
+        inline uint32_t
+        ReadLE32(char const* p)
+        {
+            return ReadLE16(p) | (ReadLE16(p + 2) << 16);
+        }
+    } // namespace
+
+    std::string_view
+    BundleResourceContainer::EntryIndex::GetName(uint32_t index) const
+    {
+        auto const* header = centralDir + offsets[index];
+        return { header + CENTRAL_HEADER_SIZE, ReadLE16(header + CENTRAL_HEADER_NAME_LEN_OFS) };
+    }
+
+    uint32_t
+    BundleResourceContainer::EntryIndex::Find(std::string_view name) const
+    {
+        auto iter = std::lower_bound(sorted.begin(),
+                                     sorted.end(),
+                                     name,
+                                     [this](uint32_t entry, std::string_view n) { return GetName(entry) < n; });
+        if (iter == sorted.end() || GetName(*iter) != name)
+        {
+            return npos;
+        }
+        return static_cast<uint32_t>(iter - sorted.begin());
+    }
+
+    BundleResourceContainer::FilePattern::FilePattern(std::string const& pattern)
+    {
+        std::size_t begin = 0;
+        while (begin < pattern.size())
+        {
+            auto end = std::min(pattern.find('*', begin), pattern.size());
+            if (end > begin)
+            {
+                m_Literals.emplace_back(pattern, begin, end - begin);
+            }
+            begin = end + 1;
+        }
+    }
+
+    bool
+    BundleResourceContainer::FilePattern::Matches(std::string_view name) const
+    {
+        // The literal parts must occur in order, anywhere in the name
+        std::size_t pos = 0;
+        for (auto const& literal : m_Literals)
+        {
+            std::size_t index = name.find(literal, pos);
+            if (index == std::string_view::npos)
+            {
+                return false;
+            }
+            pos = index + literal.size();
+        }
+        return true;
+    }
+
     BundleResourceContainer::BundleResourceContainer(std::string const& location, ManifestT const& bundleManifest)
         : m_Location(location)
         , m_ZipArchive()
@@ -64,8 +148,9 @@ namespace cppmicroservices
             // zip info out.
             for (auto b : bundleManifest)
             {
-                m_SortedToplevelDirs.insert(b.first);
+                m_SortedToplevelDirs.push_back(b.first);
             }
+            std::sort(m_SortedToplevelDirs.begin(), m_SortedToplevelDirs.end());
         }
         else
         {
@@ -93,7 +178,7 @@ namespace cppmicroservices
     std::vector<std::string>
     BundleResourceContainer::GetTopLevelDirs() const
     {
-        return std::vector<std::string> { m_SortedToplevelDirs.begin(), m_SortedToplevelDirs.end() };
+        return m_SortedToplevelDirs;
     }
 
     bool
@@ -147,38 +232,113 @@ namespace cppmicroservices
         return { data, ::free };
     }
 
+    std::shared_ptr<void const>
+    BundleResourceContainer::GetSharedData(int index)
+    {
+        mz_zip_archive_file_stat zipStat;
+        if (auto entryData = GetMappedEntry(index, zipStat);
+            entryData && zipStat.m_method == 0 && zipStat.m_uncomp_size > 0
+            && zipStat.m_comp_size == zipStat.m_uncomp_size)
+        {
+            return entryData;
+        }
+
+        auto data = GetData(index);
+        auto deleter = data.get_deleter();
+        return std::shared_ptr<void const>(data.release(), deleter);
+    }
+
+    std::unique_ptr<BundleResourceInflater>
+    BundleResourceContainer::GetInflater(int index)
+    {
+        mz_zip_archive_file_stat zipStat;
+        auto entryData = GetMappedEntry(index, zipStat);
+        if (!entryData || zipStat.m_method != MZ_DEFLATED)
+        {
+            return nullptr;
+        }
+        auto const* compressed = static_cast<unsigned char const*>(entryData.get());
+        return std::make_unique<BundleResourceInflater>(std::move(entryData),
+                                                        compressed,
+                                                        static_cast<std::size_t>(zipStat.m_comp_size),
+                                                        static_cast<std::size_t>(zipStat.m_uncomp_size),
+                                                        zipStat.m_crc32);
+    }
+
+    std::shared_ptr<void const>
+    BundleResourceContainer::GetMappedEntry(int index, mz_zip_archive_file_stat& zipStat)
+    {
+        OpenAndInitializeContainer();
+        std::shared_ptr<RawBundleResources> rawData;
+        {
+            std::lock_guard<std::mutex> lock(m_ZipFileMutex);
+            rawData = m_RawData;
+        }
+        if (!rawData || index < 0)
+        {
+            return nullptr;
+        }
+
+        mz_uint64 archiveOffset = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_ZipFileStreamMutex);
+            if (!mz_zip_reader_file_stat(&m_ZipArchive, index, &zipStat))
+            {
+                return nullptr;
+            }
+            archiveOffset = m_ZipArchive.m_archive_file_ofs;
+        }
+
+        // Bit 0 of the flags marks encrypted entries
+        if ((zipStat.m_bit_flag & 1) != 0)
+        {
+            return nullptr;
+        }
+
+        auto const* base = static_cast<char const*>(rawData->GetData());
+        auto const size = rawData->GetSize();
+        auto const headerOffset = archiveOffset + zipStat.m_local_header_ofs;
+        if (headerOffset + LOCAL_HEADER_SIZE > size || ReadLE32(base + headerOffset) != LOCAL_HEADER_SIG)
+        {
+            return nullptr;
+        }
+        auto const dataOffset = headerOffset + LOCAL_HEADER_SIZE
+                                + ReadLE16(base + headerOffset + LOCAL_HEADER_NAME_LEN_OFS)
+                                + ReadLE16(base + headerOffset + LOCAL_HEADER_EXTRA_LEN_OFS);
+        if (dataOffset + zipStat.m_comp_size > size)
+        {
+            return nullptr;
+        }
+        // shares ownership of the mapping
+        return std::shared_ptr<void const>(rawData, base + dataOffset);
+    }
+
     void
     BundleResourceContainer::GetChildren(std::string const& resourcePath,
                                          bool relativePaths,
                                          std::vector<std::string>& names,
                                          std::vector<uint32_t>& indices) const
     {
-        auto iter = m_SortedEntries.find(std::make_pair(resourcePath, 0));
-        if (iter == m_SortedEntries.end())
+        auto index = GetEntryIndex();
+        auto const dirPos = index->Find(resourcePath);
+        if (dirPos == EntryIndex::npos)
         {
             return;
         }
 
-        for (++iter; iter != m_SortedEntries.end(); ++iter)
+        for (auto i = index->childRanges[dirPos], end = index->childRanges[dirPos + 1]; i < end; ++i)
         {
-            if (resourcePath.size() > iter->first.size())
-                break;
-            if (iter->first.compare(0, resourcePath.size(), resourcePath) == 0)
+            auto const fileIndex = index->sorted[index->children[i]];
+            auto name = index->GetName(fileIndex);
+            if (relativePaths)
             {
-                std::size_t pos = iter->first.find_first_of('/', resourcePath.size());
-                if (pos == std::string::npos || pos == iter->first.size() - 1)
-                {
-                    if (relativePaths)
-                    {
-                        names.push_back(iter->first.substr(resourcePath.size()));
-                    }
-                    else
-                    {
-                        names.push_back(iter->first);
-                    }
-                    indices.push_back(iter->second);
-                }
+                names.emplace_back(name.substr(resourcePath.size()));
             }
+            else
+            {
+                names.emplace_back(name);
+            }
+            indices.push_back(fileIndex);
         }
     }
 
@@ -189,22 +349,35 @@ namespace cppmicroservices
                                        bool recurse,
                                        std::vector<BundleResource>& resources) const
     {
-        std::vector<std::string> names;
-        std::vector<uint32_t> indices;
-
-        OpenAndInitializeContainer();
-
-        this->GetChildren(path, true, names, indices);
+        auto index = GetEntryIndex();
+        auto const dirPos = index->Find(path);
+        if (dirPos != EntryIndex::npos)
+        {
+            FindNodes(archive, *index, dirPos, FilePattern(filePattern), recurse, resources);
+        }
+    }
 
-        for (std::size_t i = 0, s = names.size(); i < s; ++i)
+    void
+    BundleResourceContainer::FindNodes(std::shared_ptr<BundleArchive const> const& archive,
+                                       EntryIndex const& index,
+                                       uint32_t dirPos,
+                                       FilePattern const& pattern,
+                                       bool recurse,
+                                       std::vector<BundleResource>& resources) const
+    {
+        auto const dirNameSize = index.GetName(index.sorted[dirPos]).size();
+        for (auto i = index.childRanges[dirPos], end = index.childRanges[dirPos + 1]; i < end; ++i)
         {
-            if (*names[i].rbegin() == '/' && recurse)
+            auto const childPos = index.children[i];
+            auto const fileIndex = index.sorted[childPos];
+            auto name = index.GetName(fileIndex).substr(dirNameSize);
+            if (recurse && name.back() == '/')
             {
-                this->FindNodes(archive, path + names[i], filePattern, recurse, resources);
+                FindNodes(archive, index, childPos, pattern, recurse, resources);
             }
-            if (this->Matches(names[i], filePattern))
+            if (pattern.Matches(name))
             {
-                resources.push_back(BundleResource(indices[i], archive));
+                resources.push_back(BundleResource(static_cast<int>(fileIndex), archive));
             }
         }
     }
@@ -212,6 +385,8 @@ namespace cppmicroservices
     void
     BundleResourceContainer::InitMiniz() const
     {
+        detail::TraceSpan span("BundleResourceContainer::Open", m_Location);
+
         // Assume that the bundle had its meta-data linked into a data section.
         // If this assumption is false, fall back to reading the meta-data in a
         // less than optimal way, in terms of memory utilization.
@@ -227,61 +402,175 @@ namespace cppmicroservices
             DIAG_LOG(*sink) << "Exception thrown creating BundleFileObj : " << ex.what();
         }
 
-        if (!rawBundleResourceData || !rawBundleResourceData->GetData()
-            || !mz_zip_reader_init_mem(&m_ZipArchive,
-                                       rawBundleResourceData->GetData(),
-                                       rawBundleResourceData->GetSize(),
-                                       0))
+#if defined(US_PLATFORM_APPLE) || defined(US_PLATFORM_POSIX)
+        if (!rawBundleResourceData || !rawBundleResourceData->GetData())
         {
-            if (!mz_zip_reader_init_file(&m_ZipArchive, m_Location.c_str(), 0))
+            // Not an object file with embedded resources, so this should be a
+            // plain zip file. Map it, instead of reading it through a stream.
+            std::ifstream file(m_Location, std::ifstream::binary | std::ifstream::ate);
+            auto const fileSize = file ? static_cast<std::size_t>(file.tellg()) : 0;
+            if (fileSize > 0)
             {
-                throw std::runtime_error("Could not init zip archive for bundle at " + m_Location);
+                rawBundleResourceData
+                    = std::make_shared<RawBundleResources>(std::make_unique<MappedFile>(m_Location, fileSize, 0));
             }
         }
+#endif
+
+        if (rawBundleResourceData && rawBundleResourceData->GetData()
+            && mz_zip_reader_init_mem(&m_ZipArchive,
+                                      rawBundleResourceData->GetData(),
+                                      rawBundleResourceData->GetSize(),
+                                      0))
+        {
+            m_RawData = std::move(rawBundleResourceData);
+        }
+        else if (!mz_zip_reader_init_file(&m_ZipArchive, m_Location.c_str(), 0))
+        {
+            throw std::runtime_error("Could not init zip archive for bundle at " + m_Location);
+        }
     }
 
     void
-    BundleResourceContainer::InitSortedEntries() const
+    BundleResourceContainer::InitEntryIndex() const
     {
-        mz_uint numFiles = mz_zip_reader_get_num_files(const_cast<mz_zip_archive*>(&m_ZipArchive));
+        auto index = std::make_shared<EntryIndex>();
+        auto const cdirOffset = m_ZipArchive.m_central_directory_file_ofs;
+        auto const cdirSize = mz_zip_get_central_dir_size(&m_ZipArchive);
+        if (m_RawData)
+        {
+            index->owner = m_RawData;
+            index->centralDir = static_cast<char const*>(m_RawData->GetData()) + cdirOffset;
+        }
+        else
+        {
+            // The zip file is read through a stream, so keep a copy of its
+            // central directory.
+            std::shared_ptr<char> centralDir(new char[cdirSize], std::default_delete<char[]>());
+            std::ifstream file(m_Location, std::ifstream::binary);
+            file.seekg(static_cast<std::streamoff>(cdirOffset));
+            if (!file.read(centralDir.get(), static_cast<std::streamsize>(cdirSize)))
+            {
+                throw std::runtime_error("Could not read zip central directory for bundle at " + m_Location);
+            }
+            index->centralDir = centralDir.get();
+            index->owner = std::move(centralDir);
+        }
+
+        mz_uint numFiles = mz_zip_reader_get_num_files(&m_ZipArchive);
+        index->offsets.reserve(numFiles);
+        std::size_t offset = 0;
         for (mz_uint fileIndex = 0; fileIndex < numFiles; ++fileIndex)
         {
-            char fileName[MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE];
-            if (mz_zip_reader_get_filename(&m_ZipArchive, fileIndex, fileName, MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE))
+            auto const* header = index->centralDir + offset;
+            if (offset + CENTRAL_HEADER_SIZE > cdirSize || ReadLE32(header) != CENTRAL_HEADER_SIG)
             {
-                std::string strFileName = fileName;
-                m_SortedEntries.insert(std::make_pair(strFileName, fileIndex));
-                std::size_t pos = strFileName.find_first_of('/');
-                if (pos != std::string::npos)
-                {
-                    m_SortedToplevelDirs.insert(strFileName.substr(0, pos));
-                }
+                throw std::runtime_error("Invalid zip central directory for bundle at " + m_Location);
+            }
+            index->offsets.push_back(static_cast<uint32_t>(offset));
+            offset += CENTRAL_HEADER_SIZE + ReadLE16(header + CENTRAL_HEADER_NAME_LEN_OFS)
+                      + ReadLE16(header + CENTRAL_HEADER_EXTRA_LEN_OFS)
+                      + ReadLE16(header + CENTRAL_HEADER_COMMENT_LEN_OFS);
+            if (offset > cdirSize)
+            {
+                throw std::runtime_error("Invalid zip central directory for bundle at " + m_Location);
             }
         }
+
+        index->sorted.resize(numFiles);
+        for (mz_uint fileIndex = 0; fileIndex < numFiles; ++fileIndex)
+        {
+            index->sorted[fileIndex] = fileIndex;
+        }
+        std::sort(index->sorted.begin(),
+                  index->sorted.end(),
+                  [&index](uint32_t l, uint32_t r) { return index->GetName(l) < index->GetName(r); });
+        InitDirectoryTree(*index);
+
+        // Names with the same top-level dir are adjacent in sorted order
+        std::vector<std::string> toplevelDirs;
+        for (auto fileIndex : index->sorted)
+        {
+            auto name = index->GetName(fileIndex);
+            std::size_t pos = name.find_first_of('/');
+            if (pos != std::string_view::npos && (toplevelDirs.empty() || toplevelDirs.back() != name.substr(0, pos)))
+            {
+                toplevelDirs.emplace_back(name.substr(0, pos));
+            }
+        }
+        toplevelDirs.insert(toplevelDirs.end(), m_SortedToplevelDirs.begin(), m_SortedToplevelDirs.end());
+        std::sort(toplevelDirs.begin(), toplevelDirs.end());
+        toplevelDirs.erase(std::unique(toplevelDirs.begin(), toplevelDirs.end()), toplevelDirs.end());
+
+        m_SortedToplevelDirs.swap(toplevelDirs);
+        m_EntryIndex = std::move(index);
     }
 
-    bool
-    BundleResourceContainer::Matches(std::string const& name, std::string const& filePattern) const
+    std::shared_ptr<BundleResourceContainer::EntryIndex const>
+    BundleResourceContainer::GetEntryIndex() const
     {
-        // short-cut
-        if (filePattern == "*")
+        OpenAndInitializeContainer();
+        std::lock_guard<std::mutex> lock(m_ZipFileMutex);
+        return m_EntryIndex;
+    }
+
+    void
+    BundleResourceContainer::InitDirectoryTree(EntryIndex& index)
+    {
+        auto const numEntries = static_cast<uint32_t>(index.sorted.size());
+
+        // An entry is a direct child of a directory if its name continues the
+        // directory name up to at most one more '/' at its end. The names
+        // starting with a directory name follow it in sorted order, so the
+        // enclosing directories of an entry are on the stack and the last of
+        // them is the only candidate parent.
+        std::vector<uint32_t> parents(numEntries, EntryIndex::npos);
+        std::vector<uint32_t> dirs;
+        for (uint32_t pos = 0; pos < numEntries; ++pos)
         {
-            return true;
+            auto name = index.GetName(index.sorted[pos]);
+            while (!dirs.empty())
+            {
+                auto dirName = index.GetName(index.sorted[dirs.back()]);
+                if (name.size() > dirName.size() && name.compare(0, dirName.size(), dirName) == 0)
+                {
+                    auto slash = name.find('/', dirName.size());
+                    if (slash == std::string_view::npos || slash == name.size() - 1)
+                    {
+                        parents[pos] = dirs.back();
+                    }
+                    break;
+                }
+                dirs.pop_back();
+            }
+            if (!name.empty() && name.back() == '/')
+            {
+                dirs.push_back(pos);
+            }
         }
 
-        std::stringstream ss(filePattern);
-        std::string tok;
-        std::size_t pos = 0;
-        while (std::getline(ss, tok, '*'))
+        // Group the children by parent, keeping them sorted by name
+        index.childRanges.assign(numEntries + 1, 0);
+        for (auto parent : parents)
         {
-            std::size_t index = name.find(tok, pos);
-            if (index == std::string::npos)
+            if (parent != EntryIndex::npos)
             {
-                return false;
+                ++index.childRanges[parent + 1];
+            }
+        }
+        for (uint32_t pos = 0; pos < numEntries; ++pos)
+        {
+            index.childRanges[pos + 1] += index.childRanges[pos];
+        }
+        index.children.resize(index.childRanges[numEntries]);
+        std::vector<uint32_t> next(index.childRanges.begin(), index.childRanges.end() - 1);
+        for (uint32_t pos = 0; pos < numEntries; ++pos)
+        {
+            if (parents[pos] != EntryIndex::npos)
+            {
+                index.children[next[parents[pos]]++] = pos;
             }
-            pos = index + tok.size();
         }
-        return true;
     }
 
     void
@@ -292,13 +581,20 @@ namespace cppmicroservices
         {
             InitMiniz();
 
-            InitSortedEntries();
+            try
+            {
+                InitEntryIndex();
+            }
+            catch (...)
+            {
+                CloseArchive_unlocked();
+                throw;
+            }
             if (m_SortedToplevelDirs.empty())
             {
                 // This is not a file containing a valid bundle
                 // so make sure we clean up and close the file handle.
-                mz_zip_reader_end(&m_ZipArchive);
-                m_ObjFile.reset();
+                CloseArchive_unlocked();
                 throw std::runtime_error("Invalid zip archive layout for bundle at " + m_Location);
             }
             m_IsContainerOpen = true;
@@ -311,9 +607,28 @@ namespace cppmicroservices
         std::lock_guard<std::mutex> lock(m_ZipFileMutex);
         if (m_IsContainerOpen)
         {
-            mz_zip_reader_end(&m_ZipArchive);
-            m_ObjFile.reset();
+            CloseArchive_unlocked();
             m_IsContainerOpen = false;
         }
     }
+
+    void
+    BundleResourceContainer::ReleaseMappedPages()
+    {
+        std::lock_guard<std::mutex> lock(m_ZipFileMutex);
+        if (m_IsContainerOpen && m_RawData)
+        {
+            m_RawData->ReleasePages();
+        }
+    }
+
+    void
+    BundleResourceContainer::CloseArchive_unlocked() const
+    {
+        // Resources which are still in use keep the mapping alive
+        mz_zip_reader_end(&m_ZipArchive);
+        m_EntryIndex.reset();
+        m_RawData.reset();
+        m_ObjFile.reset();
+    }
 } // namespace cppmicroservices
@@ -31,8 +31,8 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
-#include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace cppmicroservices
@@ -40,6 +40,7 @@ namespace cppmicroservices
 
     struct BundleArchive;
     class BundleResource;
+    class BundleResourceInflater;
 
     class BundleResourceContainer : public std::enable_shared_from_this<BundleResourceContainer>
     {
@@ -71,6 +72,20 @@ namespace cppmicroservices
 
         std::unique_ptr<void, void (*)(void*)> GetData(int index);
 
+        /**
+         * Like GetData(int), but entries which are stored uncompressed in a
+         * memory mapped bundle are not copied. The returned pointer refers
+         * to the mapping and keeps it alive.
+         */
+        std::shared_ptr<void const> GetSharedData(int index);
+
+        /**
+         * Get an inflater for a deflated entry of a memory mapped bundle,
+         * which reads the entry without extracting all of it first and
+         * without locking the container. Returns null for other entries.
+         */
+        std::unique_ptr<BundleResourceInflater> GetInflater(int index);
+
         void GetChildren(std::string const& resourcePath,
                          bool relativePaths,
                          std::vector<std::string>& names,
@@ -88,21 +103,71 @@ namespace cppmicroservices
         /// with a limit (e.g. Windows).
         void CloseContainer();
 
+        /// Drop the resident pages of the memory mapped zip data, if any.
+        /// The container stays open and the pages are read in again when
+        /// resources are accessed.
+        void ReleaseMappedPages();
+
       private:
-        using NameIndexPair = std::pair<std::string, int>;
+        // The entry names of the zip file, referring to its central directory
+        // instead of copying the names.
+        struct EntryIndex
+        {
+            // Keeps the memory holding the central directory alive
+            std::shared_ptr<void const> owner;
+            char const* centralDir = nullptr;
+            // Offsets of the central directory headers, by file index
+            std::vector<uint32_t> offsets;
+            // File indices, sorted by entry name
+            std::vector<uint32_t> sorted;
+            // The directory tree, by position in sorted. The direct children
+            // of the directory entry at position i are at the positions
+            // children[childRanges[i]] to children[childRanges[i + 1] - 1].
+            std::vector<uint32_t> childRanges;
+            std::vector<uint32_t> children;
+
+            static constexpr uint32_t npos = UINT32_MAX;
+
+            std::string_view GetName(uint32_t index) const;
+
+            /// Get the position of name in sorted, or npos.
+            uint32_t Find(std::string_view name) const;
+        };
 
-        struct PairComp
+        // A file name pattern where '*' matches any sequence of characters,
+        // split into its literal parts once for matching many names.
+        class FilePattern
         {
-            inline bool
-            operator()(NameIndexPair const& p1, NameIndexPair const& p2) const
-            {
-                return p1.first < p2.first;
-            }
+          public:
+            explicit FilePattern(std::string const& pattern);
+
+            bool Matches(std::string_view name) const;
+
+          private:
+            std::vector<std::string> m_Literals;
         };
 
-        void InitSortedEntries() const;
+        /// Build the entry index and the top-level dirs from the central directory.
+        /// throws std::runtime_error if the central directory is malformed.
+        void InitEntryIndex() const;
 
-        bool Matches(std::string const& name, std::string const& filePattern) const;
+        /// Get the entry index, opening the container if necessary.
+        std::shared_ptr<EntryIndex const> GetEntryIndex() const;
+
+        /// Build the directory tree of the entry index.
+        static void InitDirectoryTree(EntryIndex& index);
+
+        void FindNodes(std::shared_ptr<BundleArchive const> const& archive,
+                       EntryIndex const& index,
+                       uint32_t dirPos,
+                       FilePattern const& pattern,
+                       bool recurse,
+                       std::vector<BundleResource>& resources) const;
+
+        /// Get the stat and the (possibly compressed) data of an entry of a
+        /// memory mapped bundle. Returns null if the zip archive is not memory
+        /// mapped or the entry is encrypted.
+        std::shared_ptr<void const> GetMappedEntry(int index, mz_zip_archive_file_stat& zipStat);
 
         /// Initialize miniz with the resource zip file information.
         /// throws std::runtime_error if the underlying zip file cannot be opened or read.
@@ -113,12 +178,19 @@ namespace cppmicroservices
         /// Throws std::runtime_error if the underlying zip file cannot be opened.
         void OpenAndInitializeContainer() const;
 
+        /// Release the zip archive and the data it was read from.
+        /// m_ZipFileMutex must be locked.
+        void CloseArchive_unlocked() const;
+
         const std::string m_Location;
         mutable mz_zip_archive m_ZipArchive;
         mutable std::unique_ptr<BundleObjFile> m_ObjFile;
+        // The zip file contents, if the zip archive was initialized from memory
+        mutable std::shared_ptr<RawBundleResources> m_RawData;
 
-        mutable std::set<NameIndexPair, PairComp> m_SortedEntries;
-        mutable std::set<std::string> m_SortedToplevelDirs;
+        mutable std::shared_ptr<EntryIndex const> m_EntryIndex;
+        // sorted and unique
+        mutable std::vector<std::string> m_SortedToplevelDirs;
 
         // This is used to synchronize miniz file stream API calls.
         // Working with file streams is stateful (e.g. current read position)
@@ -0,0 +1,88 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "BundleResourceInflater.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace cppmicroservices
+{
+
+    BundleResourceInflater::BundleResourceInflater(std::shared_ptr<void const> owner,
+                                                   unsigned char const* compressed,
+                                                   std::size_t compressedSize,
+                                                   std::size_t size,
+                                                   std::uint32_t expectedCrc32)
+        : owner(std::move(owner))
+        , compressed(compressed)
+        , compressedSize(compressedSize)
+        , size(size)
+        , expectedCrc32(expectedCrc32)
+        , window(new unsigned char[TINFL_LZ_DICT_SIZE])
+    {
+        Rewind();
+    }
+
+    BundleResourceInflater::Block
+    BundleResourceInflater::Next()
+    {
+        while (status != TINFL_STATUS_DONE)
+        {
+            // The window is used as a circular buffer. Each call fills it up
+            // to its end at most, so the new data is contiguous.
+            auto* out = window.get() + (outOffset & (TINFL_LZ_DICT_SIZE - 1));
+            std::size_t inBytes = compressedSize - inOffset;
+            std::size_t outBytes = TINFL_LZ_DICT_SIZE - (outOffset & (TINFL_LZ_DICT_SIZE - 1));
+            status = tinfl_decompress(&inflator, compressed + inOffset, &inBytes, window.get(), out, &outBytes, 0);
+            inOffset += inBytes;
+            outOffset += outBytes;
+
+            if (status < TINFL_STATUS_DONE || outOffset > size
+                || (status == TINFL_STATUS_NEEDS_MORE_INPUT && inOffset == compressedSize))
+            {
+                throw std::runtime_error("Corrupt compressed resource data");
+            }
+
+            crc = mz_crc32(crc, out, outBytes);
+            if (status == TINFL_STATUS_DONE && (outOffset != size || crc != expectedCrc32))
+            {
+                throw std::runtime_error("Compressed resource data does not match its size or checksum");
+            }
+            if (outBytes != 0)
+            {
+                return { reinterpret_cast<char const*>(out), outBytes };
+            }
+        }
+        return { nullptr, 0 };
+    }
+
+    void
+    BundleResourceInflater::Rewind()
+    {
+        tinfl_init(&inflator);
+        status = TINFL_STATUS_NEEDS_MORE_INPUT;
+        inOffset = 0;
+        outOffset = 0;
+        crc = MZ_CRC32_INIT;
+    }
+} // namespace cppmicroservices
@@ -0,0 +1,104 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLERESOURCEINFLATER_H
+#define CPPMICROSERVICES_BUNDLERESOURCEINFLATER_H
+
+#include "miniz.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace cppmicroservices
+{
+
+    /**
+     * Inflates a deflated zip entry incrementally, from compressed data which
+     * is held in memory (e.g. a memory mapped bundle).
+     *
+     * The data is produced in blocks, in a window of TINFL_LZ_DICT_SIZE bytes
+     * which doubles as the dictionary of the decompressor. Each inflater has
+     * its own decompression state and window, so inflaters of the same
+     * bundle can be used concurrently. A single inflater is not thread-safe.
+     */
+    class BundleResourceInflater
+    {
+      public:
+        struct Block
+        {
+            char const* data;
+            std::size_t size;
+        };
+
+        /**
+         * @param owner Keeps the compressed data alive.
+         * @param compressed The deflated data of the entry.
+         * @param compressedSize The size of the deflated data.
+         * @param size The size of the inflated data.
+         * @param expectedCrc32 The CRC-32 checksum of the inflated data.
+         */
+        BundleResourceInflater(std::shared_ptr<void const> owner,
+                               unsigned char const* compressed,
+                               std::size_t compressedSize,
+                               std::size_t size,
+                               std::uint32_t expectedCrc32);
+
+        BundleResourceInflater(BundleResourceInflater const&) = delete;
+        BundleResourceInflater& operator=(BundleResourceInflater const&) = delete;
+
+        std::size_t
+        GetSize() const
+        {
+            return size;
+        }
+
+        /**
+         * Inflate the next block of data. The block is valid until the next
+         * call to Next() or Rewind(). Returns an empty block at the end of the
+         * data.
+         *
+         * @throws std::runtime_error if the data is corrupt or does not match
+         *         the size or checksum of the entry.
+         */
+        Block Next();
+
+        /// Restart inflating from the beginning of the data.
+        void Rewind();
+
+      private:
+        std::shared_ptr<void const> const owner;
+        unsigned char const* const compressed;
+        std::size_t const compressedSize;
+        std::size_t const size;
+        std::uint32_t const expectedCrc32;
+
+        std::unique_ptr<unsigned char[]> window;
+        tinfl_decompressor inflator;
+        tinfl_status status;
+        std::size_t inOffset;
+        std::size_t outOffset;
+        mz_ulong crc;
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_BUNDLERESOURCEINFLATER_H
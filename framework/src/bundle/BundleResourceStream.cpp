@@ -31,7 +31,7 @@ namespace cppmicroservices
 {
 
     BundleResourceStream::BundleResourceStream(BundleResource const& resource, std::ios_base::openmode mode)
-        : BundleResourceBuffer(resource.GetData(), resource.GetSize(), mode | std::ios_base::in)
+        : BundleResourceBuffer(resource, mode | std::ios_base::in)
         , std::istream(this)
     {
     }
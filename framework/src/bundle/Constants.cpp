@@ -57,6 +57,13 @@ namespace cppmicroservices
         const std::string FRAMEWORK_WORKING_DIR = "org.cppmicroservices.framework.working.dir";
         const std::string FRAMEWORK_BUNDLE_VALIDATION_FUNC
             = "org.cppmicroservices.framework.bundle.validation.function";
+        const std::string FRAMEWORK_SERVICE_REGISTRY_SNAPSHOT
+            = "org.cppmicroservices.framework.service.registry.snapshot";
+        const std::string FRAMEWORK_SERVICE_EVENTS_ASYNC = "org.cppmicroservices.framework.service.events.async";
+        const std::string FRAMEWORK_BUNDLE_METADATA_CACHE = "org.cppmicroservices.framework.bundle.metadata.cache";
+        const std::string FRAMEWORK_TRACE = "org.cppmicroservices.framework.trace";
+        const std::string FRAMEWORK_SERVICE_REGISTRY_METRICS
+            = "org.cppmicroservices.framework.service.registry.metrics";
         const std::string OBJECTCLASS = "objectclass";
         const std::string SERVICE_ID = "service.id";
         const std::string SERVICE_PID = "service.pid";
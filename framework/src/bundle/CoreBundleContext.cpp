@@ -29,6 +29,7 @@ US_MSVC_DISABLE_WARNING(4355)
 #include "cppmicroservices/BundleInitialization.h"
 #include "cppmicroservices/Constants.h"
 #include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/Trace.h"
 
 #include "cppmicroservices/util/FileSystem.h"
 #include "cppmicroservices/util/String.h"
@@ -58,6 +59,21 @@ namespace cppmicroservices
         // Framework internal diagnostic logging is off by default
         configuration.emplace(std::make_pair(Constants::FRAMEWORK_LOG, Any(false)));
 
+        // Service lookups take the service registry lock by default
+        configuration.emplace(std::make_pair(Constants::FRAMEWORK_SERVICE_REGISTRY_SNAPSHOT, Any(false)));
+
+        // Service events are delivered synchronously by default
+        configuration.emplace(std::make_pair(Constants::FRAMEWORK_SERVICE_EVENTS_ASYNC, Any(false)));
+
+        // Bundle manifests are not cached on disk by default
+        configuration.emplace(std::make_pair(Constants::FRAMEWORK_BUNDLE_METADATA_CACHE, Any(false)));
+
+        // Tracing spans are not recorded by default
+        configuration.emplace(std::make_pair(Constants::FRAMEWORK_TRACE, Any(false)));
+
+        // Service registry metrics are off by default
+        configuration.emplace(std::make_pair(Constants::FRAMEWORK_SERVICE_REGISTRY_METRICS, Any(false)));
+
         // Framework::PROP_THREADING_SUPPORT is a read-only property whose value is based off of a compile-time switch.
         // Run-time modification of the property should be ignored as it is irrelevant.
 #ifdef US_ENABLE_THREADING_SUPPORT
@@ -82,10 +98,25 @@ namespace cppmicroservices
         return configuration;
     }
 
+    namespace
+    {
+        std::shared_ptr<ServiceRegistryMetricsCollector>
+        CreateRegistryMetrics(std::unordered_map<std::string, Any> const& properties)
+        {
+            auto const& metricsProp = properties.at(Constants::FRAMEWORK_SERVICE_REGISTRY_METRICS);
+            if (metricsProp.Type() == typeid(bool) && any_cast<bool>(metricsProp))
+            {
+                return std::make_shared<ServiceRegistryMetricsCollector>();
+            }
+            return nullptr;
+        }
+    } // namespace
+
     CoreBundleContext::CoreBundleContext(std::unordered_map<std::string, Any> const& props, std::ostream* diagLogger)
         : id(globalId++)
         , frameworkProperties(InitProperties(props))
         , workingDir(ref_any_cast<std::string>(frameworkProperties.at(Constants::FRAMEWORK_WORKING_DIR)))
+        , registryMetrics(CreateRegistryMetrics(frameworkProperties))
         , listeners(this)
         , services(this)
         , logger(std::make_shared<cppmicroservices::cfrimpl::CFRLogger>())
@@ -99,6 +130,12 @@ namespace cppmicroservices
         auto enableDiagLog = any_cast<bool>(frameworkProperties.at(Constants::FRAMEWORK_LOG));
         std::ostream* diagnosticLogger = (diagLogger) ? diagLogger : &std::clog;
         sink = std::make_shared<detail::LogSink>(diagnosticLogger, enableDiagLog);
+
+        auto const& trace = frameworkProperties.at(Constants::FRAMEWORK_TRACE);
+        if (trace.Type() == typeid(bool) && any_cast<bool>(trace))
+        {
+            Tracer::Enable();
+        }
         systemBundle = std::shared_ptr<FrameworkPrivate>(new FrameworkPrivate(this));
         DIAG_LOG(*sink) << "created";
     }
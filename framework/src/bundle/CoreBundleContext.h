@@ -53,6 +53,7 @@ as specified in the OSGi R4.2 specifications.
 #include "ServiceHooks.h"
 #include "ServiceListeners.h"
 #include "ServiceRegistry.h"
+#include "ServiceRegistryMetricsCollector.h"
 
 #include <map>
 #include <ostream>
@@ -121,6 +122,13 @@ namespace cppmicroservices
          */
         std::string dataStorage;
 
+        /**
+         * Service registry metrics, or null if they are disabled. See
+         * Constants::FRAMEWORK_SERVICE_REGISTRY_METRICS. Shared with the
+         * properties of the registered services, which may outlive this object.
+         */
+        std::shared_ptr<ServiceRegistryMetricsCollector> const registryMetrics;
+
         /**
          * All listeners in this framework.
          */
@@ -0,0 +1,289 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ServiceEventDispatcher.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace cppmicroservices
+{
+
+    ServiceEventDispatcher::ServiceEventDispatcher(DeliverFunction deliver)
+        : deliver(std::move(deliver))
+        , stopping(false)
+    {
+    }
+
+    std::shared_ptr<ServiceEventDispatcher>
+    ServiceEventDispatcher::Create(std::size_t threadCount, DeliverFunction deliver)
+    {
+        std::shared_ptr<ServiceEventDispatcher> dispatcher(new ServiceEventDispatcher(std::move(deliver)));
+
+        std::lock_guard<std::mutex> lock(dispatcher->mutex);
+        threadCount = std::max<std::size_t>(threadCount, 1);
+        dispatcher->threads.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            // The threads keep the dispatcher alive, so that Shutdown() can
+            // be called from within a listener.
+            dispatcher->threads.emplace_back([self = dispatcher] { self->Run(); });
+        }
+        return dispatcher;
+    }
+
+    void
+    ServiceEventDispatcher::Post(std::unordered_set<ServiceListenerEntry> const& listeners, ServiceEvent const& evt)
+    {
+        std::size_t scheduled = 0;
+        {
+            ServiceReferenceBase const ref = evt.GetServiceReference();
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto const& listener : listeners)
+            {
+                if (!listener.IsRemoved() && Post_unlocked(listener, evt, ref))
+                {
+                    ++scheduled;
+                }
+            }
+        }
+
+        if (scheduled == 1)
+        {
+            readyCondition.notify_one();
+        }
+        else if (scheduled > 1)
+        {
+            readyCondition.notify_all();
+        }
+    }
+
+    bool
+    ServiceEventDispatcher::Post_unlocked(ServiceListenerEntry const& listener,
+                                          ServiceEvent const& evt,
+                                          ServiceReferenceBase const& ref)
+    {
+        auto& queue = queues[listener];
+        if (Coalesce_unlocked(queue, evt, ref))
+        {
+            return false;
+        }
+
+        auto const seq = queue.frontSeq + queue.events.size();
+        queue.events.push_back(PendingEvent { evt, false });
+
+        auto& pending = queue.services[ref];
+        ++pending.count;
+        pending.lastType = evt.GetType();
+        if (evt.GetType() == ServiceEvent::SERVICE_REGISTERED)
+        {
+            pending.registeredPending = true;
+            pending.registeredSeq = seq;
+        }
+
+        if (queue.scheduled)
+        {
+            return false;
+        }
+        queue.scheduled = true;
+        ready.push_back(listener);
+        return true;
+    }
+
+    void
+    ServiceEventDispatcher::Remove(ServiceListenerEntry const& listener)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto iter = queues.find(listener);
+        // A scheduled queue is removed by the thread delivering its events
+        if (iter != queues.end() && !iter->second.scheduled)
+        {
+            queues.erase(iter);
+        }
+    }
+
+    bool
+    ServiceEventDispatcher::Coalesce_unlocked(ListenerQueue& queue,
+                                              ServiceEvent const& evt,
+                                              ServiceReferenceBase const& ref)
+    {
+        auto iter = queue.services.find(ref);
+        if (iter == queue.services.end())
+        {
+            return false;
+        }
+
+        auto& pending = iter->second;
+        switch (evt.GetType())
+        {
+            case ServiceEvent::SERVICE_MODIFIED:
+                // The listener has not seen the previous REGISTERED or
+                // MODIFIED event yet and will read the current properties
+                // when it does.
+                return pending.lastType == ServiceEvent::SERVICE_REGISTERED
+                       || pending.lastType == ServiceEvent::SERVICE_MODIFIED;
+            case ServiceEvent::SERVICE_UNREGISTERING:
+            {
+                if (!pending.registeredPending)
+                {
+                    return false;
+                }
+                // The service came and went before the listener saw it. All
+                // its pending events follow the REGISTERED event.
+                auto remaining = pending.count;
+                for (auto i = static_cast<std::size_t>(pending.registeredSeq - queue.frontSeq);
+                     remaining > 0 && i < queue.events.size();
+                     ++i)
+                {
+                    auto& pendingEvent = queue.events[i];
+                    if (!pendingEvent.cancelled && pendingEvent.event.GetServiceReference() == ref)
+                    {
+                        pendingEvent.cancelled = true;
+                        --remaining;
+                    }
+                }
+                queue.services.erase(iter);
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    bool
+    ServiceEventDispatcher::PopFront_unlocked(ListenerQueue& queue, ServiceEvent& evt)
+    {
+        assert(!queue.events.empty());
+        auto front = std::move(queue.events.front());
+        queue.events.pop_front();
+        ++queue.frontSeq;
+        if (front.cancelled)
+        {
+            return false;
+        }
+
+        evt = std::move(front.event);
+        auto iter = queue.services.find(evt.GetServiceReference());
+        assert(iter != queue.services.end() && iter->second.count > 0);
+        auto& pending = iter->second;
+        if (evt.GetType() == ServiceEvent::SERVICE_REGISTERED)
+        {
+            pending.registeredPending = false;
+        }
+        if (--pending.count == 0)
+        {
+            queue.services.erase(iter);
+        }
+        return true;
+    }
+
+    void
+    ServiceEventDispatcher::Run()
+    {
+        auto const self = std::this_thread::get_id();
+        std::vector<ServiceEvent> batch;
+        batch.reserve(BATCH_SIZE);
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            readyCondition.wait(lock, [this] { return stopping || !ready.empty(); });
+            if (ready.empty())
+            {
+                // stopping, and all pending events are delivered
+                return;
+            }
+
+            auto const listener = ready.front();
+            ready.pop_front();
+
+            // Only this thread removes the queue while it is scheduled, so
+            // the reference stays valid while the lock is released.
+            auto& queue = queues[listener];
+            batch.clear();
+            while (batch.size() < BATCH_SIZE && !queue.events.empty())
+            {
+                ServiceEvent evt;
+                if (PopFront_unlocked(queue, evt))
+                {
+                    batch.push_back(std::move(evt));
+                }
+            }
+
+            lock.unlock();
+            for (auto const& evt : batch)
+            {
+                deliver(listener, evt);
+                if (shutdownThread.load() == self)
+                {
+                    // Shutdown() was called by the listener
+                    return;
+                }
+            }
+            lock.lock();
+
+            if (listener.IsRemoved())
+            {
+                queues.erase(listener);
+            }
+            else if (queue.events.empty())
+            {
+                // Keep the empty queue, it is likely to be used again soon
+                queue.scheduled = false;
+            }
+            else
+            {
+                // give the other listeners a turn
+                ready.push_back(listener);
+                readyCondition.notify_one();
+            }
+        }
+    }
+
+    void
+    ServiceEventDispatcher::Shutdown()
+    {
+        std::vector<std::thread> stopped;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            stopped.swap(threads);
+            auto const self = std::this_thread::get_id();
+            for (auto& thread : stopped)
+            {
+                if (thread.get_id() == self)
+                {
+                    shutdownThread = self;
+                    thread.detach();
+                }
+            }
+        }
+        readyCondition.notify_all();
+
+        for (auto& thread : stopped)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+    }
+} // namespace cppmicroservices
@@ -0,0 +1,136 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_SERVICEEVENTDISPATCHER_H
+#define CPPMICROSERVICES_SERVICEEVENTDISPATCHER_H
+
+#include "cppmicroservices/ServiceEvent.h"
+
+#include "ServiceListenerEntry.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cppmicroservices
+{
+
+    /**
+     * Delivers service events asynchronously on a pool of threads, see
+     * Constants::FRAMEWORK_SERVICE_EVENTS_ASYNC.
+     *
+     * Each listener has its own queue of pending events, which is drained by
+     * at most one thread at a time. Listeners therefore receive their events
+     * in the order they were posted. Events which became redundant while they
+     * were pending are coalesced.
+     */
+    class ServiceEventDispatcher : public std::enable_shared_from_this<ServiceEventDispatcher>
+    {
+      public:
+        using DeliverFunction = std::function<void(ServiceListenerEntry const&, ServiceEvent const&)>;
+
+        //! Create a dispatcher and start its threads.
+        static std::shared_ptr<ServiceEventDispatcher> Create(std::size_t threadCount, DeliverFunction deliver);
+
+        ServiceEventDispatcher(ServiceEventDispatcher const&) = delete;
+        ServiceEventDispatcher& operator=(ServiceEventDispatcher const&) = delete;
+
+        //! Queue evt for delivery to each listener which has not been removed.
+        void Post(std::unordered_set<ServiceListenerEntry> const& listeners, ServiceEvent const& evt);
+
+        //! Drop the pending events of a listener which has been removed.
+        void Remove(ServiceListenerEntry const& listener);
+
+        /**
+         * Deliver all pending events and stop the threads. When called from a
+         * dispatcher thread, that thread stops after the current delivery
+         * returns, without delivering further events.
+         */
+        void Shutdown();
+
+      private:
+        // Maximum number of events delivered to one listener before other
+        // listeners get a turn.
+        static constexpr std::size_t BATCH_SIZE = 64;
+
+        struct PendingEvent
+        {
+            ServiceEvent event;
+            bool cancelled;
+        };
+
+        // The pending events of a listener for one service
+        struct PendingService
+        {
+            std::size_t count = 0;
+            ServiceEvent::Type lastType = ServiceEvent::SERVICE_REGISTERED;
+            bool registeredPending = false;
+            // sequence number of the pending REGISTERED event
+            std::uint64_t registeredSeq = 0;
+        };
+
+        struct ListenerQueue
+        {
+            std::deque<PendingEvent> events;
+            // sequence number of events.front()
+            std::uint64_t frontSeq = 0;
+            std::unordered_map<ServiceReferenceBase, PendingService> services;
+            bool scheduled = false;
+        };
+
+        ServiceEventDispatcher(DeliverFunction deliver);
+
+        //! Returns true if the listener was not scheduled yet.
+        bool Post_unlocked(ServiceListenerEntry const& listener,
+                           ServiceEvent const& evt,
+                           ServiceReferenceBase const& ref);
+
+        //! Returns true if evt, an event for the service ref, does not need to be queued.
+        bool Coalesce_unlocked(ListenerQueue& queue, ServiceEvent const& evt, ServiceReferenceBase const& ref);
+
+        //! Remove the first pending event of queue, returning false if it was cancelled.
+        bool PopFront_unlocked(ListenerQueue& queue, ServiceEvent& evt);
+
+        void Run();
+
+        DeliverFunction deliver;
+
+        std::mutex mutex;
+        std::condition_variable readyCondition;
+        std::unordered_map<ServiceListenerEntry, ListenerQueue> queues;
+        std::deque<ServiceListenerEntry> ready;
+        std::vector<std::thread> threads;
+        // the dispatcher thread which called Shutdown(), if any
+        std::atomic<std::thread::id> shutdownThread;
+        bool stopping;
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_SERVICEEVENTDISPATCHER_H
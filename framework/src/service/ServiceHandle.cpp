@@ -0,0 +1,97 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "cppmicroservices/ServiceHandle.h"
+
+#include "BundleContextPrivate.h"
+#include "BundlePrivate.h"
+#include "CoreBundleContext.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace cppmicroservices
+{
+
+    class ServiceHandleBasePrivate
+    {
+      public:
+        BundleContext m_context;
+        std::string const m_interfaceId;
+
+        ServiceHandleBasePrivate(BundleContext context, std::string interfaceId)
+            : m_context(std::move(context))
+            , m_interfaceId(std::move(interfaceId))
+        {
+        }
+    };
+
+    ServiceHandleBase::ServiceHandleBase(BundleContext const& context, std::string const& interfaceId)
+        : d(std::make_shared<ServiceHandleBasePrivate>(context, interfaceId))
+        , resolvedGeneration(0)
+    {
+        auto ctx = GetPrivate(context);
+        if (!ctx)
+        {
+            throw std::runtime_error("The bundle context is no longer valid");
+        }
+        ctx->CheckValid();
+        auto b = (ctx->Lock(), ctx->bundle.lock());
+        if (!b)
+        {
+            throw std::runtime_error("The bundle context is no longer valid");
+        }
+
+        // The registry generation starts at 1, so the first Get() resolves
+        generation = b->coreCtx->services.generation;
+    }
+
+    ServiceHandleBase::ServiceHandleBase(ServiceHandleBase const& other) = default;
+    ServiceHandleBase& ServiceHandleBase::operator=(ServiceHandleBase const& other) = default;
+
+    ServiceHandleBase::~ServiceHandleBase() = default;
+
+    bool
+    ServiceHandleBase::Resolve(std::shared_ptr<void>& service) const
+    {
+        // Read the generation first, changes during the lookup are seen by the next call
+        auto const currentGeneration = generation->load(std::memory_order_acquire);
+        auto current = d->m_context.GetServiceReference(d->m_interfaceId);
+        if (current == reference)
+        {
+            resolvedGeneration = currentGeneration;
+            return false;
+        }
+
+        ServiceReferenceBase const& baseRef = current;
+        service = current ? d->m_context.GetService(baseRef) : nullptr;
+        reference = current;
+        resolvedGeneration = currentGeneration;
+        return true;
+    }
+
+    ServiceReferenceBase
+    ServiceHandleBase::GetReference() const
+    {
+        return reference;
+    }
+} // namespace cppmicroservices
@@ -113,17 +113,15 @@ namespace cppmicroservices
                                           std::string const& filter,
                                           std::vector<ServiceReferenceBase>& refs)
     {
-        std::vector<ServiceRegistrationBase> srl;
-        coreCtx->services.Get_unlocked(us_service_interface_iid<ServiceFindHook>(), srl);
-        if (!srl.empty())
+        auto hooks = coreCtx->services.hookSet.Load();
+        if (hooks && !hooks->findHooks.empty())
         {
             ShrinkableVector<ServiceReferenceBase> filtered(refs);
 
             auto selfBundle = GetBundleContext().GetBundle();
-            std::sort(srl.begin(), srl.end());
-            for (auto fhrIter = srl.rbegin(), fhrEnd = srl.rend(); fhrIter != fhrEnd; ++fhrIter)
+            for (auto const& fhr : hooks->findHooks)
             {
-                ServiceReference<ServiceFindHook> sr = fhrIter->GetReference();
+                ServiceReference<ServiceFindHook> sr = fhr.GetReference();
                 auto fh
                     = std::static_pointer_cast<ServiceFindHook>(sr.d.load()->GetService(GetPrivate(selfBundle).get()));
                 if (fh)
@@ -146,15 +144,19 @@ namespace cppmicroservices
         }
     }
 
+    bool
+    ServiceHooks::HasServiceEventListenerHooks() const
+    {
+        return coreCtx->services.hasEventListenerHooks;
+    }
+
     void
     ServiceHooks::FilterServiceEventReceivers(ServiceEvent const& evt,
                                               ServiceListeners::ServiceListenerEntries& receivers)
     {
-        std::vector<ServiceRegistrationBase> eventListenerHooks;
-        coreCtx->services.Get(us_service_interface_iid<ServiceEventListenerHook>(), eventListenerHooks);
-        if (!eventListenerHooks.empty())
+        auto hooks = coreCtx->services.hookSet.Load();
+        if (hooks && !hooks->eventListenerHooks.empty())
         {
-            std::sort(eventListenerHooks.begin(), eventListenerHooks.end());
             std::map<BundleContext, std::vector<ServiceListenerHook::ListenerInfo>> listeners;
             for (auto& sle : receivers)
             {
@@ -172,10 +174,9 @@ namespace cppmicroservices
                 shrinkableListeners);
 
             auto selfBundle = GetBundleContext().GetBundle();
-            for (auto sriIter = eventListenerHooks.rbegin(), sriEnd = eventListenerHooks.rend(); sriIter != sriEnd;
-                 ++sriIter)
+            for (auto const& sri : hooks->eventListenerHooks)
             {
-                ServiceReference<ServiceEventListenerHook> sr = sriIter->GetReference();
+                ServiceReference<ServiceEventListenerHook> sr = sri.GetReference();
                 auto elh = std::static_pointer_cast<ServiceEventListenerHook>(
                     sr.d.load()->GetService(GetPrivate(selfBundle).get()));
                 if (elh)
@@ -61,11 +61,15 @@ namespace cppmicroservices
 
         bool IsOpen() const;
 
+        //! Calls the registered find hooks. Must not be called with the service registry lock held.
         void FilterServiceReferences(BundleContextPrivate* context,
                                      std::string const& service,
                                      std::string const& filter,
                                      std::vector<ServiceReferenceBase>& refs);
 
+        //! Returns true if any ServiceEventListenerHook services are registered.
+        bool HasServiceEventListenerHooks() const;
+
         void FilterServiceEventReceivers(ServiceEvent const& evt, ServiceListeners::ServiceListenerEntries& receivers);
 
         void HandleServiceListenerReg(ServiceListenerEntry const& sle);
@@ -26,6 +26,7 @@ US_MSVC_PUSH_DISABLE_WARNING(4180) // qualifier applied to function type has no
 
 #include "ServiceListenerEntry.h"
 
+#include "LDAPExprCache.h"
 #include "ServiceListenerHookPrivate.h"
 
 #include <cassert>
@@ -59,7 +60,7 @@ namespace cppmicroservices
         {
             if (!filter.empty())
             {
-                ldap = LDAPExpr(filter);
+                ldap = LDAPExprCache::Instance().Get(filter);
             }
         }
 
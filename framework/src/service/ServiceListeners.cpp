@@ -38,24 +38,51 @@ US_MSVC_PUSH_DISABLE_WARNING(4180) // qualifier applied to function type has no
 
 #include "BundlePrivate.h"
 #include "CoreBundleContext.h"
+#include "FlatAnyMap.h"
 #include "Properties.h"
+#include "ServiceEventDispatcher.h"
 #include "ServiceReferenceBasePrivate.h"
 
 #include <cassert>
+#include <limits>
+#include <list>
+#include <thread>
 #include <utility>
 
 namespace cppmicroservices
 {
 
-    ServiceListeners::ServiceListeners(CoreBundleContext* coreCtx) : listenerId(0), coreCtx(coreCtx)
+    ServiceListeners::ServiceListeners(CoreBundleContext* coreCtx)
+        : listenerId(0)
+        , coreCtx(coreCtx)
+        , metrics(coreCtx->registryMetrics.get())
+        , asyncServiceEvents(false)
     {
         hashedServiceKeys.push_back(Constants::OBJECTCLASS);
         hashedServiceKeys.push_back(Constants::SERVICE_ID);
+
+        auto asyncProp = coreCtx->frameworkProperties.find(Constants::FRAMEWORK_SERVICE_EVENTS_ASYNC);
+        if (asyncProp != coreCtx->frameworkProperties.end() && asyncProp->second.Type() == typeid(bool))
+        {
+            asyncServiceEvents = any_cast<bool>(asyncProp->second);
+        }
+    }
+
+    ServiceListeners::~ServiceListeners() { StopEventDispatcher(); }
+
+    ServiceListeners::UniqueLock
+    ServiceListeners::TimedLock() const
+    {
+        UniqueLock l(*this, std::defer_lock);
+        metrics->Acquire(ServiceRegistryMetricsCollector::LockKind::ServiceListeners, l);
+        return l;
     }
 
     void
     ServiceListeners::Clear()
     {
+        StopEventDispatcher();
+
         bundleListenerMap.Lock(), bundleListenerMap.value.clear();
         {
             auto l = this->Lock();
@@ -63,6 +90,7 @@ namespace cppmicroservices
             serviceSet.clear();
             hashedServiceKeys.clear();
             complicatedListeners.clear();
+            termIndex.clear();
             cache[0].clear();
             cache[1].clear();
         }
@@ -128,6 +156,7 @@ namespace cppmicroservices
             }
             if (!sle.IsNull())
             {
+                RemoveFromEventDispatcher(sle);
                 coreCtx->serviceHooks.HandleServiceListenerUnreg(sle);
             }
         }
@@ -156,6 +185,7 @@ namespace cppmicroservices
         }
         if (!sle.IsNull())
         {
+            RemoveFromEventDispatcher(sle);
             coreCtx->serviceHooks.HandleServiceListenerUnreg(sle);
         }
     }
@@ -357,6 +387,7 @@ namespace cppmicroservices
     void
     ServiceListeners::RemoveAllListeners(std::shared_ptr<BundleContextPrivate> const& context)
     {
+        std::vector<ServiceListenerEntry> removed;
         {
             auto l = this->Lock();
             US_UNUSED(l);
@@ -364,6 +395,9 @@ namespace cppmicroservices
             {
                 if (GetPrivate(it->GetBundleContext()) == context)
                 {
+                    // events which are still pending must not be delivered
+                    it->SetRemoved(true);
+                    removed.push_back(*it);
                     RemoveFromCache_unlocked(*it);
                     serviceSet.erase(it++);
                 }
@@ -373,6 +407,10 @@ namespace cppmicroservices
                 }
             }
         }
+        for (auto const& sle : removed)
+        {
+            RemoveFromEventDispatcher(sle);
+        }
 
         {
             auto l = bundleListenerMap.Lock();
@@ -417,8 +455,6 @@ namespace cppmicroservices
                                      ServiceEvent const& evt,
                                      ServiceListenerEntries& matchBefore)
     {
-        int n = 0;
-
         if (!matchBefore.empty())
         {
             for (auto& l : receivers)
@@ -427,65 +463,148 @@ namespace cppmicroservices
             }
         }
 
+        if (asyncServiceEvents)
+        {
+            GetEventDispatcher()->Post(receivers, evt);
+            return;
+        }
+
         for (auto const& l : receivers)
         {
-            if (!l.IsRemoved())
+            DeliverServiceEvent(l, evt);
+        }
+    }
+
+    void
+    ServiceListeners::DeliverServiceEvent(ServiceListenerEntry const& l, ServiceEvent const& evt)
+    {
+        // With asynchronous delivery, the listener may have been removed
+        // while the event was pending.
+        if (l.IsRemoved())
+        {
+            return;
+        }
+
+        if (metrics)
+        {
+            metrics->CountListenerInvocation();
+        }
+        try
+        {
+            l.CallDelegate(evt);
+        }
+        catch (...)
+        {
+            std::string message("Service listener in " + l.GetBundleContext().GetBundle().GetSymbolicName()
+                                + " threw an exception!");
+            SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                                              l.GetBundleContext().GetBundle(),
+                                              message,
+                                              std::current_exception()));
+        }
+    }
+
+    std::shared_ptr<ServiceEventDispatcher>
+    ServiceListeners::GetEventDispatcher()
+    {
+        auto l = eventDispatcher.Lock();
+        US_UNUSED(l);
+        if (!eventDispatcher.v)
+        {
+            auto const threadCount = std::min<std::size_t>(std::thread::hardware_concurrency(), 4);
+            eventDispatcher.v
+                = ServiceEventDispatcher::Create(threadCount,
+                                                 [this](ServiceListenerEntry const& listener, ServiceEvent const& evt)
+                                                 { DeliverServiceEvent(listener, evt); });
+        }
+        return eventDispatcher.v;
+    }
+
+    void
+    ServiceListeners::RemoveFromEventDispatcher(ServiceListenerEntry const& sle)
+    {
+        std::shared_ptr<ServiceEventDispatcher> dispatcher;
+        eventDispatcher.Lock(), dispatcher = eventDispatcher.v;
+        if (dispatcher)
+        {
+            dispatcher->Remove(sle);
+        }
+    }
+
+    void
+    ServiceListeners::StopEventDispatcher()
+    {
+        // Do not hold the lock while the pending events are delivered. A
+        // listener may cause new events, which start a new dispatcher.
+        for (;;)
+        {
+            std::shared_ptr<ServiceEventDispatcher> dispatcher;
+            eventDispatcher.Lock(), dispatcher.swap(eventDispatcher.v);
+            if (!dispatcher)
             {
-                try
-                {
-                    ++n;
-                    l.CallDelegate(evt);
-                }
-                catch (...)
-                {
-                    std::string message("Service listener in " + l.GetBundleContext().GetBundle().GetSymbolicName()
-                                        + " threw an exception!");
-                    SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
-                                                      l.GetBundleContext().GetBundle(),
-                                                      message,
-                                                      std::current_exception()));
-                }
+                return;
             }
+            dispatcher->Shutdown();
         }
     }
 
     void
     ServiceListeners::GetMatchingServiceListeners(ServiceEvent const& evt, ServiceListenerEntries& set)
     {
-        // Filter the original set of listeners
-        ServiceListenerEntries receivers = (this->Lock(), serviceSet);
-        // This must not be called with any locks held
-        coreCtx->serviceHooks.FilterServiceEventReceivers(evt, receivers);
+        // Filter the original set of listeners. Without event listener hooks all
+        // listeners are receivers, so avoid copying them for every event.
+        ServiceListenerEntries receivers;
+        ServiceListenerEntries const* filteredReceivers = nullptr;
+        if (coreCtx->serviceHooks.HasServiceEventListenerHooks())
+        {
+            receivers = (this->Lock(), serviceSet);
+            // This must not be called with any locks held
+            coreCtx->serviceHooks.FilterServiceEventReceivers(evt, receivers);
+            filteredReceivers = &receivers;
+        }
 
         // Get a copy of the service reference and keep it until we are
         // done with its properties.
         auto ref = evt.GetServiceReference();
         auto props = ref.d.load()->GetProperties();
 
+        std::uint64_t evaluations = 0;
         {
             auto l = this->Lock();
             US_UNUSED(l);
             // Check complicated or empty listener filters
             for (auto& sse : complicatedListeners)
             {
-                if (receivers.count(sse) == 0)
+                if (filteredReceivers && filteredReceivers->count(sse) == 0)
                     continue;
                 LDAPExpr const& ldapExpr = sse.GetLDAPExpr();
-                if (ldapExpr.IsNull() || ldapExpr.Evaluate(props, false))
+                if (!ldapExpr.IsNull())
                 {
-                    set.insert(sse);
+                    ++evaluations;
+                    if (!ldapExpr.Evaluate(props, false))
+                    {
+                        continue;
+                    }
                 }
+                set.insert(sse);
             }
 
             // Check the cache
             auto const& c = ref_any_cast<std::vector<std::string>>(props->ValueByRef_unlocked(Constants::OBJECTCLASS));
             for (auto& objClass : c)
             {
-                AddToSet_unlocked(set, receivers, OBJECTCLASS_IX, objClass);
+                AddToSet_unlocked(set, filteredReceivers, OBJECTCLASS_IX, objClass);
             }
 
             auto service_id = any_cast<long>(props->Value_unlocked(Constants::SERVICE_ID).first);
-            AddToSet_unlocked(set, receivers, SERVICE_ID_IX, cppmicroservices::util::ToString((service_id)));
+            AddToSet_unlocked(set, filteredReceivers, SERVICE_ID_IX, cppmicroservices::util::ToString((service_id)));
+
+            // Check listeners indexed by an equality term of their filter
+            evaluations += AddIndexedToSet_unlocked(set, filteredReceivers, props);
+        }
+        if (metrics && evaluations != 0)
+        {
+            metrics->CountFilterEvaluations(evaluations);
         }
     }
 
@@ -523,7 +642,7 @@ namespace cppmicroservices
                 }
             }
         }
-        else
+        else if (!RemoveFromTermIndex_unlocked(sle))
         {
             complicatedListeners.remove(sle);
         }
@@ -553,7 +672,7 @@ namespace cppmicroservices
                     }
                 }
             }
-            else
+            else if (!AddToTermIndex_unlocked(sle))
             {
                 complicatedListeners.push_back(sle);
             }
@@ -562,7 +681,7 @@ namespace cppmicroservices
 
     void
     ServiceListeners::AddToSet_unlocked(ServiceListenerEntries& set,
-                                        ServiceListenerEntries const& receivers,
+                                        ServiceListenerEntries const* receivers,
                                         int cache_ix,
                                         std::string const& val)
     {
@@ -574,7 +693,7 @@ namespace cppmicroservices
             {
                 for (ServiceListenerEntry const& entry : l)
                 {
-                    if (receivers.count(entry))
+                    if (!receivers || receivers->count(entry))
                     {
                         set.insert(entry);
                     }
@@ -582,6 +701,149 @@ namespace cppmicroservices
             }
         }
     }
+
+    bool
+    ServiceListeners::AddToTermIndex_unlocked(ServiceListenerEntry const& sle)
+    {
+        std::vector<LDAPExpr::EqualityTerm> terms;
+        if (!sle.GetLDAPExpr().GetConjunctiveEqualityTerms(terms))
+        {
+            return false;
+        }
+
+        // Prefer the most selective term seen so far
+        LDAPExpr::EqualityTerm const* best = nullptr;
+        std::size_t bestCount = std::numeric_limits<std::size_t>::max();
+        for (auto const& term : terms)
+        {
+            std::size_t count = 0;
+            auto attrItr = termIndex.find(term.first);
+            if (attrItr != termIndex.end())
+            {
+                auto valueItr = attrItr->second.values.find(term.second);
+                if (valueItr != attrItr->second.values.end())
+                {
+                    count = valueItr->second.size();
+                }
+            }
+            if (count < bestCount)
+            {
+                best = &term;
+                bestCount = count;
+            }
+        }
+
+        auto& entry = termIndex[best->first];
+        entry.keyHash = detail::CaseFoldedHash(best->first);
+        entry.values[best->second].insert(sle);
+        return true;
+    }
+
+    bool
+    ServiceListeners::RemoveFromTermIndex_unlocked(ServiceListenerEntry const& sle)
+    {
+        std::vector<LDAPExpr::EqualityTerm> terms;
+        if (!sle.GetLDAPExpr().GetConjunctiveEqualityTerms(terms))
+        {
+            return false;
+        }
+
+        for (auto const& term : terms)
+        {
+            auto attrItr = termIndex.find(term.first);
+            if (attrItr == termIndex.end())
+            {
+                continue;
+            }
+            auto& values = attrItr->second.values;
+            auto valueItr = values.find(term.second);
+            if (valueItr != values.end() && valueItr->second.erase(sle) != 0)
+            {
+                if (valueItr->second.empty())
+                {
+                    values.erase(valueItr);
+                    if (values.empty())
+                    {
+                        termIndex.erase(attrItr);
+                    }
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::uint64_t
+    ServiceListeners::AddIndexedToSet_unlocked(ServiceListenerEntries& set,
+                                               ServiceListenerEntries const* receivers,
+                                               PropertiesHandle const& props)
+    {
+        std::uint64_t evaluations = 0;
+        auto addMatching = [&](std::set<ServiceListenerEntry> const& sles)
+        {
+            for (ServiceListenerEntry const& sle : sles)
+            {
+                if (receivers && receivers->count(sle) == 0)
+                {
+                    continue;
+                }
+                ++evaluations;
+                if (sle.GetLDAPExpr().Evaluate(props, false))
+                {
+                    set.insert(sle);
+                }
+            }
+        };
+
+        for (auto const& [attrName, entry] : termIndex)
+        {
+            Any const& value = props->ValueByRef_unlocked(attrName, entry.keyHash, false);
+            if (value.Empty())
+            {
+                // No filter with an equality term on a missing property can match
+                continue;
+            }
+
+            auto const& values = entry.values;
+            auto addForString = [&](std::string const& str)
+            {
+                if (auto valueItr = values.find(str); valueItr != values.end())
+                {
+                    addMatching(valueItr->second);
+                }
+            };
+
+            // String comparisons of equality terms without wildcards are exact, so
+            // only the listeners indexed by the value itself can match. For other
+            // types, fall back to evaluating all listeners indexed by this attribute.
+            if (value.Type() == typeid(std::string))
+            {
+                addForString(ref_any_cast<std::string>(value));
+            }
+            else if (value.Type() == typeid(std::vector<std::string>))
+            {
+                for (auto const& str : ref_any_cast<std::vector<std::string>>(value))
+                {
+                    addForString(str);
+                }
+            }
+            else if (value.Type() == typeid(std::list<std::string>))
+            {
+                for (auto const& str : ref_any_cast<std::list<std::string>>(value))
+                {
+                    addForString(str);
+                }
+            }
+            else
+            {
+                for (auto const& valueAndListeners : values)
+                {
+                    addMatching(valueAndListeners.second);
+                }
+            }
+        }
+        return evaluations;
+    }
 } // namespace cppmicroservices
 
 US_MSVC_POP_WARNING
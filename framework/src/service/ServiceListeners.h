@@ -28,6 +28,7 @@
 
 #include "ServiceListenerEntry.h"
 
+#include <cstdint>
 #include <list>
 #include <mutex>
 #include <set>
@@ -41,6 +42,9 @@ namespace cppmicroservices
 
     class CoreBundleContext;
     class BundleContextPrivate;
+    class PropertiesHandle;
+    class ServiceEventDispatcher;
+    class ServiceRegistryMetricsCollector;
 
     /**
      * Here we handle all listeners that bundles have registered.
@@ -81,6 +85,17 @@ namespace cppmicroservices
         /* Service listeners with complicated or empty filters */
         std::list<ServiceListenerEntry> complicatedListeners;
 
+        /* Listeners with complicated filters which contain equality terms
+         * (see LDAPExpr::GetConjunctiveEqualityTerms), indexed by one of those
+         * terms. A listener can only match services satisfying that term.
+         */
+        struct TermIndexEntry
+        {
+            std::size_t keyHash;
+            std::unordered_map<std::string, std::set<ServiceListenerEntry>> values;
+        };
+        std::unordered_map<std::string, TermIndexEntry> termIndex;
+
         /* Service listeners with "simple" filters are cached. */
         CacheType cache[2];
 
@@ -88,8 +103,21 @@ namespace cppmicroservices
 
         CoreBundleContext* coreCtx;
 
+        /* The service registry metrics, or null if they are disabled. */
+        ServiceRegistryMetricsCollector* const metrics;
+
+        /* Deliver service events on the dispatcher threads, see
+         * Constants::FRAMEWORK_SERVICE_EVENTS_ASYNC. */
+        bool asyncServiceEvents;
+
+        struct : detail::MultiThreaded<>
+        {
+            std::shared_ptr<ServiceEventDispatcher> v;
+        } eventDispatcher;
+
       public:
         ServiceListeners(CoreBundleContext* coreCtx);
+        ~ServiceListeners();
 
         void Clear();
 
@@ -237,11 +265,37 @@ namespace cppmicroservices
          */
         void CheckSimple_unlocked(ServiceListenerEntry const& sle);
 
+        /**
+         * Adds the cached listeners for the given key and value to set. If
+         * receivers is not null, only listeners contained in it are added.
+         */
         void AddToSet_unlocked(ServiceListenerEntries& set,
-                               ServiceListenerEntries const& receivers,
+                               ServiceListenerEntries const* receivers,
                                int cache_ix,
                                std::string const& val);
 
+        /**
+         * Adds a listener with a complicated filter to the term index, using
+         * the equality term of its filter with the fewest listeners indexed
+         * so far. Returns false if the filter has no equality terms.
+         */
+        bool AddToTermIndex_unlocked(ServiceListenerEntry const& sle);
+
+        /**
+         * Removes a listener from the term index. Returns false if the
+         * listener was not indexed.
+         */
+        bool RemoveFromTermIndex_unlocked(ServiceListenerEntry const& sle);
+
+        /**
+         * Adds the listeners of the term index whose filters match the
+         * properties to set, restricted to receivers if it is not null.
+         * Returns the number of filters evaluated.
+         */
+        std::uint64_t AddIndexedToSet_unlocked(ServiceListenerEntries& set,
+                                      ServiceListenerEntries const* receivers,
+                                      PropertiesHandle const& props);
+
         /**
          * Removes service listeners registered using the legacy
          * service listener registration mechanism. This
@@ -253,6 +307,37 @@ namespace cppmicroservices
         void RemoveLegacyServiceListenerAndNotifyHooks(std::shared_ptr<BundleContextPrivate> const& context,
                                                        ServiceListener const& listener,
                                                        void* data);
+
+        /**
+         * Calls the service listener l, reporting exceptions as framework
+         * error events. Does nothing if l has been removed.
+         */
+        void DeliverServiceEvent(ServiceListenerEntry const& l, ServiceEvent const& evt);
+
+        //! Get the dispatcher for asynchronous delivery, starting it if necessary.
+        std::shared_ptr<ServiceEventDispatcher> GetEventDispatcher();
+
+        //! Drop the pending asynchronous events of a removed listener.
+        void RemoveFromEventDispatcher(ServiceListenerEntry const& sle);
+
+        //! Deliver the pending asynchronous events and stop the dispatcher.
+        void StopEventDispatcher();
+
+        /**
+         * Lock the listeners. Hides MultiThreaded::Lock() to record the
+         * wait for the lock when metrics are enabled.
+         */
+        UniqueLock
+        Lock() const
+        {
+            if (metrics == nullptr)
+            {
+                return MultiThreaded::Lock();
+            }
+            return TimedLock();
+        }
+
+        UniqueLock TimedLock() const;
     };
 } // namespace cppmicroservices
 
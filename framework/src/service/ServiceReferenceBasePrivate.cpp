@@ -152,8 +152,13 @@ namespace cppmicroservices
             {
                 auto factory = std::static_pointer_cast<ServiceFactory>(
                     registration->GetService("org.cppmicroservices.factory"));
-                s = GetServiceFromFactory(GetPrivate(bundle).get(), factory);
-                registration->Lock(), registration->prototypeServiceInstances[GetPrivate(bundle).get()].push_back(s);
+                auto b = GetPrivate(bundle).get();
+                s = GetServiceFromFactory(b, factory);
+                auto l = registration->Lock();
+                US_UNUSED(l);
+                bool const wasUsed = registration->IsUsedByBundle_unlocked(b);
+                registration->prototypeServiceInstances[b].push_back(s);
+                registration->UpdateUsesIndex_unlocked(b, wasUsed);
             }
         }
         return s;
@@ -210,8 +215,10 @@ namespace cppmicroservices
             serviceFactory = std::static_pointer_cast<ServiceFactory>(
                 registration->GetService_unlocked("org.cppmicroservices.factory"));
 
+            bool const wasUsed = registration->IsUsedByBundle_unlocked(bundle);
             auto res = registration->dependents.insert(std::make_pair(bundle, 0));
             auto& depCounter = res.first->second;
+            registration->UpdateUsesIndex_unlocked(bundle, wasUsed);
 
             // No service factory, just return the registered service directly.
             if (!serviceFactory)
@@ -264,7 +271,9 @@ namespace cppmicroservices
         auto l = registration->Lock();
         US_UNUSED(l);
 
+        bool const wasUsed = registration->IsUsedByBundle_unlocked(bundle);
         registration->dependents.insert(std::make_pair(bundle, 0));
+        registration->UpdateUsesIndex_unlocked(bundle, wasUsed);
 
         if (s && !s->empty())
         {
@@ -347,6 +356,7 @@ namespace cppmicroservices
                 if (iter->second.empty())
                 {
                     registration->prototypeServiceInstances.erase(iter);
+                    registration->UpdateUsesIndex_unlocked(bundle.get(), true);
                 }
                 return true;
             }
@@ -409,6 +419,7 @@ namespace cppmicroservices
                 }
                 registration->bundleServiceInstance.erase(bundle.get());
                 registration->dependents.erase(bundle.get());
+                registration->UpdateUsesIndex_unlocked(bundle.get(), true);
             }
         }
 
@@ -316,6 +316,18 @@ namespace cppmicroservices
             auto l = d->Lock();
             US_UNUSED(l);
 
+            if (auto bundle = d->bundle.lock())
+            {
+                for (auto const& dependent : d->dependents)
+                {
+                    bundle->coreCtx->services.RemoveUsingBundle(dependent.first, d);
+                }
+                for (auto const& prototypeInstances : d->prototypeServiceInstances)
+                {
+                    bundle->coreCtx->services.RemoveUsingBundle(prototypeInstances.first, d);
+                }
+            }
+
             d->bundle.reset();
             d->dependents.clear();
             d->service.reset();
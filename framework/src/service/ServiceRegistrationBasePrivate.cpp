@@ -22,6 +22,7 @@
 
 #include "ServiceRegistrationBasePrivate.h"
 #include "BundlePrivate.h"
+#include "CoreBundleContext.h"
 
 #include <utility>
 
@@ -43,9 +44,11 @@ namespace cppmicroservices
         , properties(std::move(props))
         , available(true)
         , unregistering(false)
+        , registrySlot(npos)
     {
         // The reference counter is initialized to 0 because it will be
         // incremented by the "reference" member.
+        properties.SetMetrics(bundle_->coreCtx->registryMetrics);
     }
 
     ServiceRegistrationBasePrivate::~ServiceRegistrationBasePrivate()
@@ -56,12 +59,38 @@ namespace cppmicroservices
     bool
     ServiceRegistrationBasePrivate::IsUsedByBundle(BundlePrivate* bundle) const
     {
-        auto l = this->Lock();
-        US_UNUSED(l);
+        return this->Lock(), IsUsedByBundle_unlocked(bundle);
+    }
+
+    bool
+    ServiceRegistrationBasePrivate::IsUsedByBundle_unlocked(BundlePrivate* bundle) const
+    {
         return (dependents.find(bundle) != dependents.end())
                || (prototypeServiceInstances.find(bundle) != prototypeServiceInstances.end());
     }
 
+    void
+    ServiceRegistrationBasePrivate::UpdateUsesIndex_unlocked(BundlePrivate* user, bool wasUsed)
+    {
+        bool const isUsed = IsUsedByBundle_unlocked(user);
+        if (isUsed == wasUsed)
+        {
+            return;
+        }
+
+        if (auto owner = bundle.lock())
+        {
+            if (isUsed)
+            {
+                owner->coreCtx->services.AddUsingBundle(user, this);
+            }
+            else
+            {
+                owner->coreCtx->services.RemoveUsingBundle(user, this);
+            }
+        }
+    }
+
     InterfaceMapConstPtr
     ServiceRegistrationBasePrivate::GetInterfaces() const
     {
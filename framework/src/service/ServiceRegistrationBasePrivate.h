@@ -115,6 +115,15 @@ namespace cppmicroservices
          */
         std::atomic<bool> unregistering;
 
+        /**
+         * Position of this registration in ServiceRegistry::serviceRegistrations,
+         * or <code>npos</code> if the service is not (or no longer) registered.
+         * Guarded by the service registry lock.
+         */
+        std::size_t registrySlot;
+
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
         ServiceRegistrationBasePrivate(BundlePrivate* bundle, InterfaceMapConstPtr service, Properties&& props);
 
         ~ServiceRegistrationBasePrivate();
@@ -127,6 +136,18 @@ namespace cppmicroservices
          */
         bool IsUsedByBundle(BundlePrivate* bundle) const;
 
+        bool IsUsedByBundle_unlocked(BundlePrivate* bundle) const;
+
+        /**
+         * Update the per-bundle "uses" index of the service registry after
+         * the dependents or prototype service instances for a bundle changed.
+         * The caller must hold the lock of this object.
+         *
+         * @param bundle The bundle whose usage changed
+         * @param wasUsed Whether the bundle used this service before the change
+         */
+        void UpdateUsesIndex_unlocked(BundlePrivate* bundle, bool wasUsed);
+
         InterfaceMapConstPtr GetInterfaces() const;
 
         std::shared_ptr<void> GetService(std::string const& interfaceId) const;
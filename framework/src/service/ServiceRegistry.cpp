@@ -23,12 +23,17 @@
 #include "ServiceRegistry.h"
 
 #include "cppmicroservices/PrototypeServiceFactory.h"
+#include "cppmicroservices/ServiceEventListenerHook.h"
 #include "cppmicroservices/ServiceFactory.h"
+#include "cppmicroservices/ServiceFindHook.h"
 
 #include "BundlePrivate.h"
 #include "CoreBundleContext.h"
+#include "LDAPExprCache.h"
+#include "PropsCheck.h"
 #include "ServiceRegistrationBasePrivate.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <stdexcept>
@@ -36,14 +41,45 @@
 namespace cppmicroservices
 {
 
+    namespace
+    {
+        // Empty slots are only compacted above this size, to avoid
+        // repeatedly compacting small vectors.
+        constexpr std::size_t MIN_COMPACTION_SIZE = 32;
+    } // namespace
+
     void
     ServiceRegistry::Clear()
     {
-        auto l = this->Lock();
-        US_UNUSED(l);
-        services.clear();
-        classServices.clear();
-        serviceRegistrations.clear();
+        {
+            auto l = this->Lock();
+            US_UNUSED(l);
+            for (auto& sr : serviceRegistrations)
+            {
+                if (sr)
+                {
+                    sr.d->registrySlot = ServiceRegistrationBasePrivate::npos;
+                }
+            }
+            services.clear();
+            classServices.clear();
+            classTombstones.clear();
+            serviceRegistrations.clear();
+            registrationTombstones = 0;
+            bundleServices.clear();
+            std::vector<std::string> classes;
+            classes.reserve(snapshotEntries.size());
+            for (auto const& classAndEntry : snapshotEntries)
+            {
+                classes.push_back(classAndEntry.first);
+            }
+            Modified_unlocked(classes);
+            hasFindHooks = false;
+            hasEventListenerHooks = false;
+            hookSet.Store(nullptr);
+        }
+
+        bundleUses.Lock(), bundleUses.uses.clear();
     }
 
     Properties
@@ -54,32 +90,297 @@ namespace cppmicroservices
                                              long sid)
     {
         static std::atomic<long> nextServiceID(1);
-        ServiceProperties props(in);
+
+        // Build the flat map Properties use directly instead of copying into another
+        // ServiceProperties first. Like inserting into a ServiceProperties, this keeps
+        // values the caller set for the keys below.
+        AnyMap props(AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS);
+        props.reserve(in.size() + 3);
+        for (auto const& [key, value] : in)
+        {
+            props_check::InsertCaseChecked(props, key, value);
+        }
 
         if (!classes.empty())
         {
-            props.insert(std::make_pair(Constants::OBJECTCLASS, classes));
+            props_check::InsertCaseChecked(props, Constants::OBJECTCLASS, classes);
         }
 
-        props.insert(std::make_pair(Constants::SERVICE_ID, sid != -1 ? sid : nextServiceID++));
+        props_check::InsertCaseChecked(props, Constants::SERVICE_ID, sid != -1 ? sid : nextServiceID++);
 
         if (isPrototypeFactory)
         {
-            props.insert(std::make_pair(Constants::SERVICE_SCOPE, Constants::SCOPE_PROTOTYPE));
+            props_check::InsertCaseChecked(props, Constants::SERVICE_SCOPE, Constants::SCOPE_PROTOTYPE);
         }
         else if (isFactory)
         {
-            props.insert(std::make_pair(Constants::SERVICE_SCOPE, Constants::SCOPE_BUNDLE));
+            props_check::InsertCaseChecked(props, Constants::SERVICE_SCOPE, Constants::SCOPE_BUNDLE);
+        }
+        else
+        {
+            props_check::InsertCaseChecked(props, Constants::SERVICE_SCOPE, Constants::SCOPE_SINGLETON);
+        }
+
+        return Properties(std::move(props));
+    }
+
+    ServiceRegistry::ServiceRegistry(CoreBundleContext* coreCtx)
+        : core(coreCtx)
+        , generation(std::make_shared<std::atomic<std::uint64_t>>(1))
+        , metrics(coreCtx->registryMetrics.get())
+        , useSnapshots(false)
+        , snapshotRegistrations(std::make_shared<SnapshotEntry>(std::string()))
+        , hasFindHooks(false)
+        , hasEventListenerHooks(false)
+        , registrationTombstones(0)
+    {
+        auto snapshotProp = core->frameworkProperties.find(Constants::FRAMEWORK_SERVICE_REGISTRY_SNAPSHOT);
+        if (snapshotProp != core->frameworkProperties.end() && snapshotProp->second.Type() == typeid(bool))
+        {
+            useSnapshots = any_cast<bool>(snapshotProp->second);
+        }
+    }
+
+    ServiceRegistry::UniqueLock
+    ServiceRegistry::TimedLock() const
+    {
+        UniqueLock l(*this, std::defer_lock);
+        metrics->Acquire(ServiceRegistryMetricsCollector::LockKind::ServiceRegistry, l);
+        return l;
+    }
+
+    std::shared_ptr<ServiceRegistry::Snapshot const>
+    ServiceRegistry::GetSnapshot() const
+    {
+        auto snap = snapshot.Load();
+        if (!snap)
+        {
+            auto l = this->Lock();
+            US_UNUSED(l);
+            // another thread may have published a snapshot while we were waiting
+            snap = snapshot.Load();
+            if (!snap)
+            {
+                auto newSnap = std::make_shared<Snapshot>();
+                newSnap->classServices = snapshotEntries;
+                snap = std::move(newSnap);
+                snapshot.Store(snap);
+            }
+        }
+        return snap;
+    }
+
+    std::shared_ptr<std::vector<ServiceRegistrationBase> const>
+    ServiceRegistry::GetSnapshotRegistrations(SnapshotEntry& entry) const
+    {
+        auto regs = entry.registrations.Load();
+        if (!regs)
+        {
+            auto l = this->Lock();
+            US_UNUSED(l);
+            regs = entry.registrations.Load();
+            if (!regs)
+            {
+                // snapshots only contain registered services
+                auto newRegs = std::make_shared<std::vector<ServiceRegistrationBase>>();
+                if (entry.clazz.empty())
+                {
+                    newRegs->reserve(serviceRegistrations.size() - registrationTombstones);
+                    std::copy_if(serviceRegistrations.begin(),
+                                 serviceRegistrations.end(),
+                                 std::back_inserter(*newRegs),
+                                 IsRegistered_unlocked);
+                }
+                else
+                {
+                    auto i = classServices.find(entry.clazz);
+                    if (i != classServices.end())
+                    {
+                        newRegs->reserve(i->second.size());
+                        std::copy_if(i->second.begin(),
+                                     i->second.end(),
+                                     std::back_inserter(*newRegs),
+                                     IsRegistered_unlocked);
+                    }
+                }
+                regs = std::move(newRegs);
+                entry.registrations.Store(regs);
+            }
+        }
+        return regs;
+    }
+
+    void
+    ServiceRegistry::InvalidateSnapshot_unlocked(std::vector<std::string> const& classes)
+    {
+        if (!useSnapshots)
+        {
+            return;
+        }
+        snapshotRegistrations->registrations.Store(nullptr);
+        for (auto const& clazz : classes)
+        {
+            if (classServices.count(clazz) == 0)
+            {
+                // the last service of the class is gone, publish a map without it
+                if (snapshotEntries.erase(clazz) > 0)
+                {
+                    snapshot.Store(nullptr);
+                }
+                continue;
+            }
+            auto& entry = snapshotEntries[clazz];
+            if (entry)
+            {
+                entry->registrations.Store(nullptr);
+            }
+            else
+            {
+                // a new class, publish a new map on the next lookup
+                entry = std::make_shared<SnapshotEntry>(clazz);
+                snapshot.Store(nullptr);
+            }
+        }
+    }
+
+    void
+    ServiceRegistry::UpdateHookSet_unlocked(std::vector<std::string> const& classes)
+    {
+        static std::string const findHookClass = us_service_interface_iid<ServiceFindHook>();
+        static std::string const eventListenerHookClass = us_service_interface_iid<ServiceEventListenerHook>();
+
+        if (std::none_of(classes.begin(),
+                         classes.end(),
+                         [](std::string const& clazz)
+                         { return clazz == findHookClass || clazz == eventListenerHookClass; }))
+        {
+            return;
+        }
+
+        auto newHookSet = std::make_shared<HookSet>();
+        auto copyHooks = [this](std::string const& clazz, std::vector<ServiceRegistrationBase>& hooks)
+        {
+            auto i = classServices.find(clazz);
+            if (i != classServices.end())
+            {
+                std::copy_if(i->second.begin(), i->second.end(), std::back_inserter(hooks), IsRegistered_unlocked);
+            }
+        };
+        copyHooks(findHookClass, newHookSet->findHooks);
+        copyHooks(eventListenerHookClass, newHookSet->eventListenerHooks);
+
+        // Readers check the flags first, so publish the set before setting them
+        hookSet.Store(newHookSet);
+        hasFindHooks = !newHookSet->findHooks.empty();
+        hasEventListenerHooks = !newHookSet->eventListenerHooks.empty();
+    }
+
+    void
+    ServiceRegistry::FilterServiceReferences(BundlePrivate* bundle,
+                                             std::string const& clazz,
+                                             std::string const& filter,
+                                             std::vector<ServiceReferenceBase>& res) const
+    {
+        if (res.empty() || !hasFindHooks)
+        {
+            return;
+        }
+
+        if (bundle != nullptr)
+        {
+            auto ctx = bundle->bundleContext.Load();
+            core->serviceHooks.FilterServiceReferences(ctx.get(), clazz, filter, res);
         }
         else
         {
-            props.insert(std::make_pair(Constants::SERVICE_SCOPE, Constants::SCOPE_SINGLETON));
+            core->serviceHooks.FilterServiceReferences(nullptr, clazz, filter, res);
+        }
+    }
+
+    void
+    ServiceRegistry::Modified_unlocked(std::vector<std::string> const& classes)
+    {
+        generation->fetch_add(1, std::memory_order_acq_rel);
+        InvalidateSnapshot_unlocked(classes);
+    }
+
+    long
+    ServiceRegistry::GetServiceId(ServiceRegistrationBase const& sr)
+    {
+        auto l = sr.d->properties.Lock();
+        US_UNUSED(l);
+        return any_cast<long>(sr.d->properties.Value_unlocked(Constants::SERVICE_ID).first);
+    }
+
+    bool
+    ServiceRegistry::IsRegistered_unlocked(ServiceRegistrationBase const& sr)
+    {
+        return sr && sr.d->registrySlot != ServiceRegistrationBasePrivate::npos;
+    }
+
+    void
+    ServiceRegistry::CompactRegistrations_unlocked()
+    {
+        if (serviceRegistrations.size() < MIN_COMPACTION_SIZE
+            || registrationTombstones * 2 < serviceRegistrations.size())
+        {
+            return;
+        }
+
+        std::size_t slot = 0;
+        for (std::size_t i = 0; i < serviceRegistrations.size(); ++i)
+        {
+            if (serviceRegistrations[i])
+            {
+                serviceRegistrations[i].d->registrySlot = slot;
+                if (slot != i)
+                {
+                    serviceRegistrations[slot] = serviceRegistrations[i];
+                }
+                ++slot;
+            }
+        }
+        serviceRegistrations.erase(serviceRegistrations.begin() + slot, serviceRegistrations.end());
+        registrationTombstones = 0;
+    }
+
+    void
+    ServiceRegistry::RemoveClassTombstones_unlocked(std::string const& clazz,
+                                                    std::vector<ServiceRegistrationBase>& regs)
+    {
+        auto iter = classTombstones.find(clazz);
+        if (iter == classTombstones.end() || iter->second == 0)
+        {
+            return;
         }
+        regs.erase(std::remove_if(regs.begin(),
+                                  regs.end(),
+                                  [](ServiceRegistrationBase const& reg) { return !IsRegistered_unlocked(reg); }),
+                   regs.end());
+        classTombstones.erase(iter);
+    }
 
-        return Properties(AnyMap(std::move(props)));
+    void
+    ServiceRegistry::AddUsingBundle(BundlePrivate* bundle, ServiceRegistrationBasePrivate* registration)
+    {
+        bundleUses.Lock(), bundleUses.uses[bundle].insert(ServiceRegistrationBase(registration));
     }
 
-    ServiceRegistry::ServiceRegistry(CoreBundleContext* coreCtx) : core(coreCtx) {}
+    void
+    ServiceRegistry::RemoveUsingBundle(BundlePrivate* bundle, ServiceRegistrationBasePrivate* registration)
+    {
+        auto l = bundleUses.Lock();
+        US_UNUSED(l);
+        auto iter = bundleUses.uses.find(bundle);
+        if (iter != bundleUses.uses.end())
+        {
+            iter->second.erase(ServiceRegistrationBase(registration));
+            if (iter->second.empty())
+            {
+                bundleUses.uses.erase(iter);
+            }
+        }
+    }
 
     ServiceRegistrationBase
     ServiceRegistry::RegisterService(BundlePrivate* bundle,
@@ -113,16 +414,26 @@ namespace cppmicroservices
                                     service,
                                     CreateServiceProperties(properties, classes, isFactory, isPrototypeFactory));
         {
+            auto const sid = GetServiceId(res);
             auto l = this->Lock();
             US_UNUSED(l);
             services.insert(std::make_pair(res, classes));
+            res.d->registrySlot = serviceRegistrations.size();
             serviceRegistrations.push_back(res);
+            bundleServices[bundle].emplace(sid, res);
             for (auto& clazz : classes)
             {
                 auto& s = classServices[clazz];
+                RemoveClassTombstones_unlocked(clazz, s);
                 auto ip = std::lower_bound(s.rbegin(), s.rend(), res);
                 s.insert(ip.base(), res);
             }
+            UpdateHookSet_unlocked(classes);
+            Modified_unlocked(classes);
+        }
+        if (metrics)
+        {
+            metrics->CountRegistration();
         }
 
         ServiceReferenceBase r = res.GetReference(std::string());
@@ -141,35 +452,70 @@ namespace cppmicroservices
         for (auto& clazz : classes)
         {
             auto& s = classServices[clazz];
+            RemoveClassTombstones_unlocked(clazz, s);
             std::sort(s.rbegin(), s.rend());
         }
+        UpdateHookSet_unlocked(classes);
+        Modified_unlocked(classes);
     }
 
     void
     ServiceRegistry::Get(std::string const& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const
     {
+        if (useSnapshots)
+        {
+            Get_unlocked(clazz, serviceRegs);
+            return;
+        }
         this->Lock(), Get_unlocked(clazz, serviceRegs);
     }
 
     void
     ServiceRegistry::Get_unlocked(std::string const& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const
     {
+        if (useSnapshots)
+        {
+            auto snap = GetSnapshot();
+            auto i = snap->classServices.find(clazz);
+            if (i != snap->classServices.end())
+            {
+                serviceRegs = *GetSnapshotRegistrations(*i->second);
+            }
+            return;
+        }
+
         auto i = classServices.find(clazz);
         if (i != classServices.end())
         {
             serviceRegs = i->second;
+            serviceRegs.erase(std::remove_if(serviceRegs.begin(),
+                                             serviceRegs.end(),
+                                             [](ServiceRegistrationBase const& sr)
+                                             { return !IsRegistered_unlocked(sr); }),
+                              serviceRegs.end());
         }
     }
 
     ServiceReferenceBase
     ServiceRegistry::Get(BundlePrivate* bundle, std::string const& clazz) const
     {
-        auto l = this->Lock();
-        US_UNUSED(l);
+        if (metrics)
+        {
+            metrics->CountLookup(clazz, std::string());
+        }
         try
         {
             std::vector<ServiceReferenceBase> srs;
-            Get_unlocked(clazz, "", bundle, srs);
+            if (useSnapshots)
+            {
+                auto snap = GetSnapshot();
+                Get_unlocked(snap.get(), clazz, "", srs);
+            }
+            else
+            {
+                this->Lock(), Get_unlocked(nullptr, clazz, "", srs);
+            }
+            FilterServiceReferences(bundle, clazz, "", srs);
             DIAG_LOG(*core->sink) << "get service ref " << clazz << " for bundle " << bundle->symbolicName << " = "
                                   << srs.size() << " refs";
 
@@ -191,15 +537,55 @@ namespace cppmicroservices
                          BundlePrivate* bundle,
                          std::vector<ServiceReferenceBase>& res) const
     {
-        this->Lock(), Get_unlocked(clazz, filter, bundle, res);
+        if (metrics)
+        {
+            metrics->CountLookup(clazz, filter);
+        }
+        if (useSnapshots)
+        {
+            auto snap = GetSnapshot();
+            Get_unlocked(snap.get(), clazz, filter, res);
+        }
+        else
+        {
+            this->Lock(), Get_unlocked(nullptr, clazz, filter, res);
+        }
+        FilterServiceReferences(bundle, clazz, filter, res);
     }
 
     void
-    ServiceRegistry::Get_unlocked(std::string const& clazz,
+    ServiceRegistry::Get_unlocked(Snapshot const* snap,
+                                  std::string const& clazz,
                                   std::string const& filter,
-                                  BundlePrivate* bundle,
                                   std::vector<ServiceReferenceBase>& res) const
     {
+        // the registrations of a class, from the snapshot or the live structures
+        std::shared_ptr<std::vector<ServiceRegistrationBase> const> snapRegs;
+        auto findClass = [&](std::string const& className) -> std::vector<ServiceRegistrationBase> const*
+        {
+            if (snap)
+            {
+                auto i = snap->classServices.find(className);
+                if (i == snap->classServices.end())
+                {
+                    return nullptr;
+                }
+                snapRegs = GetSnapshotRegistrations(*i->second);
+                return snapRegs.get();
+            }
+            auto i = classServices.find(className);
+            return i != classServices.end() ? &i->second : nullptr;
+        };
+        auto allRegistrations = [&]() -> std::vector<ServiceRegistrationBase> const&
+        {
+            if (snap)
+            {
+                snapRegs = GetSnapshotRegistrations(*snapshotRegistrations);
+                return *snapRegs;
+            }
+            return serviceRegistrations;
+        };
+
         std::vector<ServiceRegistrationBase>::const_iterator s;
         std::vector<ServiceRegistrationBase>::const_iterator send;
         std::vector<ServiceRegistrationBase> v;
@@ -208,17 +594,16 @@ namespace cppmicroservices
         {
             if (!filter.empty())
             {
-                ldap = LDAPExpr(filter);
+                ldap = LDAPExprCache::Instance().Get(filter);
                 LDAPExpr::ObjectClassSet matched;
                 if (ldap.GetMatchedObjectClasses(matched))
                 {
                     v.clear();
                     for (auto& className : matched)
                     {
-                        auto i = classServices.find(className);
-                        if (i != classServices.end())
+                        if (auto regs = findClass(className))
                         {
-                            std::copy(i->second.begin(), i->second.end(), std::back_inserter(v));
+                            std::copy(regs->begin(), regs->end(), std::back_inserter(v));
                         }
                     }
                     if (!v.empty())
@@ -233,23 +618,24 @@ namespace cppmicroservices
                 }
                 else
                 {
-                    s = serviceRegistrations.begin();
-                    send = serviceRegistrations.end();
+                    auto const& registrations = allRegistrations();
+                    s = registrations.begin();
+                    send = registrations.end();
                 }
             }
             else
             {
-                s = serviceRegistrations.begin();
-                send = serviceRegistrations.end();
+                auto const& registrations = allRegistrations();
+                s = registrations.begin();
+                send = registrations.end();
             }
         }
         else
         {
-            auto it = classServices.find(clazz);
-            if (it != classServices.end())
+            if (auto regs = findClass(clazz))
             {
-                s = it->second.begin();
-                send = it->second.end();
+                s = regs->begin();
+                send = regs->end();
             }
             else
             {
@@ -257,29 +643,31 @@ namespace cppmicroservices
             }
             if (!filter.empty())
             {
-                ldap = LDAPExpr(filter);
+                ldap = LDAPExprCache::Instance().Get(filter);
             }
         }
 
+        std::uint64_t evaluations = 0;
         for (; s != send; ++s)
         {
-            if (filter.empty() || ldap.Evaluate(PropertiesHandle(s->d->properties, true), false))
-            {
-                res.emplace_back(s->GetReference(clazz));
-            }
-        }
-
-        if (!res.empty())
-        {
-            if (bundle != nullptr)
+            // snapshots only contain registered services
+            if (!snap && !IsRegistered_unlocked(*s))
             {
-                auto ctx = bundle->bundleContext.Load();
-                core->serviceHooks.FilterServiceReferences(ctx.get(), clazz, filter, res);
+                continue;
             }
-            else
+            if (!filter.empty())
             {
-                core->serviceHooks.FilterServiceReferences(nullptr, clazz, filter, res);
+                ++evaluations;
+                if (!ldap.Evaluate(PropertiesHandle(s->d->properties, true), false))
+                {
+                    continue;
+                }
             }
+            res.emplace_back(s->GetReference(clazz));
+        }
+        if (metrics && evaluations != 0)
+        {
+            metrics->CountFilterEvaluations(evaluations);
         }
     }
 
@@ -294,7 +682,17 @@ namespace cppmicroservices
     void
     ServiceRegistry::RemoveServiceRegistration_unlocked(ServiceRegistrationBase const& sr)
     {
+        if (!IsRegistered_unlocked(sr))
+        {
+            return;
+        }
+        if (metrics)
+        {
+            metrics->CountUnregistration();
+        }
+
         std::vector<std::string> classes;
+        long sid = 0;
         {
             auto l2 = sr.d->properties.Lock();
             US_UNUSED(l2);
@@ -302,22 +700,54 @@ namespace cppmicroservices
                    == typeid(std::vector<std::string>));
             classes
                 = ref_any_cast<std::vector<std::string>>(sr.d->properties.Value_unlocked(Constants::OBJECTCLASS).first);
+            sid = any_cast<long>(sr.d->properties.Value_unlocked(Constants::SERVICE_ID).first);
         }
         services.erase(sr);
-        serviceRegistrations.erase(std::remove(serviceRegistrations.begin(), serviceRegistrations.end(), sr),
-                                   serviceRegistrations.end());
+
+        serviceRegistrations[sr.d->registrySlot] = nullptr;
+        sr.d->registrySlot = ServiceRegistrationBasePrivate::npos;
+        ++registrationTombstones;
+        CompactRegistrations_unlocked();
+
         for (auto& clazz : classes)
         {
             auto& s = classServices[clazz];
-            if (s.size() > 1)
+            auto& tombstones = classTombstones[clazz];
+            ++tombstones;
+            if (tombstones == s.size())
+            {
+                classServices.erase(clazz);
+                classTombstones.erase(clazz);
+            }
+            else if (s.size() >= MIN_COMPACTION_SIZE && tombstones * 2 >= s.size())
+            {
+                RemoveClassTombstones_unlocked(clazz, s);
+            }
+            else if (s.size() < MIN_COMPACTION_SIZE)
             {
                 s.erase(std::remove(s.begin(), s.end(), sr), s.end());
+                --tombstones;
             }
-            else
+        }
+
+        // The registering bundle may already be gone if the framework is shutting down
+        auto bundle = sr.d->bundle.lock();
+        auto bundleIter = bundle ? bundleServices.find(bundle.get())
+                                 : std::find_if(bundleServices.begin(),
+                                                bundleServices.end(),
+                                                [sid](MapBundleServices::value_type const& bundleRegs)
+                                                { return bundleRegs.second.count(sid) > 0; });
+        if (bundleIter != bundleServices.end())
+        {
+            bundleIter->second.erase(sid);
+            if (bundleIter->second.empty())
             {
-                classServices.erase(clazz);
+                bundleServices.erase(bundleIter);
             }
         }
+
+        UpdateHookSet_unlocked(classes);
+        Modified_unlocked(classes);
     }
 
     void
@@ -326,14 +756,13 @@ namespace cppmicroservices
         auto l = this->Lock();
         US_UNUSED(l);
 
-        for (auto& sr : serviceRegistrations)
+        auto iter = bundleServices.find(p);
+        if (iter != bundleServices.end())
         {
-            if (auto bundle_ = sr.d->bundle.lock())
+            res.reserve(res.size() + iter->second.size());
+            for (auto const& idAndReg : iter->second)
             {
-                if (bundle_.get() == p)
-                {
-                    res.push_back(sr);
-                }
+                res.push_back(idAndReg.second);
             }
         }
     }
@@ -341,15 +770,34 @@ namespace cppmicroservices
     void
     ServiceRegistry::GetUsedByBundle(BundlePrivate* bundle, std::vector<ServiceRegistrationBase>& res) const
     {
-        auto l = this->Lock();
-        US_UNUSED(l);
+        std::vector<ServiceRegistrationBase> used;
+        {
+            auto l = bundleUses.Lock();
+            US_UNUSED(l);
+            auto iter = bundleUses.uses.find(bundle);
+            if (iter == bundleUses.uses.end())
+            {
+                return;
+            }
+            used.assign(iter->second.begin(), iter->second.end());
+        }
 
-        for (auto const& serviceRegistration : serviceRegistrations)
+        // report the services in registration order
+        std::vector<std::pair<long, ServiceRegistrationBase>> ordered;
+        ordered.reserve(used.size());
+        for (auto& sr : used)
         {
-            if (serviceRegistration.d->IsUsedByBundle(bundle))
+            if (sr.d->available && sr.d->IsUsedByBundle(bundle))
             {
-                res.push_back(serviceRegistration);
+                ordered.emplace_back(GetServiceId(sr), std::move(sr));
             }
         }
+        std::sort(ordered.begin(),
+                  ordered.end(),
+                  [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+        for (auto& idAndReg : ordered)
+        {
+            res.push_back(std::move(idAndReg.second));
+        }
     }
 } // namespace cppmicroservices
@@ -27,12 +27,20 @@
 #include "cppmicroservices/ServiceRegistration.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace cppmicroservices
 {
 
     class CoreBundleContext;
     class BundlePrivate;
     class Properties;
+    class ServiceRegistrationBasePrivate;
+    class ServiceRegistryMetricsCollector;
 
     /**
      * Here we handle all the CppMicroServices services that are registered.
@@ -60,6 +68,8 @@ namespace cppmicroservices
 
         using MapServiceClasses = std::unordered_map<ServiceRegistrationBase, std::vector<std::string>>;
         using MapClassServices = std::unordered_map<std::string, std::vector<ServiceRegistrationBase>>;
+        using MapBundleServices = std::unordered_map<BundlePrivate*, std::map<long, ServiceRegistrationBase>>;
+        using MapBundleUses = std::unordered_map<BundlePrivate*, std::unordered_set<ServiceRegistrationBase>>;
 
         /**
          * All registered services in the current framework.
@@ -68,17 +78,36 @@ namespace cppmicroservices
          */
         MapServiceClasses services;
 
+        /**
+         * All registered services in registration order. Each registration
+         * knows its slot in this vector (ServiceRegistrationBasePrivate::registrySlot),
+         * so unregistering leaves an empty slot behind instead of shifting the
+         * vector. Empty slots are compacted once they outnumber the live ones.
+         */
         std::vector<ServiceRegistrationBase> serviceRegistrations;
 
         /**
          * Mapping of classname to registered service.
          * The List of registered services are ordered with the highest
-         * ranked service first.
+         * ranked service first. Unregistered services are removed lazily,
+         * see classTombstones.
          */
         MapClassServices classServices;
 
+        /**
+         * Services registered by each bundle, keyed by service id.
+         */
+        MapBundleServices bundleServices;
+
         CoreBundleContext* core;
 
+        /**
+         * Advanced on every change of the registered services or their
+         * ranking. Starts at 1 and is shared with ServiceHandle objects,
+         * which may outlive the registry.
+         */
+        std::shared_ptr<std::atomic<std::uint64_t>> const generation;
+
         ServiceRegistry(ServiceRegistry const&) = delete;
         ServiceRegistry& operator=(ServiceRegistry const&) = delete;
 
@@ -166,17 +195,202 @@ namespace cppmicroservices
          */
         void GetUsedByBundle(BundlePrivate* bundle, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
+        /**
+         * Record that a bundle started or stopped using a service. Called
+         * when the dependents or prototype service instances of a service
+         * registration change.
+         *
+         * @param bundle The using bundle
+         * @param registration The registration of the used service
+         */
+        void AddUsingBundle(BundlePrivate* bundle, ServiceRegistrationBasePrivate* registration);
+        void RemoveUsingBundle(BundlePrivate* bundle, ServiceRegistrationBasePrivate* registration);
+
       private:
         friend class ServiceHooks;
         friend class ServiceRegistrationBase;
 
+        /**
+         * The metrics of this registry, or null if they are disabled, see
+         * Constants::FRAMEWORK_SERVICE_REGISTRY_METRICS.
+         */
+        ServiceRegistryMetricsCollector* const metrics;
+
+        /**
+         * Lock the registry. Hides MultiThreaded::Lock() to record the
+         * wait for the lock when metrics are enabled.
+         */
+        UniqueLock
+        Lock() const
+        {
+            if (metrics == nullptr)
+            {
+                return MultiThreaded::Lock();
+            }
+            return TimedLock();
+        }
+
+        UniqueLock TimedLock() const;
+
+        /**
+         * The registered services of one class, or of all classes if
+         * <code>clazz</code> is empty, as seen by lookups in snapshot mode.
+         * A change to the class only drops the list and the next lookup
+         * of the class rebuilds it, so changes to other classes cost nothing.
+         */
+        struct SnapshotEntry
+        {
+            explicit SnapshotEntry(std::string clazz) : clazz(std::move(clazz)) {}
+
+            std::string const clazz;
+            detail::Atomic<std::shared_ptr<std::vector<ServiceRegistrationBase> const>> registrations;
+        };
+
+        /**
+         * An immutable map from class names to their snapshot entries, used
+         * when the Constants::FRAMEWORK_SERVICE_REGISTRY_SNAPSHOT framework
+         * property is set. It is only replaced when a class is registered
+         * for the first time or its last service is unregistered.
+         */
+        struct Snapshot
+        {
+            std::unordered_map<std::string, std::shared_ptr<SnapshotEntry>> classServices;
+        };
+
+        /**
+         * If true, lookups read the current snapshot and do not take the
+         * registry lock. Modifications still take the lock and invalidate
+         * the snapshot entries of the modified classes.
+         */
+        bool useSnapshots;
+
+        mutable detail::Atomic<std::shared_ptr<Snapshot const>> snapshot;
+
+        /**
+         * The snapshot entries of all classes with registered services,
+         * guarded by the registry lock.
+         */
+        std::unordered_map<std::string, std::shared_ptr<SnapshotEntry>> snapshotEntries;
+
+        /**
+         * The snapshot entry of all registered services.
+         */
+        std::shared_ptr<SnapshotEntry> const snapshotRegistrations;
+
+        /**
+         * Returns the current snapshot, creating it if it has been
+         * invalidated. Must not be called with the registry lock held.
+         */
+        std::shared_ptr<Snapshot const> GetSnapshot() const;
+
+        /**
+         * Returns the registered services of <code>entry</code>, rebuilding
+         * them if they have been invalidated. Must not be called with the
+         * registry lock held.
+         */
+        std::shared_ptr<std::vector<ServiceRegistrationBase> const> GetSnapshotRegistrations(
+            SnapshotEntry& entry) const;
+
+        void InvalidateSnapshot_unlocked(std::vector<std::string> const& classes);
+
+        /**
+         * Advance the generation and invalidate the snapshot entries of
+         * <code>classes</code>. Must be called with the registry lock held
+         * after every change.
+         */
+        void Modified_unlocked(std::vector<std::string> const& classes);
+
+        /**
+         * The registered ServiceFindHook and ServiceEventListenerHook
+         * services, highest ranked first. A new immutable set is published
+         * whenever a hook is registered, unregistered or re-ranked, so that
+         * hooks are neither looked up nor called with the registry lock held.
+         */
+        struct HookSet
+        {
+            std::vector<ServiceRegistrationBase> findHooks;
+            std::vector<ServiceRegistrationBase> eventListenerHooks;
+        };
+
+        detail::Atomic<std::shared_ptr<HookSet const>> hookSet;
+
+        /**
+         * Set while the current hook set contains hooks of the corresponding
+         * kind, so that the common case of no hooks costs a single atomic load.
+         */
+        std::atomic<bool> hasFindHooks;
+        std::atomic<bool> hasEventListenerHooks;
+
+        /**
+         * Publish a new hook set if one of <code>classes</code> is a hook
+         * interface. Must be called with the registry lock held, after
+         * classServices has been updated.
+         */
+        void UpdateHookSet_unlocked(std::vector<std::string> const& classes);
+
+        /**
+         * Call the find hooks for the result of a lookup on behalf of
+         * <code>bundle</code>. Must not be called with the registry lock held.
+         */
+        void FilterServiceReferences(BundlePrivate* bundle,
+                                     std::string const& clazz,
+                                     std::string const& filter,
+                                     std::vector<ServiceReferenceBase>& serviceRefs) const;
+
+        /**
+         * Number of empty slots in serviceRegistrations.
+         */
+        std::size_t registrationTombstones;
+
+        /**
+         * Number of unregistered services still contained in the
+         * corresponding classServices vector.
+         */
+        std::unordered_map<std::string, std::size_t> classTombstones;
+
+        /**
+         * Services used by each bundle, i.e. services whose registration
+         * has the bundle in its dependents or prototype instances. This
+         * index has its own lock, which is never held while acquiring
+         * other locks.
+         */
+        struct BundleUses : detail::MultiThreaded<>
+        {
+            MapBundleUses uses;
+        };
+        mutable BundleUses bundleUses;
+
+        static long GetServiceId(ServiceRegistrationBase const& sr);
+
+        static bool IsRegistered_unlocked(ServiceRegistrationBase const& sr);
+
+        void CompactRegistrations_unlocked();
+
+        /**
+         * Remove the unregistered services from <code>regs</code>, the
+         * classServices vector of <code>clazz</code>. Unregistered services
+         * have no valid reference and break the ranking order, so this must
+         * be called before sorting or searching the vector.
+         */
+        void RemoveClassTombstones_unlocked(std::string const& clazz, std::vector<ServiceRegistrationBase>& regs);
+
         void RemoveServiceRegistration_unlocked(ServiceRegistrationBase const& sr);
 
+        /**
+         * Get all services implementing a certain class. In snapshot mode
+         * this reads the current snapshot, otherwise the caller must hold
+         * the registry lock.
+         */
         void Get_unlocked(std::string const& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
-        void Get_unlocked(std::string const& clazz,
+        /**
+         * Get all services implementing a certain class and matching the filter,
+         * reading from <code>snap</code> or, if it is null, from the live
+         * structures guarded by the registry lock. Find hooks are not called.
+         */
+        void Get_unlocked(Snapshot const* snap,
+                          std::string const& clazz,
                           std::string const& filter,
-                          BundlePrivate* bundle,
                           std::vector<ServiceReferenceBase>& serviceRefs) const;
     };
 } // namespace cppmicroservices
@@ -0,0 +1,152 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ServiceRegistryMetricsCollector.h"
+
+#include <algorithm>
+
+namespace cppmicroservices
+{
+
+    void
+    ServiceRegistryMetricsCollector::CountLookup(std::string const& clazz, std::string const& filter)
+    {
+        if (!clazz.empty())
+        {
+            lookupsByClass.fetch_add(1, std::memory_order_relaxed);
+            interfaces.Add(clazz);
+        }
+        if (!filter.empty())
+        {
+            filters.Add(filter);
+        }
+    }
+
+    void
+    ServiceRegistryMetricsCollector::RecordLockWait(LockKind kind, std::chrono::nanoseconds wait)
+    {
+        lockWaits[static_cast<std::size_t>(kind)].Record(wait);
+    }
+
+    ServiceRegistryMetrics
+    ServiceRegistryMetricsCollector::GetSnapshot(std::size_t topN) const
+    {
+        ServiceRegistryMetrics metrics;
+        metrics.enabled = true;
+        metrics.registrations = registrations.load(std::memory_order_relaxed);
+        metrics.unregistrations = unregistrations.load(std::memory_order_relaxed);
+        metrics.lookupsByClass = lookupsByClass.load(std::memory_order_relaxed);
+        metrics.filterEvaluations = filterEvaluations.load(std::memory_order_relaxed);
+        metrics.listenerInvocations = listenerInvocations.load(std::memory_order_relaxed);
+        metrics.serviceRegistryLock
+            = lockWaits[static_cast<std::size_t>(LockKind::ServiceRegistry)].GetSnapshot();
+        metrics.serviceListenersLock
+            = lockWaits[static_cast<std::size_t>(LockKind::ServiceListeners)].GetSnapshot();
+        metrics.propertiesLock = lockWaits[static_cast<std::size_t>(LockKind::Properties)].GetSnapshot();
+        metrics.topInterfaces = interfaces.Top(topN);
+        metrics.topFilters = filters.Top(topN);
+        return metrics;
+    }
+
+    void
+    ServiceRegistryMetricsCollector::Histogram::Record(std::chrono::nanoseconds wait)
+    {
+        auto const ns = static_cast<std::uint64_t>(wait.count());
+        std::size_t bucket = 0;
+        for (auto us = ns / 1000; us != 0 && bucket < BUCKET_COUNT - 1; us >>= 1)
+        {
+            ++bucket;
+        }
+        counts[bucket].fetch_add(1, std::memory_order_relaxed);
+        acquisitions.fetch_add(1, std::memory_order_relaxed);
+        if (ns == 0)
+        {
+            return;
+        }
+        totalWaitNs.fetch_add(ns, std::memory_order_relaxed);
+        auto max = maxWaitNs.load(std::memory_order_relaxed);
+        while (ns > max && !maxWaitNs.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    LockWaitHistogram
+    ServiceRegistryMetricsCollector::Histogram::GetSnapshot() const
+    {
+        LockWaitHistogram histogram;
+        histogram.upperBounds.reserve(BUCKET_COUNT - 1);
+        for (std::size_t i = 0; i < BUCKET_COUNT - 1; ++i)
+        {
+            histogram.upperBounds.push_back(std::chrono::microseconds(std::int64_t(1) << i));
+        }
+        histogram.counts.reserve(BUCKET_COUNT);
+        for (auto const& count : counts)
+        {
+            histogram.counts.push_back(count.load(std::memory_order_relaxed));
+        }
+        histogram.acquisitions = acquisitions.load(std::memory_order_relaxed);
+        histogram.totalWait = std::chrono::nanoseconds(totalWaitNs.load(std::memory_order_relaxed));
+        histogram.maxWait = std::chrono::nanoseconds(maxWaitNs.load(std::memory_order_relaxed));
+        return histogram;
+    }
+
+    void
+    ServiceRegistryMetricsCollector::TopCounter::Add(std::string const& key)
+    {
+        std::lock_guard<std::mutex> l(mutex);
+        auto it = counts.find(key);
+        if (it != counts.end())
+        {
+            ++it->second;
+            return;
+        }
+        if (counts.size() < CAPACITY)
+        {
+            counts.emplace(key, 1);
+            return;
+        }
+        auto min = std::min_element(counts.begin(),
+                                    counts.end(),
+                                    [](auto const& a, auto const& b) { return a.second < b.second; });
+        auto const count = min->second + 1;
+        counts.erase(min);
+        counts.emplace(key, count);
+    }
+
+    std::vector<std::pair<std::string, std::uint64_t>>
+    ServiceRegistryMetricsCollector::TopCounter::Top(std::size_t n) const
+    {
+        std::vector<std::pair<std::string, std::uint64_t>> top;
+        {
+            std::lock_guard<std::mutex> l(mutex);
+            top.assign(counts.begin(), counts.end());
+        }
+        n = std::min(n, top.size());
+        std::partial_sort(top.begin(),
+                          top.begin() + n,
+                          top.end(),
+                          [](auto const& a, auto const& b)
+                          { return a.second > b.second || (a.second == b.second && a.first < b.first); });
+        top.resize(n);
+        return top;
+    }
+} // namespace cppmicroservices
@@ -0,0 +1,174 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_SERVICEREGISTRYMETRICSCOLLECTOR_H
+#define CPPMICROSERVICES_SERVICEREGISTRYMETRICSCOLLECTOR_H
+
+#include "cppmicroservices/ServiceRegistryMetrics.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cppmicroservices
+{
+
+    /**
+     * Collects the metrics of a service registry, see
+     * Constants::FRAMEWORK_SERVICE_REGISTRY_METRICS.
+     *
+     * The framework only creates a collector when the metrics are enabled.
+     * Code recording metrics therefore tests a pointer to the collector first
+     * and does nothing else when the metrics are disabled.
+     *
+     * Counters and histograms are lock-free. The most queried interfaces and
+     * filters are counted under a mutex in a bounded table. Their counts are
+     * exact until the table overflows, and may be overestimated afterwards.
+     */
+    class ServiceRegistryMetricsCollector
+    {
+      public:
+        enum class LockKind
+        {
+            ServiceRegistry = 0,
+            ServiceListeners,
+            Properties
+        };
+
+        ServiceRegistryMetricsCollector() = default;
+
+        ServiceRegistryMetricsCollector(ServiceRegistryMetricsCollector const&) = delete;
+        ServiceRegistryMetricsCollector& operator=(ServiceRegistryMetricsCollector const&) = delete;
+
+        void
+        CountRegistration()
+        {
+            registrations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void
+        CountUnregistration()
+        {
+            unregistrations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void
+        CountFilterEvaluations(std::uint64_t count)
+        {
+            filterEvaluations.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        void
+        CountListenerInvocation()
+        {
+            listenerInvocations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * Count a service lookup. Lookups naming an interface count as lookups
+         * by class, and the interface and the filter count towards the most
+         * queried ones. Empty names and filters are not counted.
+         */
+        void CountLookup(std::string const& clazz, std::string const& filter);
+
+        /**
+         * Acquire the (deferred) lock and record how long that took. An
+         * uncontended lock is recorded as a zero wait without reading the clock.
+         */
+        template <class Lock>
+        void
+        Acquire(LockKind kind, Lock& lock)
+        {
+            if (lock.TryLock())
+            {
+                RecordLockWait(kind, std::chrono::nanoseconds::zero());
+                return;
+            }
+            auto const start = std::chrono::steady_clock::now();
+            lock.Lock();
+            RecordLockWait(kind,
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
+
+        /**
+         * Get the metrics collected so far, with at most \c topN most queried
+         * interfaces and filters.
+         */
+        ServiceRegistryMetrics GetSnapshot(std::size_t topN) const;
+
+      private:
+        // Buckets for waits below 1us, 1us to 2us, 2us to 4us, ... and 32.768ms or more.
+        static constexpr std::size_t BUCKET_COUNT = 17;
+
+        struct Histogram
+        {
+            std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> counts {};
+            std::atomic<std::uint64_t> acquisitions { 0 };
+            std::atomic<std::uint64_t> totalWaitNs { 0 };
+            std::atomic<std::uint64_t> maxWaitNs { 0 };
+
+            void Record(std::chrono::nanoseconds wait);
+            LockWaitHistogram GetSnapshot() const;
+        };
+
+        /**
+         * Counts keys in a table of at most CAPACITY entries. When the table
+         * is full, a new key replaces the key with the lowest count and
+         * inherits that count ("space-saving" algorithm), so frequent keys
+         * are never lost.
+         */
+        class TopCounter
+        {
+          public:
+            void Add(std::string const& key);
+            std::vector<std::pair<std::string, std::uint64_t>> Top(std::size_t n) const;
+
+          private:
+            static constexpr std::size_t CAPACITY = 256;
+
+            mutable std::mutex mutex;
+            std::unordered_map<std::string, std::uint64_t> counts;
+        };
+
+        void RecordLockWait(LockKind kind, std::chrono::nanoseconds wait);
+
+        std::atomic<std::uint64_t> registrations { 0 };
+        std::atomic<std::uint64_t> unregistrations { 0 };
+        std::atomic<std::uint64_t> lookupsByClass { 0 };
+        std::atomic<std::uint64_t> filterEvaluations { 0 };
+        std::atomic<std::uint64_t> listenerInvocations { 0 };
+
+        std::array<Histogram, 3> lockWaits;
+
+        TopCounter interfaces;
+        TopCounter filters;
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_SERVICEREGISTRYMETRICSCOLLECTOR_H
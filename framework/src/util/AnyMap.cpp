@@ -22,6 +22,8 @@
 
 #include "cppmicroservices/AnyMap.h"
 
+#include "FlatAnyMap.h"
+
 #include <cassert>
 #include <stdexcept>
 
@@ -193,6 +195,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 this->it.uoci = new uocciiter(it.uoci_it());
                 break;
+            case FLAT_CI:
+                this->it.f = it.it.f;
+                break;
             case NONE:
                 break;
             default:
@@ -213,6 +218,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 this->it.uoci = new uocciiter(it.uoci_it());
                 break;
+            case FLAT_CI:
+                this->it.f = it.it.f;
+                break;
             case NONE:
                 break;
             default:
@@ -233,6 +241,7 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 delete it.uoci;
                 break;
+            case FLAT_CI:
             case NONE:
                 break;
         }
@@ -240,6 +249,8 @@ namespace cppmicroservices
 
     any_map::const_iter::const_iter(ociter&& it) : iterator_base(ORDERED) { this->it.o = new ociter(std::move(it)); }
 
+    any_map::const_iter::const_iter(pointer it) : iterator_base(FLAT_CI) { this->it.f = it; }
+
     any_map::const_iter::const_iter(uociter&& it, iter_type type) : iterator_base(type)
     {
         switch (type)
@@ -266,6 +277,8 @@ namespace cppmicroservices
                 return *uo_it();
             case UNORDERED_CI:
                 return *uoci_it();
+            case FLAT_CI:
+                return *it.f;
             case NONE:
                 throw std::logic_error("cannot dereference an invalid iterator");
             default:
@@ -284,6 +297,8 @@ namespace cppmicroservices
                 return uo_it().operator->();
             case UNORDERED_CI:
                 return uoci_it().operator->();
+            case FLAT_CI:
+                return it.f;
             case NONE:
                 throw std::logic_error("cannot dereference an invalid iterator");
             default:
@@ -305,6 +320,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 ++uoci_it();
                 break;
+            case FLAT_CI:
+                ++it.f;
+                break;
             case NONE:
                 throw std::logic_error("cannot increment an invalid iterator");
             default:
@@ -329,6 +347,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 uoci_it()++;
                 break;
+            case FLAT_CI:
+                it.f++;
+                break;
             case NONE:
                 throw std::logic_error("cannot increment an invalid iterator");
             default:
@@ -348,6 +369,8 @@ namespace cppmicroservices
                 return uo_it() == x.uo_it();
             case UNORDERED_CI:
                 return uoci_it() == x.uoci_it();
+            case FLAT_CI:
+                return it.f == x.it.f;
             case NONE:
                 return x.type == NONE;
             default:
@@ -415,6 +438,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 this->it.uoci = new uociiter(it.uoci_it());
                 break;
+            case FLAT_CI:
+                this->it.f = it.it.f;
+                break;
             case NONE:
                 break;
             default:
@@ -435,6 +461,7 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 delete it.uoci;
                 break;
+            case FLAT_CI:
             case NONE:
                 break;
         }
@@ -442,6 +469,8 @@ namespace cppmicroservices
 
     any_map::iter::iter(oiter&& it) : iterator_base(ORDERED) { this->it.o = new oiter(std::move(it)); }
 
+    any_map::iter::iter(pointer it) : iterator_base(FLAT_CI) { this->it.f = it; }
+
     any_map::iter::iter(uoiter&& it, iter_type type) : iterator_base(type)
     {
         switch (type)
@@ -468,6 +497,8 @@ namespace cppmicroservices
                 return *uo_it();
             case UNORDERED_CI:
                 return *uoci_it();
+            case FLAT_CI:
+                return *it.f;
             case NONE:
                 throw std::logic_error("cannot dereference an invalid iterator");
             default:
@@ -486,6 +517,8 @@ namespace cppmicroservices
                 return uo_it().operator->();
             case UNORDERED_CI:
                 return uoci_it().operator->();
+            case FLAT_CI:
+                return it.f;
             case NONE:
                 throw std::logic_error("cannot dereference an invalid iterator");
             default:
@@ -507,6 +540,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 ++uoci_it();
                 break;
+            case FLAT_CI:
+                ++it.f;
+                break;
             case NONE:
                 throw std::logic_error("cannot increment an invalid iterator");
             default:
@@ -531,6 +567,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 uoci_it()++;
                 break;
+            case FLAT_CI:
+                it.f++;
+                break;
             case NONE:
                 throw std::logic_error("cannot increment an invalid iterator");
             default:
@@ -550,6 +589,8 @@ namespace cppmicroservices
                 return uo_it() == x.uo_it();
             case UNORDERED_CI:
                 return uoci_it() == x.uoci_it();
+            case FLAT_CI:
+                return it.f == x.it.f;
             case NONE:
                 return x.type == NONE;
             default:
@@ -615,6 +656,9 @@ namespace cppmicroservices
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 map.uoci = new unordered_any_cimap();
                 break;
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                map.f = new detail::flat_any_cimap();
+                break;
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -679,6 +723,8 @@ namespace cppmicroservices
                 return { uo_m().begin(), iter::UNORDERED };
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return { uoci_m().begin(), iter::UNORDERED_CI };
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return { f_m().begin() };
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -695,6 +741,8 @@ namespace cppmicroservices
                 return { uo_m().begin(), const_iterator::UNORDERED };
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return { uoci_m().begin(), const_iterator::UNORDERED_CI };
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return { f_m().begin() };
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -717,6 +765,8 @@ namespace cppmicroservices
                 return { uo_m().end(), iterator::UNORDERED };
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return { uoci_m().end(), iterator::UNORDERED_CI };
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return { f_m().end() };
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -733,6 +783,8 @@ namespace cppmicroservices
                 return { uo_m().end(), const_iterator::UNORDERED };
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return { uoci_m().end(), const_iterator::UNORDERED_CI };
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return { f_m().end() };
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -755,6 +807,8 @@ namespace cppmicroservices
                 return uo_m().empty();
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().empty();
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return f_m().empty();
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -771,6 +825,8 @@ namespace cppmicroservices
                 return uo_m().size();
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().size();
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return f_m().size();
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -787,6 +843,8 @@ namespace cppmicroservices
                 return uo_m().count(key);
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().count(key);
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return f_m().find(key) != f_m().end() ? 1 : 0;
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -803,6 +861,26 @@ namespace cppmicroservices
                 return uo_m().clear();
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().clear();
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return f_m().clear();
+            default:
+                throw std::logic_error("invalid map type");
+        }
+    }
+
+    void
+    any_map::reserve(size_type count)
+    {
+        switch (type)
+        {
+            case map_type::ORDERED_MAP:
+                break;
+            case map_type::UNORDERED_MAP:
+                return uo_m().reserve(count);
+            case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
+                return uoci_m().reserve(count);
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return f_m().reserve(count);
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -819,6 +897,15 @@ namespace cppmicroservices
                 return uo_m().at(key);
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().at(key);
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+            {
+                auto it = f_m().find(key);
+                if (it == f_m().end())
+                {
+                    throw std::out_of_range("any_map::at: key not found");
+                }
+                return it->second;
+            }
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -835,6 +922,15 @@ namespace cppmicroservices
                 return uo_m().at(key);
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().at(key);
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+            {
+                auto it = f_m().find(key);
+                if (it == f_m().end())
+                {
+                    throw std::out_of_range("any_map::at: key not found");
+                }
+                return it->second;
+            }
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -851,6 +947,8 @@ namespace cppmicroservices
                 return uo_m()[key];
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m()[key];
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return f_m()[key];
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -867,6 +965,8 @@ namespace cppmicroservices
                 return uo_m()[std::move(key)];
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m()[std::move(key)];
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return f_m()[std::move(key)];
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -892,11 +992,23 @@ namespace cppmicroservices
                 auto p = uoci_m().insert(value);
                 return { iterator(std::move(p.first), iterator::UNORDERED_CI), p.second };
             }
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+            {
+                auto p = f_m().insert(value);
+                return { iterator(p.first), p.second };
+            }
             default:
                 throw std::logic_error("invalid map type");
         }
     }
 
+    std::pair<any_map::iterator, bool>
+    any_map::emplaceF(value_type&& value)
+    {
+        auto p = f_m().insert(std::move(value));
+        return { iterator(p.first), p.second };
+    }
+
     any_map::const_iterator
     any_map::find(key_type const& key) const
     {
@@ -908,6 +1020,8 @@ namespace cppmicroservices
                 return { uo_m().find(key), const_iterator::UNORDERED };
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return { uoci_m().find(key), const_iterator::UNORDERED_CI };
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return { f_m().find(key) };
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -994,6 +1108,15 @@ namespace cppmicroservices
         return map.uoci->find(key);
     }
 
+    detail::flat_any_cimap const&
+    any_map::F_TypeChecked() const
+    {
+        assert(type == FLAT_MAP_CASEINSENSITIVE_KEYS
+               && "You are calling F_TypeChecked() on map "
+                  "whose type is not FLAT_MAP_CASEINSENSITIVE_KEYS.");
+        return *map.f;
+    }
+
     any_map::size_type
     any_map::erase(key_type const& key)
     {
@@ -1005,6 +1128,8 @@ namespace cppmicroservices
                 return uo_m().erase(key);
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().erase(key);
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                return f_m().erase(key);
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -1046,6 +1171,18 @@ namespace cppmicroservices
         return *map.uoci;
     }
 
+    detail::flat_any_cimap const&
+    any_map::f_m() const
+    {
+        return *map.f;
+    }
+
+    detail::flat_any_cimap&
+    any_map::f_m()
+    {
+        return *map.f;
+    }
+
     void
     any_map::copy_from(any_map const& other)
     {
@@ -1060,6 +1197,9 @@ namespace cppmicroservices
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 map.uoci = new unordered_any_cimap(other.uoci_m());
                 break;
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                map.f = new detail::flat_any_cimap(other.f_m());
+                break;
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -1082,6 +1222,10 @@ namespace cppmicroservices
                 map.uoci = other.map.uoci;
                 other.map.uoci = nullptr;
                 break;
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                map.f = other.map.f;
+                other.map.f = nullptr;
+                break;
         }
     }
 
@@ -1099,6 +1243,9 @@ namespace cppmicroservices
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 delete map.uoci;
                 break;
+            case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                delete map.f;
+                break;
         }
     }
 
@@ -1199,6 +1346,8 @@ namespace cppmicroservices
                     return (*map.uo == *rhs.map.uo);
                 case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                     return (*map.uoci == *rhs.map.uoci);
+                case map_type::FLAT_MAP_CASEINSENSITIVE_KEYS:
+                    return (*map.f == *rhs.map.f);
             }
         }
         return false;
@@ -0,0 +1,278 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "FlatAnyMap.h"
+
+#include "cppmicroservices/util/BinaryEncoding.h"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+
+namespace cppmicroservices
+{
+    namespace detail
+    {
+        namespace
+        {
+            constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+            inline char
+            FoldCase(char c) noexcept
+            {
+                return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+
+            bool
+            EqualsIgnoreCase(std::string_view l, std::string_view r) noexcept
+            {
+                return l.size() == r.size()
+                       && std::equal(l.begin(),
+                                     l.end(),
+                                     r.begin(),
+                                     [](char a, char b) { return FoldCase(a) == FoldCase(b); });
+            }
+
+            struct IndexLess
+            {
+                template <class Entry>
+                bool
+                operator()(Entry const& e, std::size_t hash) const noexcept
+                {
+                    return e.hash < hash;
+                }
+
+                template <class Entry>
+                bool
+                operator()(std::size_t hash, Entry const& e) const noexcept
+                {
+                    return hash < e.hash;
+                }
+            };
+        } // namespace
+
+        std::size_t
+        CaseFoldedHash(std::string_view key) noexcept
+        {
+            return static_cast<std::size_t>(util::Fnv1a64(key, FoldCase));
+        }
+
+        flat_any_cimap&
+        flat_any_cimap::operator=(flat_any_cimap const& other)
+        {
+            if (this != &other)
+            {
+                // the entries are not assignable, so copy and swap
+                flat_any_cimap tmp(other);
+                entries.swap(tmp.entries);
+                index.swap(tmp.index);
+            }
+            return *this;
+        }
+
+        flat_any_cimap&
+        flat_any_cimap::operator=(flat_any_cimap&& other) noexcept
+        {
+            entries = std::move(other.entries);
+            index = std::move(other.index);
+            return *this;
+        }
+
+        void
+        flat_any_cimap::reserve(size_type n)
+        {
+            entries.reserve(n);
+            index.reserve(n);
+        }
+
+        void
+        flat_any_cimap::clear() noexcept
+        {
+            entries.clear();
+            index.clear();
+        }
+
+        std::vector<flat_any_cimap::IndexEntry>::const_iterator
+        flat_any_cimap::FindIndex(std::string_view key, std::size_t hash) const
+        {
+            for (auto it = std::lower_bound(index.begin(), index.end(), hash, IndexLess {});
+                 it != index.end() && it->hash == hash;
+                 ++it)
+            {
+                if (EqualsIgnoreCase(Data()[it->pos].first, key))
+                {
+                    return it;
+                }
+            }
+            return index.end();
+        }
+
+        std::size_t
+        flat_any_cimap::FindPos(std::string_view key) const
+        {
+            auto it = FindIndex(key, CaseFoldedHash(key));
+            return it == index.end() ? npos : it->pos;
+        }
+
+        flat_any_cimap::value_type*
+        flat_any_cimap::find(std::string_view key)
+        {
+            auto pos = FindPos(key);
+            return pos == npos ? end() : Data() + pos;
+        }
+
+        flat_any_cimap::value_type const*
+        flat_any_cimap::find(std::string_view key) const
+        {
+            auto pos = FindPos(key);
+            return pos == npos ? end() : Data() + pos;
+        }
+
+        flat_any_cimap::value_type const*
+        flat_any_cimap::find(std::string_view key, std::size_t hash) const
+        {
+            auto it = FindIndex(key, hash);
+            return it == index.end() ? end() : Data() + it->pos;
+        }
+
+        template <class V>
+        std::pair<flat_any_cimap::value_type*, bool>
+        flat_any_cimap::Insert(V&& value)
+        {
+            auto const hash = CaseFoldedHash(value.first);
+            auto it = FindIndex(value.first, hash);
+            if (it != index.end())
+            {
+                return { Data() + it->pos, false };
+            }
+
+            if (entries.size() >= std::numeric_limits<std::uint32_t>::max())
+            {
+                throw std::length_error("too many entries in flat any_map");
+            }
+
+            auto const newPos = static_cast<std::uint32_t>(entries.size());
+            auto const indexPos = std::upper_bound(index.begin(), index.end(), hash, IndexLess {}) - index.begin();
+
+            entries.push_back(std::forward<V>(value));
+            try
+            {
+                index.insert(index.begin() + indexPos, IndexEntry { hash, newPos });
+            }
+            catch (...)
+            {
+                entries.pop_back();
+                throw;
+            }
+            return { Data() + newPos, true };
+        }
+
+        std::pair<flat_any_cimap::value_type*, bool>
+        flat_any_cimap::insert(value_type const& value)
+        {
+            return Insert(value);
+        }
+
+        std::pair<flat_any_cimap::value_type*, bool>
+        flat_any_cimap::insert(value_type&& value)
+        {
+            return Insert(std::move(value));
+        }
+
+        Any&
+        flat_any_cimap::operator[](std::string const& key)
+        {
+            auto pos = FindPos(key);
+            if (pos != npos)
+            {
+                return Data()[pos].second;
+            }
+            return Insert(value_type(key, Any())).first->second;
+        }
+
+        Any&
+        flat_any_cimap::operator[](std::string&& key)
+        {
+            auto pos = FindPos(key);
+            if (pos != npos)
+            {
+                return Data()[pos].second;
+            }
+            return Insert(value_type(std::move(key), Any())).first->second;
+        }
+
+        flat_any_cimap::size_type
+        flat_any_cimap::erase(std::string_view key)
+        {
+            auto const it = FindIndex(key, CaseFoldedHash(key));
+            if (it == index.end())
+            {
+                return 0;
+            }
+
+            auto const pos = it->pos;
+            auto const last = static_cast<std::uint32_t>(entries.size() - 1);
+            if (pos != last)
+            {
+                // The keys are const, so the last entry cannot be assigned to the erased
+                // one. Copy its key first, which may throw, and then re-construct the
+                // erased entry in place, which does not throw.
+                auto& lastEntry = Data()[last];
+                std::string lastKey(lastEntry.first);
+                auto lastIndex = std::find_if(index.begin(),
+                                              index.end(),
+                                              [last](IndexEntry const& e) { return e.pos == last; });
+                lastIndex->pos = pos;
+
+                value_type* slot = Data() + pos;
+                slot->~value_type();
+                ::new (static_cast<void*>(slot)) value_type(std::piecewise_construct,
+                                                             std::forward_as_tuple(std::move(lastKey)),
+                                                             std::forward_as_tuple(std::move(lastEntry.second)));
+            }
+            index.erase(it);
+            entries.pop_back();
+            return 1;
+        }
+
+        bool
+        flat_any_cimap::operator==(flat_any_cimap const& rhs) const
+        {
+            if (size() != rhs.size())
+            {
+                return false;
+            }
+            for (auto const& e : *this)
+            {
+                auto pos = rhs.FindPos(e.first);
+                if (pos == npos || !(rhs.Data()[pos].second == e.second))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    } // namespace detail
+} // namespace cppmicroservices
@@ -0,0 +1,161 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_FLATANYMAP_H
+#define CPPMICROSERVICES_FLATANYMAP_H
+
+#include "cppmicroservices/AnyMap.h"
+
+#include <cstdint>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cppmicroservices
+{
+    namespace detail
+    {
+
+        //! Hash of the lower-cased key, computed without allocating.
+        std::size_t CaseFoldedHash(std::string_view key) noexcept;
+
+        /**
+         * The storage of an any_map of type FLAT_MAP_CASEINSENSITIVE_KEYS.
+         *
+         * Entries are kept in a contiguous vector in insertion order. A
+         * separate index, sorted by the case-folded hash of the keys, holds
+         * the hash and the position of each entry.
+         *
+         * Like std::vector, inserting invalidates references to entries. As
+         * the entries have a const key, growing the storage copies them; use
+         * reserve() when the final size is known. Erasing moves the last
+         * entry into the place of the erased one, so it copies at most one
+         * key. As that re-creates an entry with a const member in place, the
+         * entries are only accessed through Data(), which launders the storage.
+         */
+        class flat_any_cimap
+        {
+          public:
+            using value_type = any_map::value_type;
+            using size_type = any_map::size_type;
+
+            flat_any_cimap() = default;
+            flat_any_cimap(flat_any_cimap const&) = default;
+            flat_any_cimap(flat_any_cimap&&) noexcept = default;
+
+            flat_any_cimap& operator=(flat_any_cimap const& other);
+            flat_any_cimap& operator=(flat_any_cimap&& other) noexcept;
+
+            value_type*
+            begin() noexcept
+            {
+                return Data();
+            }
+
+            value_type const*
+            begin() const noexcept
+            {
+                return Data();
+            }
+
+            value_type*
+            end() noexcept
+            {
+                return Data() + entries.size();
+            }
+
+            value_type const*
+            end() const noexcept
+            {
+                return Data() + entries.size();
+            }
+
+            bool
+            empty() const noexcept
+            {
+                return entries.empty();
+            }
+
+            size_type
+            size() const noexcept
+            {
+                return entries.size();
+            }
+
+            void reserve(size_type n);
+
+            void clear() noexcept;
+
+            //! Case-insensitive lookup. Returns end() if key is not found.
+            value_type* find(std::string_view key);
+            value_type const* find(std::string_view key) const;
+
+            //! Case-insensitive lookup of a key whose CaseFoldedHash() was computed in advance.
+            value_type const* find(std::string_view key, std::size_t hash) const;
+
+            //! Insert value unless an entry with a case variant of its key exists.
+            std::pair<value_type*, bool> insert(value_type const& value);
+            std::pair<value_type*, bool> insert(value_type&& value);
+
+            Any& operator[](std::string const& key);
+            Any& operator[](std::string&& key);
+
+            size_type erase(std::string_view key);
+
+            bool operator==(flat_any_cimap const& rhs) const;
+
+          private:
+            value_type*
+            Data() noexcept
+            {
+                return entries.empty() ? entries.data() : std::launder(entries.data());
+            }
+
+            value_type const*
+            Data() const noexcept
+            {
+                return entries.empty() ? entries.data() : std::launder(entries.data());
+            }
+
+            struct IndexEntry
+            {
+                std::size_t hash;
+                std::uint32_t pos;
+            };
+
+            std::vector<IndexEntry>::const_iterator FindIndex(std::string_view key, std::size_t hash) const;
+            std::size_t FindPos(std::string_view key) const;
+
+            template <class V>
+            std::pair<value_type*, bool> Insert(V&& value);
+
+            // entries in insertion order
+            std::vector<value_type> entries;
+            // sorted by the case-folded hash of the keys
+            std::vector<IndexEntry> index;
+        };
+    } // namespace detail
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_FLATANYMAP_H
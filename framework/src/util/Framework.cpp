@@ -24,6 +24,7 @@
 
 #include "cppmicroservices/FrameworkEvent.h"
 
+#include "CoreBundleContext.h"
 #include "FrameworkPrivate.h"
 
 namespace cppmicroservices
@@ -73,4 +74,15 @@ namespace cppmicroservices
     {
         return pimpl(d)->WaitForStop(timeout);
     }
+
+    ServiceRegistryMetrics
+    Framework::GetServiceRegistryMetrics(std::size_t topN) const
+    {
+        auto const& metrics = pimpl(d)->coreCtx->registryMetrics;
+        if (!metrics)
+        {
+            return ServiceRegistryMetrics();
+        }
+        return metrics->GetSnapshot(topN);
+    }
 } // namespace cppmicroservices
@@ -27,16 +27,19 @@
 
 #include "absl/strings/str_cat.h"
 
+#include "FlatAnyMap.h"
 #include "Properties.h"
 
 #include "PropsCheck.h"
 
+#include <atomic>
 #include <cctype>
 #include <cerrno>
 #include <cmath>
 #include <cstdlib>
 #include <iterator>
 #include <limits>
+#include <list>
 #include <stdexcept>
 #include <utility>
 
@@ -140,6 +143,112 @@ namespace cppmicroservices
         void error(std::string const& m) const;
     };
 
+    namespace
+    {
+        //! The property value types an LDAPExpr leaf can compare against.
+        enum class LDAPValueType : unsigned char
+        {
+            Unsupported,
+            String,
+            StringVector,
+            StringList,
+            Char,
+            Bool,
+            Short,
+            Int,
+            Long,
+            LongLong,
+            UChar,
+            UShort,
+            UInt,
+            ULong,
+            ULongLong,
+            Float,
+            Double,
+            AnyVector
+        };
+
+        struct LDAPTypeTag
+        {
+            std::type_info const* type;
+            LDAPValueType valueType;
+        };
+
+        LDAPTypeTag const LDAP_TYPE_TAGS[] = {
+            { &typeid(std::string), LDAPValueType::String },
+            { &typeid(std::vector<std::string>), LDAPValueType::StringVector },
+            { &typeid(std::list<std::string>), LDAPValueType::StringList },
+            { &typeid(char), LDAPValueType::Char },
+            { &typeid(bool), LDAPValueType::Bool },
+            { &typeid(short), LDAPValueType::Short },
+            { &typeid(int), LDAPValueType::Int },
+            { &typeid(long int), LDAPValueType::Long },
+            { &typeid(long long int), LDAPValueType::LongLong },
+            { &typeid(unsigned char), LDAPValueType::UChar },
+            { &typeid(unsigned short), LDAPValueType::UShort },
+            { &typeid(unsigned int), LDAPValueType::UInt },
+            { &typeid(unsigned long int), LDAPValueType::ULong },
+            { &typeid(unsigned long long int), LDAPValueType::ULongLong },
+            { &typeid(float), LDAPValueType::Float },
+            { &typeid(double), LDAPValueType::Double },
+            { &typeid(std::vector<Any>), LDAPValueType::AnyVector }
+        };
+
+        LDAPTypeTag const*
+        LookupTypeTag(std::type_info const& type)
+        {
+            // type_info objects are usually unique, but may be duplicated
+            // across shared library boundaries.
+            for (auto const& tag : LDAP_TYPE_TAGS)
+            {
+                if (tag.type == &type)
+                    return &tag;
+            }
+            for (auto const& tag : LDAP_TYPE_TAGS)
+            {
+                if (*tag.type == type)
+                    return &tag;
+            }
+            return nullptr;
+        }
+
+        //! Access the value held by an Any whose type has already been checked.
+        template <typename T>
+        T const&
+        HeldValue(Any const& obj)
+        {
+            return *unsafe_any_cast<T>(const_cast<Any*>(&obj));
+        }
+
+        bool
+        ParseLong(std::string const& s, long& value)
+        {
+            errno = 0;
+            char* endptr = nullptr;
+            value = strtol(s.c_str(), &endptr, 10);
+            return !((errno == ERANGE
+                      && (value == std::numeric_limits<long>::max() || value == std::numeric_limits<long>::min()))
+                     || (errno != 0 && value == 0) || endptr == s.c_str());
+        }
+
+        bool
+        ParseDouble(std::string const& s, double& value)
+        {
+            errno = 0;
+            char* endptr = nullptr;
+            value = strtod(s.c_str(), &endptr);
+            return !((errno == ERANGE && (value == 0 || value == HUGE_VAL || value == -HUGE_VAL))
+                     || (errno != 0 && value == 0) || endptr == s.c_str());
+        }
+
+        //! Checks if s is a case-insensitive prefix of boolVal
+        bool
+        MatchesBool(std::string const& s, std::string const& boolVal)
+        {
+            return s.size() <= boolVal.size() && std::equal(s.begin(), s.end(), boolVal.begin(), stricomp);
+        }
+    } // namespace
+
     class LDAPExprData
     {
       public:
@@ -147,26 +256,80 @@ namespace cppmicroservices
             : m_operator(op)
             , m_args(std::move(args))
             , m_attrName()
+            , m_attrHash(0)
             , m_attrValue()
+            , m_approxValue()
+            , m_isWildcard(false)
+            , m_matchesTrue(false)
+            , m_matchesFalse(false)
+            , m_hasLongValue(false)
+            , m_hasDoubleValue(false)
+            , m_longValue(0)
+            , m_doubleValue(0)
+            , m_lastType(nullptr)
         {
         }
 
-        LDAPExprData(int op, std::string attrName, std::string attrValue)
+        LDAPExprData(int op, std::string attrName, std::string attrValue, std::string approxValue)
             : m_operator(op)
             , m_args()
             , m_attrName(std::move(attrName))
+            , m_attrHash(detail::CaseFoldedHash(m_attrName))
             , m_attrValue(std::move(attrValue))
+            , m_approxValue(std::move(approxValue))
+            , m_isWildcard(m_attrValue == LDAPExprConstants::WILDCARD_STRING())
+            , m_matchesTrue(MatchesBool(m_attrValue, "true"))
+            , m_matchesFalse(MatchesBool(m_attrValue, "false"))
+            , m_hasLongValue(false)
+            , m_hasDoubleValue(false)
+            , m_longValue(0)
+            , m_doubleValue(0)
+            , m_lastType(nullptr)
         {
+            m_hasLongValue = ParseLong(m_attrValue, m_longValue);
+            m_hasDoubleValue = ParseDouble(m_attrValue, m_doubleValue);
         }
 
-        LDAPExprData(LDAPExprData const& other)
+        LDAPExprData(LDAPExprData const&) = delete;
+        LDAPExprData& operator=(LDAPExprData const&) = delete;
 
-            = default;
+        //! Get the type of a property value, remembering the last type seen by this leaf.
+        LDAPValueType
+        TypeOf(Any const& obj) const
+        {
+            std::type_info const& type = obj.Type();
+            LDAPTypeTag const* tag = m_lastType.load(std::memory_order_relaxed);
+            if (tag == nullptr || tag->type != &type)
+            {
+                tag = LookupTypeTag(type);
+                if (tag == nullptr)
+                {
+                    return LDAPValueType::Unsupported;
+                }
+                m_lastType.store(tag, std::memory_order_relaxed);
+            }
+            return tag->valueType;
+        }
 
         int m_operator;
         std::vector<LDAPExpr> m_args;
         std::string m_attrName;
+        // The hash of the attribute name of a leaf, for lookups in flat maps
+        std::size_t m_attrHash;
         std::string m_attrValue;
+
+        // The attribute value of a leaf, pre-converted for each kind of comparison
+        std::string m_approxValue;
+        bool m_isWildcard;
+        bool m_matchesTrue;
+        bool m_matchesFalse;
+        bool m_hasLongValue;
+        bool m_hasDoubleValue;
+        long m_longValue;
+        double m_doubleValue;
+
+      private:
+        mutable std::atomic<LDAPTypeTag const*> m_lastType;
     };
 
     LDAPExpr::LDAPExpr() : d() {}
@@ -194,7 +357,7 @@ namespace cppmicroservices
     LDAPExpr::LDAPExpr(int op, std::vector<LDAPExpr> const& args) : d(new LDAPExprData(op, args)) {}
 
     LDAPExpr::LDAPExpr(int op, std::string const& attrName, std::string const& attrValue)
-        : d(new LDAPExprData(op, attrName, attrValue))
+        : d(new LDAPExprData(op, attrName, attrValue, FixupString(attrValue)))
     {
     }
 
@@ -329,6 +492,32 @@ namespace cppmicroservices
         return false;
     }
 
+    bool
+    LDAPExpr::GetConjunctiveEqualityTerms(std::vector<EqualityTerm>& terms) const
+    {
+        if (!d)
+        {
+            return false;
+        }
+
+        auto const count = terms.size();
+        if (d->m_operator == EQ)
+        {
+            if (d->m_attrValue.find_first_of(LDAPExprConstants::WILDCARD()) == std::string::npos)
+            {
+                terms.emplace_back(ToLower(d->m_attrName), d->m_attrValue);
+            }
+        }
+        else if (d->m_operator == AND)
+        {
+            for (auto const& m_arg : d->m_args)
+            {
+                m_arg.GetConjunctiveEqualityTerms(terms);
+            }
+        }
+        return terms.size() > count;
+    }
+
     bool
     LDAPExpr::IsNull() const
     {
@@ -340,8 +529,7 @@ namespace cppmicroservices
     {
         if ((d->m_operator & SIMPLE) != 0)
         {
-            auto v = p->Value_unlocked(d->m_attrName, matchCase);
-            return (!v.second) ? false : Compare(v.first, d->m_operator, d->m_attrValue);
+            return Compare(p->ValueByRef_unlocked(d->m_attrName, d->m_attrHash, matchCase));
         }
         else
         { // (d->m_operator & COMPLEX) != 0
@@ -371,73 +559,21 @@ namespace cppmicroservices
 
     bool
     LDAPExpr::Evaluate(AnyMap const& p, bool matchCase) const
+    {
+        return Evaluate(p, nullptr, matchCase);
+    }
+
+    bool
+    LDAPExpr::Evaluate(AnyMap const& p, AnyMap const* defaults, bool matchCase) const
     {
         if ((d->m_operator & SIMPLE) != 0)
         {
-            if (p.GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+            auto value = Find(p, matchCase);
+            if (!value && defaults)
             {
-                auto itr = p.findUOCI_TypeChecked(d->m_attrName);
-                if (!matchCase && itr != p.endUOCI_TypeChecked())
-                {
-                    return Compare(itr->second, d->m_operator, d->m_attrValue);
-                }
-                else if (matchCase && itr != p.endUOCI_TypeChecked() && itr->first == d->m_attrName)
-                {
-                    return Compare(itr->second, d->m_operator, d->m_attrValue);
-                }
-                else
-                {
-                    return false;
-                }
-            }
-            else if (p.GetType() == AnyMap::UNORDERED_MAP)
-            {
-                auto itr = p.findUO_TypeChecked(d->m_attrName);
-                if (itr != p.endUO_TypeChecked())
-                {
-                    return Compare(itr->second, d->m_operator, d->m_attrValue);
-                }
-
-                if (!matchCase)
-                {
-                    for (auto itr = p.beginUO_TypeChecked(); itr != p.endUO_TypeChecked(); ++itr)
-                    {
-                        if (std::string lower = LDAPExpr::ToLower(d->m_attrName); itr->first == lower)
-                        {
-                            return Compare(p.findUO_TypeChecked(lower)->second, d->m_operator, d->m_attrValue);
-                        }
-                    }
-                    return false;
-                }
-
-                return false;
-            }
-            else if (p.GetType() == AnyMap::ORDERED_MAP)
-            {
-                auto itr = p.findOM_TypeChecked(d->m_attrName);
-                if (itr != p.endOM_TypeChecked())
-                {
-                    return Compare(itr->second, d->m_operator, d->m_attrValue);
-                }
-
-                if (!matchCase)
-                {
-                    for (auto itr = p.beginOM_TypeChecked(); itr != p.endOM_TypeChecked(); ++itr)
-                    {
-                        if (std::string lower = LDAPExpr::ToLower(d->m_attrName); itr->first == lower)
-                        {
-                            return Compare(p.findOM_TypeChecked(lower)->second, d->m_operator, d->m_attrValue);
-                        }
-                    }
-                    return false;
-                }
-
-                return false;
-            }
-            else
-            {
-                return false;
+                value = Find(*defaults, matchCase);
             }
+            return value && Compare(*value);
         }
         else
         { // (d->m_operator & COMPLEX) != 0
@@ -446,192 +582,175 @@ namespace cppmicroservices
                 case AND:
                     for (auto const& m_arg : d->m_args)
                     {
-                        if (!m_arg.Evaluate(p, matchCase))
+                        if (!m_arg.Evaluate(p, defaults, matchCase))
                             return false;
                     }
                     return true;
                 case OR:
                     for (auto const& m_arg : d->m_args)
                     {
-                        if (m_arg.Evaluate(p, matchCase))
+                        if (m_arg.Evaluate(p, defaults, matchCase))
                             return true;
                     }
                     return false;
                 case NOT:
-                    return !d->m_args[0].Evaluate(p, matchCase);
+                    return !d->m_args[0].Evaluate(p, defaults, matchCase);
                 default:
                     return false; // Cannot happen
             }
         }
     }
 
-    bool
-    LDAPExpr::Compare(Any const& obj, int op, std::string const& s) const
+    Any const*
+    LDAPExpr::Find(AnyMap const& p, bool matchCase) const
     {
-        if (obj.Empty())
-            return false;
-        if (op == EQ && s == LDAPExprConstants::WILDCARD_STRING())
-            return true;
-
-        try
+        if (p.GetType() == AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS)
         {
-            std::type_info const& objType = obj.Type();
-            if (objType == typeid(std::string))
-            {
-                return CompareString(ref_any_cast<std::string>(obj), op, s);
-            }
-            else if (objType == typeid(std::vector<std::string>))
+            auto const& m = p.F_TypeChecked();
+            auto itr = m.find(d->m_attrName, d->m_attrHash);
+            if (itr == m.end() || (matchCase && itr->first != d->m_attrName))
             {
-                auto const& list = ref_any_cast<std::vector<std::string>>(obj);
-                for (std::size_t it = 0; it != list.size(); it++)
-                {
-                    if (CompareString(list[it], op, s))
-                        return true;
-                }
+                return nullptr;
             }
-            else if (objType == typeid(std::list<std::string>))
+            return &itr->second;
+        }
+        else if (p.GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+        {
+            auto itr = p.findUOCI_TypeChecked(d->m_attrName);
+            if (itr == p.endUOCI_TypeChecked() || (matchCase && itr->first != d->m_attrName))
             {
-                auto const& list = ref_any_cast<std::list<std::string>>(obj);
-                for (auto const& it : list)
-                {
-                    if (CompareString(it, op, s))
-                        return true;
-                }
+                return nullptr;
             }
-            else if (objType == typeid(char))
+            return &itr->second;
+        }
+        else if (p.GetType() == AnyMap::UNORDERED_MAP)
+        {
+            auto itr = p.findUO_TypeChecked(d->m_attrName);
+            if (itr != p.endUO_TypeChecked())
             {
-                return CompareString(std::string(1, ref_any_cast<char>(obj)), op, s);
+                return &itr->second;
             }
-            else if (objType == typeid(bool))
-            {
-                if (op == LE || op == GE)
-                    return false;
 
-                std::string boolVal = any_cast<bool>(obj) ? "true" : "false";
-                return std::equal(s.begin(), s.end(), boolVal.begin(), stricomp);
-            }
-            else if (objType == typeid(short))
+            if (!matchCase)
             {
-                return CompareIntegralType<short>(obj, op, s);
-            }
-            else if (objType == typeid(int))
-            {
-                return CompareIntegralType<int>(obj, op, s);
-            }
-            else if (objType == typeid(long int))
-            {
-                return CompareIntegralType<long int>(obj, op, s);
-            }
-            else if (objType == typeid(long long int))
-            {
-                return CompareIntegralType<long long int>(obj, op, s);
-            }
-            else if (objType == typeid(unsigned char))
-            {
-                return CompareIntegralType<unsigned char>(obj, op, s);
-            }
-            else if (objType == typeid(unsigned short))
-            {
-                return CompareIntegralType<unsigned short>(obj, op, s);
-            }
-            else if (objType == typeid(unsigned int))
-            {
-                return CompareIntegralType<unsigned int>(obj, op, s);
-            }
-            else if (objType == typeid(unsigned long int))
-            {
-                return CompareIntegralType<unsigned long int>(obj, op, s);
+                for (auto itr = p.beginUO_TypeChecked(); itr != p.endUO_TypeChecked(); ++itr)
+                {
+                    if (std::string lower = LDAPExpr::ToLower(d->m_attrName); itr->first == lower)
+                    {
+                        return &p.findUO_TypeChecked(lower)->second;
+                    }
+                }
             }
-            else if (objType == typeid(unsigned long long int))
+            return nullptr;
+        }
+        else if (p.GetType() == AnyMap::ORDERED_MAP)
+        {
+            auto itr = p.findOM_TypeChecked(d->m_attrName);
+            if (itr != p.endOM_TypeChecked())
             {
-                return CompareIntegralType<unsigned long long int>(obj, op, s);
+                return &itr->second;
             }
-            else if (objType == typeid(float))
+
+            if (!matchCase)
             {
-                errno = 0;
-                char* endptr = nullptr;
-                double sFloat = strtod(s.c_str(), &endptr);
-                if ((errno == ERANGE && (sFloat == 0 || sFloat == HUGE_VAL || sFloat == -HUGE_VAL))
-                    || (errno != 0 && sFloat == 0) || endptr == s.c_str())
+                for (auto itr = p.beginOM_TypeChecked(); itr != p.endOM_TypeChecked(); ++itr)
                 {
-                    return false;
+                    if (std::string lower = LDAPExpr::ToLower(d->m_attrName); itr->first == lower)
+                    {
+                        return &p.findOM_TypeChecked(lower)->second;
+                    }
                 }
+            }
+            return nullptr;
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
 
-                auto floatVal = static_cast<double>(any_cast<float>(obj));
+    bool
+    LDAPExpr::Compare(Any const& obj) const
+    {
+        if (obj.Empty())
+            return false;
+        if (d->m_operator == EQ && d->m_isWildcard)
+            return true;
 
-                switch (op)
-                {
-                    case LE:
-                        return floatVal <= sFloat;
-                    case GE:
-                        return floatVal >= sFloat;
-                    default: /*APPROX and EQ*/
-                        double diff = floatVal - sFloat;
-                        return (diff < std::numeric_limits<float>::epsilon())
-                               && (diff > -std::numeric_limits<float>::epsilon());
-                }
-            }
-            else if (objType == typeid(double))
-            {
-                errno = 0;
-                char* endptr = nullptr;
-                double sDouble = strtod(s.c_str(), &endptr);
-                if ((errno == ERANGE && (sDouble == 0 || sDouble == HUGE_VAL || sDouble == -HUGE_VAL))
-                    || (errno != 0 && sDouble == 0) || endptr == s.c_str())
+        switch (d->TypeOf(obj))
+        {
+            case LDAPValueType::String:
+                return CompareString(HeldValue<std::string>(obj));
+            case LDAPValueType::StringVector:
+                for (auto const& str : HeldValue<std::vector<std::string>>(obj))
                 {
-                    return false;
+                    if (CompareString(str))
+                        return true;
                 }
-
-                auto doubleVal = any_cast<double>(obj);
-
-                switch (op)
+                return false;
+            case LDAPValueType::StringList:
+                for (auto const& str : HeldValue<std::list<std::string>>(obj))
                 {
-                    case LE:
-                        return doubleVal <= sDouble;
-                    case GE:
-                        return doubleVal >= sDouble;
-                    default: /*APPROX and EQ*/
-                        double diff = doubleVal - sDouble;
-                        return (diff < std::numeric_limits<double>::epsilon())
-                               && (diff > -std::numeric_limits<double>::epsilon());
+                    if (CompareString(str))
+                        return true;
                 }
-            }
-            else if (objType == typeid(std::vector<Any>))
+                return false;
+            case LDAPValueType::Char:
             {
-                auto const& list = ref_any_cast<std::vector<Any>>(obj);
-                for (std::size_t it = 0; it != list.size(); it++)
+                char const c = HeldValue<char>(obj);
+                return CompareString(std::string_view(&c, 1));
+            }
+            case LDAPValueType::Bool:
+                if (d->m_operator == LE || d->m_operator == GE)
+                    return false;
+                return HeldValue<bool>(obj) ? d->m_matchesTrue : d->m_matchesFalse;
+            case LDAPValueType::Short:
+                return CompareIntegralType(HeldValue<short>(obj));
+            case LDAPValueType::Int:
+                return CompareIntegralType(HeldValue<int>(obj));
+            case LDAPValueType::Long:
+                return CompareIntegralType(HeldValue<long int>(obj));
+            case LDAPValueType::LongLong:
+                return CompareIntegralType(HeldValue<long long int>(obj));
+            case LDAPValueType::UChar:
+                return CompareIntegralType(HeldValue<unsigned char>(obj));
+            case LDAPValueType::UShort:
+                return CompareIntegralType(HeldValue<unsigned short>(obj));
+            case LDAPValueType::UInt:
+                return CompareIntegralType(HeldValue<unsigned int>(obj));
+            case LDAPValueType::ULong:
+                return CompareIntegralType(HeldValue<unsigned long int>(obj));
+            case LDAPValueType::ULongLong:
+                return CompareIntegralType(HeldValue<unsigned long long int>(obj));
+            case LDAPValueType::Float:
+                return CompareFloatingType(static_cast<double>(HeldValue<float>(obj)),
+                                           std::numeric_limits<float>::epsilon());
+            case LDAPValueType::Double:
+                return CompareFloatingType(HeldValue<double>(obj), std::numeric_limits<double>::epsilon());
+            case LDAPValueType::AnyVector:
+                for (auto const& any : HeldValue<std::vector<Any>>(obj))
                 {
-                    if (Compare(list[it], op, s))
+                    if (Compare(any))
                         return true;
                 }
-            }
-        }
-        catch (...)
-        {
-            // This might happen if a std::string-to-datatype conversion fails
-            // Just consider it a false match and ignore the exception
+                return false;
+            default:
+                return false;
         }
-        return false;
     }
 
     template <typename T>
     bool
-    LDAPExpr::CompareIntegralType(Any const& obj, int const op, std::string const& s) const
+    LDAPExpr::CompareIntegralType(T const intVal) const
     {
-        errno = 0;
-        char* endptr = nullptr;
-        long longInt = strtol(s.c_str(), &endptr, 10);
-        if ((errno == ERANGE
-             && (longInt == std::numeric_limits<long>::max() || longInt == std::numeric_limits<long>::min()))
-            || (errno != 0 && longInt == 0) || endptr == s.c_str())
+        if (!d->m_hasLongValue)
         {
             return false;
         }
 
-        auto sInt = static_cast<T>(longInt);
-        auto intVal = any_cast<T>(obj);
+        auto sInt = static_cast<T>(d->m_longValue);
 
-        switch (op)
+        switch (d->m_operator)
         {
             case LE:
                 return intVal <= sInt;
@@ -643,18 +762,38 @@ namespace cppmicroservices
     }
 
     bool
-    LDAPExpr::CompareString(const std::string_view s1, int op, const std::string_view s2)
+    LDAPExpr::CompareFloatingType(double const floatVal, double const epsilon) const
+    {
+        if (!d->m_hasDoubleValue)
+        {
+            return false;
+        }
+
+        switch (d->m_operator)
+        {
+            case LE:
+                return floatVal <= d->m_doubleValue;
+            case GE:
+                return floatVal >= d->m_doubleValue;
+            default: /*APPROX and EQ*/
+                double diff = floatVal - d->m_doubleValue;
+                return (diff < epsilon) && (diff > -epsilon);
+        }
+    }
+
+    bool
+    LDAPExpr::CompareString(const std::string_view s) const
     {
-        switch (op)
+        switch (d->m_operator)
         {
             case LE:
-                return s1.compare(s2) <= 0;
+                return s.compare(d->m_attrValue) <= 0;
             case GE:
-                return s1.compare(s2) >= 0;
+                return s.compare(d->m_attrValue) >= 0;
             case EQ:
-                return PatSubstr(s1, s2);
+                return PatSubstr(s, d->m_attrValue);
             case APPROX:
-                return FixupString(s2) == FixupString(s1);
+                return d->m_approxValue == FixupString(s);
             default:
                 return false;
         }
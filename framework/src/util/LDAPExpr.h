@@ -28,6 +28,7 @@
 #include <memory>
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "cppmicroservices/AnyMap.h"
@@ -60,6 +61,8 @@ namespace cppmicroservices
         using StringList = std::vector<std::string>;
         using LocalCache = std::vector<StringList>;
         using ObjectClassSet = std::unordered_set<std::string>;
+        //! An attribute name, in lower case, and the value it must equal.
+        using EqualityTerm = std::pair<std::string, std::string>;
 
         /**
          * Creates an invalid LDAPExpr object. Use with care.
@@ -109,6 +112,18 @@ namespace cppmicroservices
          */
         bool IsSimple(StringList const& keywords, LocalCache& cache, bool matchCase) const;
 
+        /**
+         * Get the equality terms every object matched by this LDAP expression
+         * has to satisfy. These are the terms <code>(<it>name</it>=<it>value</it>)</code>
+         * without wildcard characters which make up this expression, either
+         * directly or as operands of <code>(& EXPR+ )</code> expressions.
+         *
+         * @param terms The terms found are added to terms.
+         * @return <code>true</code> if at least one term was found,
+         * <code>false</code> otherwise.
+         */
+        bool GetConjunctiveEqualityTerms(std::vector<EqualityTerm>& terms) const;
+
         /**
          * Returns <code>true</code> if this instance is invalid, i.e. it was
          * constructed using LDAPExpr().
@@ -127,6 +142,10 @@ namespace cppmicroservices
         // PropertiesHandle causes unnecessary copies to occurr.
         bool Evaluate(AnyMap const& p, bool matchCase) const;
 
+        // Evaluate this LDAP filter on an AnyMap, looking up the keys missing from p in defaults,
+        // if it is not null.
+        bool Evaluate(AnyMap const& p, AnyMap const* defaults, bool matchCase) const;
+
         //!
         const std::string ToString() const;
 
@@ -149,15 +168,21 @@ namespace cppmicroservices
 
         static std::string ToLower(std::string const& str);
 
-        //!
-        bool Compare(Any const& obj, int op, std::string const& s) const;
+        //! Find the value of the attribute of this leaf expression in p. Returns nullptr if it is missing.
+        Any const* Find(AnyMap const& p, bool matchCase) const;
+
+        //! Compare a property value with the attribute value of this leaf expression.
+        bool Compare(Any const& obj) const;
 
         //!
         template <typename T>
-        bool CompareIntegralType(Any const& obj, int const op, std::string const& s) const;
+        bool CompareIntegralType(T const intVal) const;
+
+        //!
+        bool CompareFloatingType(double const floatVal, double const epsilon) const;
 
         //!
-        static bool CompareString(const std::string_view s1, int op, const std::string_view s2);
+        bool CompareString(const std::string_view s) const;
 
         //!
         static std::string FixupString(const std::string_view s);
@@ -0,0 +1,108 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "LDAPExprCache.h"
+
+namespace cppmicroservices
+{
+
+    LDAPExprCache::LDAPExprCache(std::size_t capacity) : capacity(capacity), lru(), index(), hits(0), misses(0) {}
+
+    LDAPExprCache&
+    LDAPExprCache::Instance()
+    {
+        static LDAPExprCache cache;
+        return cache;
+    }
+
+    LDAPExpr
+    LDAPExprCache::Get(std::string const& filter)
+    {
+        {
+            auto l = this->Lock();
+            US_UNUSED(l);
+            auto iter = index.find(filter);
+            if (iter != index.end())
+            {
+                ++hits;
+                lru.splice(lru.begin(), lru, iter->second);
+                return iter->second->second;
+            }
+        }
+
+        ++misses;
+
+        // Parse outside of the lock so that concurrent lookups of other
+        // filters are not blocked. Parse errors propagate to the caller.
+        LDAPExpr expr(filter);
+
+        auto l = this->Lock();
+        US_UNUSED(l);
+        if (capacity == 0 || index.find(filter) != index.end())
+        {
+            // caching disabled or another thread inserted the same filter meanwhile
+            return expr;
+        }
+        lru.emplace_front(filter, expr);
+        index.emplace(lru.front().first, lru.begin());
+        Evict_unlocked();
+        return expr;
+    }
+
+    LDAPExprCache::Statistics
+    LDAPExprCache::GetStatistics() const
+    {
+        auto l = this->Lock();
+        US_UNUSED(l);
+        return { hits.load(), misses.load(), lru.size(), capacity };
+    }
+
+    void
+    LDAPExprCache::SetCapacity(std::size_t newCapacity)
+    {
+        auto l = this->Lock();
+        US_UNUSED(l);
+        capacity = newCapacity;
+        Evict_unlocked();
+    }
+
+    void
+    LDAPExprCache::Clear()
+    {
+        auto l = this->Lock();
+        US_UNUSED(l);
+        index.clear();
+        lru.clear();
+        hits = 0;
+        misses = 0;
+    }
+
+    void
+    LDAPExprCache::Evict_unlocked()
+    {
+        while (lru.size() > capacity)
+        {
+            index.erase(lru.back().first);
+            lru.pop_back();
+        }
+    }
+} // namespace cppmicroservices
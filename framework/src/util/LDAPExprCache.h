@@ -0,0 +1,109 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_LDAPEXPRCACHE_H
+#define CPPMICROSERVICES_LDAPEXPRCACHE_H
+
+#include "cppmicroservices/detail/Threads.h"
+
+#include "LDAPExpr.h"
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace cppmicroservices
+{
+
+    /**
+     * A bounded, thread-safe LRU cache mapping LDAP filter strings to
+     * their compiled LDAPExpr.
+     *
+     * LDAPExpr objects are immutable once parsed and share their data, so
+     * a cached expression can be handed out to any number of threads. Filters
+     * which fail to parse are never cached; the parse error is re-thrown on
+     * every request.
+     *
+     * This class is not part of the public API.
+     */
+    class LDAPExprCache : private detail::MultiThreaded<>
+    {
+      public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+        struct Statistics
+        {
+            std::uint64_t hits;
+            std::uint64_t misses;
+            std::size_t size;
+            std::size_t capacity;
+        };
+
+        explicit LDAPExprCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+        LDAPExprCache(LDAPExprCache const&) = delete;
+        LDAPExprCache& operator=(LDAPExprCache const&) = delete;
+
+        /**
+         * The process-wide cache used by the framework for service lookups,
+         * service listeners and LDAPFilter objects.
+         */
+        static LDAPExprCache& Instance();
+
+        /**
+         * Returns the compiled expression for <code>filter</code>, parsing
+         * and caching it on a miss.
+         *
+         * @throws std::invalid_argument if <code>filter</code> is not a
+         *         valid LDAP filter.
+         */
+        LDAPExpr Get(std::string const& filter);
+
+        Statistics GetStatistics() const;
+
+        //! Sets the maximum number of cached expressions, evicting as needed. A capacity of 0 disables caching.
+        void SetCapacity(std::size_t capacity);
+
+        void Clear();
+
+      private:
+        using LruList = std::list<std::pair<std::string, LDAPExpr>>;
+
+        void Evict_unlocked();
+
+        std::size_t capacity;
+
+        // most recently used entries are at the front
+        LruList lru;
+        // keys refer to the filter strings owned by the list nodes
+        std::unordered_map<std::string_view, LruList::iterator> index;
+
+        std::atomic<std::uint64_t> hits;
+        std::atomic<std::uint64_t> misses;
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_LDAPEXPRCACHE_H
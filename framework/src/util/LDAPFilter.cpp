@@ -26,6 +26,7 @@
 #include "cppmicroservices/ServiceReference.h"
 
 #include "LDAPExpr.h"
+#include "LDAPExprCache.h"
 #include "Properties.h"
 #include "PropsCheck.h"
 #include "ServiceReferenceBasePrivate.h"
@@ -40,7 +41,7 @@ namespace cppmicroservices
       public:
         LDAPFilterData() : ldapExpr() {}
 
-        LDAPFilterData(std::string const& filter) : ldapExpr(filter) {}
+        LDAPFilterData(std::string const& filter) : ldapExpr(LDAPExprCache::Instance().Get(filter)) {}
 
         LDAPFilterData(LDAPFilterData const&) = default;
 
@@ -83,7 +84,8 @@ namespace cppmicroservices
         {
             auto const& headers = bundle.GetHeaders();
 
-            if (headers.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+            if (headers.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS
+                && headers.GetType() != AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS)
             {
                 props_check::ValidateAnyMap(headers);
             }
@@ -104,7 +106,8 @@ namespace cppmicroservices
     {
         if (d)
         {
-            if (dictionary.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+            if (dictionary.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS
+                && dictionary.GetType() != AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS)
             {
                 props_check::ValidateAnyMap(dictionary);
             }
@@ -117,6 +120,28 @@ namespace cppmicroservices
         }
     }
 
+    bool
+    LDAPFilter::Match(AnyMap const& dictionary, AnyMap const& defaults) const
+    {
+        if (d)
+        {
+            for (auto const* map : { &dictionary, &defaults })
+            {
+                if (map->GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS
+                    && map->GetType() != AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS)
+                {
+                    props_check::ValidateAnyMap(*map);
+                }
+            }
+
+            return d->ldapExpr.Evaluate(dictionary, &defaults, false);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
     // This function has been modified to call the LDAPExpr::Evaluate() function which takes
     // an AnyMap rather than a PropertiesHandle to optimize the code. Constructing a Properties
     // object is much slower (requiring a copy) than simply using the AnyMap directly.
@@ -125,7 +150,8 @@ namespace cppmicroservices
     {
         if (d)
         {
-            if (dictionary.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+            if (dictionary.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS
+                && dictionary.GetType() != AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS)
             {
                 props_check::ValidateAnyMap(dictionary);
             }
@@ -152,6 +178,13 @@ namespace cppmicroservices
 
     LDAPFilter& LDAPFilter::operator=(LDAPFilter const& filter) = default;
 
+    LDAPFilter::CacheStatistics
+    LDAPFilter::GetCacheStatistics()
+    {
+        auto const stats = LDAPExprCache::Instance().GetStatistics();
+        return { stats.hits, stats.misses, stats.size, stats.capacity };
+    }
+
     std::ostream&
     operator<<(std::ostream& os, LDAPFilter const& filter)
     {
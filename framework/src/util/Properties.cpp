@@ -26,7 +26,9 @@
 #include <stdexcept>
 #include <utility>
 
+#include "FlatAnyMap.h"
 #include "PropsCheck.h"
+#include "ServiceRegistryMetricsCollector.h"
 
 US_MSVC_PUSH_DISABLE_WARNING(4996)
 
@@ -35,239 +37,80 @@ namespace cppmicroservices
 
     const Any Properties::emptyAny;
 
-    void
-    Properties::PopulateCaseInsensitiveLookupMap()
-    {
-        if (props.GetType() == AnyMap::ORDERED_MAP)
-        {
-            for (auto itr = props.beginOM_TypeChecked(); itr != props.endOM_TypeChecked(); ++itr)
-            {
-                caseInsensitiveLookup[props_check::ToLower(itr->first)] = itr->first;
-            }
-        }
-        else if (props.GetType() == AnyMap::UNORDERED_MAP)
-        {
-            for (auto itr = props.beginUO_TypeChecked(); itr != props.endUO_TypeChecked(); ++itr)
-            {
-                caseInsensitiveLookup[props_check::ToLower(itr->first)] = itr->first;
-            }
-        }
-        else
-        {
-            throw std::runtime_error("Unsupported map type.");
-        }
-    }
+    // NOTE: Converting to a FLAT_MAP_CASEINSENSITIVE_KEYS map validates the properties, as
+    // a case insensitive map can _never_ contain some pair of keys which are only different
+    // in case. Maps which are already of that type are used as they are.
 
-    // NOTE: UNORDERED_MAP_CASEINSENSITIVE_KEYS AnyMaps inherently can never be invalid given that
-    // they can _never_ contain some pair of keys which are only different in case. Because of this,
-    // the validation check is not performed on these map types. Additionally, those types of maps
-    // are already case insensitive so populating and using the case insensitive lookup map is
-    // unnecessary.
+    Properties::Properties(AnyMap const& p) : props(props_check::ToFlatAnyMap(p)) {}
 
-    Properties::Properties(AnyMap const& p) : props(p)
-    {
-        if (p.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
-        {
-            props_check::ValidateAnyMap(p);
+    Properties::Properties(AnyMap&& p) : props(props_check::ToFlatAnyMap(std::move(p))) {}
 
-            PopulateCaseInsensitiveLookupMap();
-        }
-    }
+    Properties::Properties(Properties&& o) noexcept : props(std::move(o.props)), metrics(std::move(o.metrics)) {}
 
-    Properties::Properties(AnyMap&& p) : props(std::move(p))
+    // The metrics are not assigned: they are set once, before the properties are
+    // shared, and Lock() reads them without holding the lock.
+    Properties&
+    Properties::operator=(Properties&& o) noexcept
     {
-        if (props.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
-        {
-            props_check::ValidateAnyMap(props);
-
-            PopulateCaseInsensitiveLookupMap();
-        }
+        props = std::move(o.props);
+        return *this;
     }
 
-    Properties::Properties(Properties&& o) noexcept : props(std::move(o.props))
+    void
+    Properties::SetMetrics(std::shared_ptr<ServiceRegistryMetricsCollector> const& m)
     {
-        if (props.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
-        {
-            PopulateCaseInsensitiveLookupMap();
-        }
+        metrics = m;
     }
 
-    Properties&
-    Properties::operator=(Properties&& o) noexcept
+    Properties::UniqueLock
+    Properties::TimedLock() const
     {
-        props = std::move(o.props);
-        if (props.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
-        {
-            PopulateCaseInsensitiveLookupMap();
-        }
-        return *this;
+        UniqueLock l(*this, std::defer_lock);
+        metrics->Acquire(ServiceRegistryMetricsCollector::LockKind::Properties, l);
+        return l;
     }
 
     Any const&
     Properties::ValueByRef_unlocked(std::string const& key, bool matchCase) const
     {
-        if (props.GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+        auto const& m = props.F_TypeChecked();
+        auto itr = m.find(key);
+        if (itr == m.end() || (matchCase && itr->first != key))
         {
-            if (auto itr = props.findUOCI_TypeChecked(key); itr != props.endUOCI_TypeChecked())
-            {
-                if (!matchCase)
-                {
-                    return itr->second;
-                }
-                else if (matchCase && itr->first == key)
-                {
-                    return itr->second;
-                }
-                else
-                {
-                    return emptyAny;
-                }
-            }
-            else
-            {
-                return emptyAny;
-            }
-        }
-        else if (props.GetType() == AnyMap::UNORDERED_MAP)
-        {
-            auto itr = props.findUO_TypeChecked(key);
-            if (itr != props.endUO_TypeChecked())
-            {
-                return itr->second;
-            }
-
-            if (!matchCase)
-            {
-                auto ciItr = caseInsensitiveLookup.find(key);
-                if (ciItr != caseInsensitiveLookup.end())
-                {
-                    return props.findUO_TypeChecked(ciItr->second.data())->second;
-                }
-                else
-                {
-                    return emptyAny;
-                }
-            }
-
             return emptyAny;
         }
-        else if (props.GetType() == AnyMap::ORDERED_MAP)
-        {
-            auto itr = props.findOM_TypeChecked(key);
-            if (itr != props.endOM_TypeChecked())
-            {
-                return itr->second;
-            }
-
-            if (!matchCase)
-            {
-                auto ciItr = caseInsensitiveLookup.find(key);
-                if (ciItr != caseInsensitiveLookup.end())
-                {
-                    return props.findOM_TypeChecked(ciItr->second.data())->second;
-                }
-                else
-                {
-                    return emptyAny;
-                }
-            }
+        return itr->second;
+    }
 
-            return emptyAny;
-        }
-        else
+    Any const&
+    Properties::ValueByRef_unlocked(std::string const& key, std::size_t keyHash, bool matchCase) const
+    {
+        auto const& m = props.F_TypeChecked();
+        auto itr = m.find(key, keyHash);
+        if (itr == m.end() || (matchCase && itr->first != key))
         {
-            throw std::runtime_error("Unknown AnyMap type.");
+            return emptyAny;
         }
+        return itr->second;
     }
 
-    // This function has been modified to perform both the "find" and "lookup" operations rather than
-    // just the "lookup" as originally written.
-    //
-    // This code has been made more verbose as to extract the most performance out of it. If we know
-    // the map type for which we are operating on, then we can safely call the "*_TypeChecked()"
-    // version of certain functions on the map to bypass using the slow functions that return
-    // "any_map::iterator" or "any_map::const_iterator".
     std::pair<Any, bool>
     Properties::Value_unlocked(std::string const& key, bool matchCase) const
     {
-        if (props.GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
-        {
-            if (auto itr = props.findUOCI_TypeChecked(key); itr != props.endUOCI_TypeChecked())
-            {
-                if (!matchCase)
-                {
-                    return std::make_pair(itr->second, true);
-                }
-                else if (matchCase && itr->first == key)
-                {
-                    return std::make_pair(itr->second, true);
-                }
-                else
-                {
-                    return std::make_pair(emptyAny, false);
-                }
-            }
-            else
-            {
-                return std::make_pair(emptyAny, false);
-            }
-        }
-        else if (props.GetType() == AnyMap::UNORDERED_MAP)
+        auto const& m = props.F_TypeChecked();
+        auto itr = m.find(key);
+        if (itr == m.end() || (matchCase && itr->first != key))
         {
-            auto itr = props.findUO_TypeChecked(key);
-            if (itr != props.endUO_TypeChecked())
-            {
-                return std::make_pair(itr->second, true);
-            }
-
-            if (!matchCase)
-            {
-                auto ciItr = caseInsensitiveLookup.find(key);
-                if (ciItr != caseInsensitiveLookup.end())
-                {
-                    return std::make_pair(props.findUO_TypeChecked(ciItr->second.data())->second, true);
-                }
-                else
-                {
-                    return std::make_pair(emptyAny, false);
-                }
-            }
-
             return std::make_pair(emptyAny, false);
         }
-        else if (props.GetType() == AnyMap::ORDERED_MAP)
-        {
-            auto itr = props.findOM_TypeChecked(key);
-            if (itr != props.endOM_TypeChecked())
-            {
-                return std::make_pair(itr->second, true);
-            }
-
-            if (!matchCase)
-            {
-                auto ciItr = caseInsensitiveLookup.find(key);
-                if (ciItr != caseInsensitiveLookup.end())
-                {
-                    return std::make_pair(props.findOM_TypeChecked(ciItr->second.data())->second, true);
-                }
-                else
-                {
-                    return std::make_pair(emptyAny, false);
-                }
-            }
-
-            return std::make_pair(emptyAny, false);
-        }
-        else
-        {
-            throw std::runtime_error("Unknown AnyMap type.");
-        }
+        return std::make_pair(itr->second, true);
     }
 
     std::vector<std::string>
     Properties::Keys_unlocked() const
     {
         std::vector<std::string> result {};
+        result.reserve(props.size());
         for (auto const& kv_pair : props)
         {
             result.push_back(kv_pair.first);
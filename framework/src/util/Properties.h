@@ -27,11 +27,13 @@
 #include "cppmicroservices/AnyMap.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace cppmicroservices
 {
+    class ServiceRegistryMetricsCollector;
 
     class Properties : public detail::MultiThreaded<>
     {
@@ -45,29 +47,52 @@ namespace cppmicroservices
 
         Any const& ValueByRef_unlocked(std::string const& key, bool matchCase = false) const;
 
+        // Lookup by a key whose detail::CaseFoldedHash was computed in advance, as done for the
+        // attribute names of LDAP filters.
+        Any const& ValueByRef_unlocked(std::string const& key, std::size_t keyHash, bool matchCase) const;
+
         std::pair<Any, bool> Value_unlocked(std::string const& key, bool matchCase = false) const;
 
         std::vector<std::string> Keys_unlocked() const;
 
         void Clear_unlocked();
 
+        /**
+         * Lock the properties. Hides MultiThreaded::Lock() to record the
+         * wait for the lock when metrics are set.
+         */
+        UniqueLock
+        Lock() const
+        {
+            if (!metrics)
+            {
+                return MultiThreaded::Lock();
+            }
+            return TimedLock();
+        }
+
+        /**
+         * Record the waits for the lock of these properties in the given
+         * service registry metrics, see Constants::FRAMEWORK_SERVICE_REGISTRY_METRICS.
+         * Must be called before the properties are shared with other threads. The
+         * metrics are kept when other properties are move-assigned to these.
+         */
+        void SetMetrics(std::shared_ptr<ServiceRegistryMetricsCollector> const& metrics);
+
       private:
-        // An AnyMap is used to store the properties rather than 2 vectors (one for keys
-        // and the other for values) as previously done in the past. This reduces the number of
-        // copies and allows for finds to leverage a map find vs vector find.
+        UniqueLock TimedLock() const;
+
+        // The properties are always stored in an AnyMap of type FLAT_MAP_CASEINSENSITIVE_KEYS,
+        // whatever the type of the map they are created from. Its entries are stored contiguously
+        // without a node per key, which keeps the memory per service small and lookups
+        // cache-friendly.
         AnyMap props;
 
-        // A case-insensitive map which maps all-lowercased keys to the original key values. This
-        // allows for efficient case-insensitive lookups in map types that are not inherently
-        // case insensitive.
-        std::unordered_map<std::string, std::string_view, detail::any_map_cihash, detail::any_map_ciequal>
-            caseInsensitiveLookup;
+        // Owned jointly with the framework, as a service registration and its
+        // properties may outlive the framework.
+        std::shared_ptr<ServiceRegistryMetricsCollector> metrics;
 
         static const Any emptyAny;
-
-        // Helper that populates the case-insensitive lookup map when the provided AnyMap is not
-        // already case insensitive.
-        void PopulateCaseInsensitiveLookupMap();
     };
 
     class PropertiesHandle
@@ -72,6 +72,52 @@ namespace cppmicroservices
             }
         }
 
+        void
+        InsertCaseChecked(cppmicroservices::AnyMap& flat, std::string const& key, cppmicroservices::Any value)
+        {
+            auto result = flat.emplace(key, std::move(value));
+            if (!result.second && result.first->first != key)
+            {
+                std::string msg("Properties contain case variants of the key: ");
+                msg += result.first->first;
+                throw std::runtime_error(msg.c_str());
+            }
+        }
+
+        cppmicroservices::AnyMap
+        ToFlatAnyMap(cppmicroservices::AnyMap const& am)
+        {
+            if (am.GetType() == AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS)
+            {
+                return am;
+            }
+
+            AnyMap flat(AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS);
+            flat.reserve(am.size());
+            for (auto const& kv_pair : am)
+            {
+                InsertCaseChecked(flat, kv_pair.first, kv_pair.second);
+            }
+            return flat;
+        }
+
+        cppmicroservices::AnyMap
+        ToFlatAnyMap(cppmicroservices::AnyMap&& am)
+        {
+            if (am.GetType() == AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS)
+            {
+                return std::move(am);
+            }
+
+            AnyMap flat(AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS);
+            flat.reserve(am.size());
+            for (auto& kv_pair : am)
+            {
+                InsertCaseChecked(flat, kv_pair.first, std::move(kv_pair.second));
+            }
+            return flat;
+        }
+
         std::string
         ToLower(std::string const& s)
         {
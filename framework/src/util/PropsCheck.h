@@ -71,6 +71,30 @@ namespace cppmicroservices
          */
         void ValidateAnyMap(cppmicroservices::AnyMap const& am);
 
+        /**
+         * @brief Inserts a key and value into a map of type FLAT_MAP_CASEINSENSITIVE_KEYS,
+         * keeping an existing entry with exactly the same key.
+         *
+         * @param flat The map to insert into
+         * @param key The key to insert
+         * @param value The value to insert
+         * @throws std::runtime_error Thrown when `flat` contains a key which differs from
+         * `key` in case only
+         */
+        void InsertCaseChecked(cppmicroservices::AnyMap& flat,
+                               std::string const& key,
+                               cppmicroservices::Any value);
+
+        /**
+         * @brief Converts the provided AnyMap to a map of type FLAT_MAP_CASEINSENSITIVE_KEYS.
+         *
+         * @param am The AnyMap to convert
+         * @return The converted map
+         * @throws std::runtime_error Thrown when `am` is invalid (see ValidateAnyMap)
+         */
+        cppmicroservices::AnyMap ToFlatAnyMap(cppmicroservices::AnyMap const& am);
+        cppmicroservices::AnyMap ToFlatAnyMap(cppmicroservices::AnyMap&& am);
+
         std::string ToLower(std::string const& s);
     } // namespace props_check
 } // namespace cppmicroservices
@@ -23,6 +23,7 @@
 #include "cppmicroservices/SharedLibrary.h"
 
 #include "cppmicroservices/BundleActivator.h"
+#include "cppmicroservices/Trace.h"
 
 #include "cppmicroservices/util/FileSystem.h"
 
@@ -89,6 +90,7 @@ namespace cppmicroservices
         if (d->m_Handle)
             throw std::logic_error(std::string("Library already loaded: ") + GetFilePath());
         std::string libPath = GetFilePath();
+        detail::TraceSpan span("SharedLibrary::Load", libPath);
 #ifdef US_PLATFORM_POSIX
         d->m_Handle = dlopen(libPath.c_str(), flags);
         if (!d->m_Handle)
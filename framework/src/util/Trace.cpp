@@ -0,0 +1,210 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "cppmicroservices/Trace.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace cppmicroservices
+{
+
+    namespace
+    {
+        struct SpanRecord
+        {
+            // Copied, as the caller's string may belong to a library which is unloaded later
+            char name[Tracer::MAX_NAME_LENGTH + 1];
+            std::string detail;
+            std::uint64_t threadId;
+            std::chrono::steady_clock::time_point start;
+            std::chrono::steady_clock::time_point end;
+        };
+
+        // A ring buffer of completed spans
+        struct SpanBuffer
+        {
+            std::mutex mutex;
+            std::vector<SpanRecord> records;
+            std::size_t capacity = 0;
+            // The index of the oldest record once the buffer is full
+            std::size_t next = 0;
+        };
+
+        SpanBuffer&
+        GetSpanBuffer()
+        {
+            static SpanBuffer buffer;
+            return buffer;
+        }
+
+        // Small, stable thread ids read better in trace viewers than hashed std::thread::ids
+        std::uint64_t
+        CurrentThreadId()
+        {
+            static std::atomic<std::uint64_t> nextThreadId { 1 };
+            thread_local std::uint64_t const threadId = nextThreadId++;
+            return threadId;
+        }
+
+        void
+        WriteJsonString(std::ostream& os, std::string const& str)
+        {
+            os << '"';
+            for (char c : str)
+            {
+                switch (c)
+                {
+                    case '"':
+                        os << "\\\"";
+                        break;
+                    case '\\':
+                        os << "\\\\";
+                        break;
+                    case '\n':
+                        os << "\\n";
+                        break;
+                    case '\t':
+                        os << "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            char escaped[8];
+                            std::snprintf(escaped, sizeof escaped, "\\u%04x", static_cast<unsigned int>(c));
+                            os << escaped;
+                        }
+                        else
+                        {
+                            os << c;
+                        }
+                }
+            }
+            os << '"';
+        }
+
+        // Trace event times are in microseconds. Write them with a fixed
+        // precision, independent of the format flags of the stream.
+        void
+        WriteMicroseconds(std::ostream& os, std::chrono::steady_clock::duration d)
+        {
+            char formatted[32];
+            std::snprintf(formatted,
+                          sizeof formatted,
+                          "%.3f",
+                          std::chrono::duration<double, std::micro>(d).count());
+            os << formatted;
+        }
+    } // namespace
+
+    std::atomic<bool> Tracer::enabled { false };
+
+    void
+    Tracer::Enable(std::size_t capacity)
+    {
+        auto& buffer = GetSpanBuffer();
+        {
+            std::lock_guard<std::mutex> lock(buffer.mutex);
+            capacity = (std::max)(capacity, std::size_t { 1 });
+            if (buffer.capacity != capacity)
+            {
+                buffer.records.clear();
+                buffer.records.shrink_to_fit();
+                buffer.capacity = capacity;
+                buffer.next = 0;
+            }
+        }
+        enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void
+    Tracer::Disable()
+    {
+        enabled.store(false, std::memory_order_relaxed);
+    }
+
+    void
+    Tracer::Clear()
+    {
+        auto& buffer = GetSpanBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.records.clear();
+        buffer.next = 0;
+    }
+
+    void
+    Tracer::Record(char const* name,
+                   std::string const& detail,
+                   std::chrono::steady_clock::time_point start,
+                   std::chrono::steady_clock::time_point end)
+    {
+        SpanRecord record { {}, detail, CurrentThreadId(), start, end };
+        std::strncpy(record.name, name, Tracer::MAX_NAME_LENGTH);
+        auto& buffer = GetSpanBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        if (buffer.capacity == 0)
+        {
+            return;
+        }
+        if (buffer.records.size() < buffer.capacity)
+        {
+            buffer.records.push_back(std::move(record));
+        }
+        else
+        {
+            buffer.records[buffer.next] = std::move(record);
+            buffer.next = (buffer.next + 1) % buffer.capacity;
+        }
+    }
+
+    void
+    Tracer::WriteChromeTrace(std::ostream& os)
+    {
+        auto& buffer = GetSpanBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        os << "{\"traceEvents\":[";
+        auto const count = buffer.records.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto const& record = buffer.records[(buffer.next + i) % count];
+            os << (i ? ",\n" : "\n") << "{\"name\":";
+            WriteJsonString(os, record.name);
+            os << ",\"cat\":\"cppmicroservices\",\"ph\":\"X\",\"pid\":1,\"tid\":" << record.threadId << ",\"ts\":";
+            WriteMicroseconds(os, record.start.time_since_epoch());
+            os << ",\"dur\":";
+            WriteMicroseconds(os, record.end - record.start);
+            if (!record.detail.empty())
+            {
+                os << ",\"args\":{\"detail\":";
+                WriteJsonString(os, record.detail);
+                os << '}';
+            }
+            os << '}';
+        }
+        os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+} // namespace cppmicroservices
@@ -31,7 +31,10 @@
 #include "BundleResourceContainer.h"
 #include "CoreBundleContext.h"
 
+#include <algorithm>
+#include <atomic>
 #include <string>
+#include <thread>
 #include <typeinfo>
 #include <vector>
 
@@ -184,6 +187,46 @@ namespace cppmicroservices
 #endif
     }
 
+    void
+    RunConcurrently(std::size_t taskCount, std::function<void(std::size_t)> const& task)
+    {
+        std::atomic<std::size_t> next { 0 };
+        auto const worker = [&]()
+        {
+            for (auto i = next++; i < taskCount; i = next++)
+            {
+                task(i);
+            }
+        };
+
+        auto const threadCount
+            = (std::min)(static_cast<std::size_t>((std::max)(std::thread::hardware_concurrency(), 1u)), taskCount);
+        std::vector<std::thread> threads;
+        auto const joinAll = [&threads]()
+        {
+            for (auto& t : threads)
+            {
+                t.join();
+            }
+        };
+        try
+        {
+            threads.reserve(threadCount);
+            for (std::size_t i = 1; i < threadCount; ++i)
+            {
+                threads.emplace_back(worker);
+            }
+        }
+        catch (...)
+        {
+            // the threads already started must be joined before they are destroyed
+            joinAll();
+            throw;
+        }
+        worker();
+        joinAll();
+    }
+
     namespace detail
     {
 
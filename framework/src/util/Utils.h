@@ -26,7 +26,9 @@
 #include "BundleResourceContainer.h"
 #include "cppmicroservices/FrameworkExport.h"
 
+#include <cstddef>
 #include <exception>
+#include <functional>
 #include <string>
 
 namespace cppmicroservices
@@ -81,6 +83,16 @@ namespace cppmicroservices
 
     void TerminateForDebug(const std::exception_ptr ex);
 
+    /**
+     * Call task(i) for each i in [0, taskCount) on a bounded number of
+     * threads, including the calling thread, and return when all calls
+     * finished. task must not throw.
+     *
+     * If a thread cannot be created, the threads already started are joined
+     * and the exception is rethrown.
+     */
+    void RunConcurrently(std::size_t taskCount, std::function<void(std::size_t)> const& task);
+
     namespace detail
     {
         US_Framework_EXPORT std::string GetDemangledName(std::type_info const& typeInfo);
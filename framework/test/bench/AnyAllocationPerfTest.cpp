@@ -0,0 +1,175 @@
+#include "benchmark/benchmark.h"
+
+#include <cppmicroservices/Any.h>
+#include <cppmicroservices/AnyMap.h>
+#include <cppmicroservices/ServiceProperties.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace cppmicroservices;
+
+namespace
+{
+    std::atomic<std::size_t> allocationCount { 0 };
+
+    std::size_t
+    AllocationCount()
+    {
+        return allocationCount.load(std::memory_order_relaxed);
+    }
+
+    // Property values typical for service registrations: numbers, flags and
+    // short strings.
+    template <class Map>
+    void
+    FillProperties(Map& props, int64_t count)
+    {
+        for (int64_t i = 0; i < count; ++i)
+        {
+            auto key = "prop" + std::to_string(i);
+            switch (i % 4)
+            {
+                case 0:
+                    props[key] = static_cast<int>(i);
+                    break;
+                case 1:
+                    props[key] = (i % 3) == 0;
+                    break;
+                case 2:
+                    props[key] = static_cast<long>(i) * 1000;
+                    break;
+                default:
+                    props[key] = std::string("value") + std::to_string(i);
+                    break;
+            }
+        }
+    }
+
+    void
+    ReportAllocations(benchmark::State& state, std::size_t allocations)
+    {
+        state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations),
+                                                      benchmark::Counter::kAvgIterations);
+    }
+} // namespace
+
+// Count every heap allocation made by this executable. Replacing the global
+// operator new affects the whole program, so these benchmarks are built as
+// usFrameworkAllocationBenchTests and not as part of usFrameworkBenchTests.
+void*
+operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+static void
+ConstructServiceProperties(benchmark::State& state)
+{
+    std::size_t allocations = 0;
+    for (auto _ : state)
+    {
+        auto start = AllocationCount();
+        ServiceProperties props;
+        FillProperties(props, state.range(0));
+        allocations += AllocationCount() - start;
+        benchmark::DoNotOptimize(props);
+    }
+    ReportAllocations(state, allocations);
+}
+
+static void
+CopyServiceProperties(benchmark::State& state)
+{
+    ServiceProperties props;
+    FillProperties(props, state.range(0));
+
+    std::size_t allocations = 0;
+    for (auto _ : state)
+    {
+        auto start = AllocationCount();
+        ServiceProperties copy(props);
+        allocations += AllocationCount() - start;
+        benchmark::DoNotOptimize(copy);
+    }
+    ReportAllocations(state, allocations);
+}
+
+static void
+CopyAnyMap(benchmark::State& state)
+{
+    AnyMap props(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    FillProperties(props, state.range(0));
+
+    std::size_t allocations = 0;
+    for (auto _ : state)
+    {
+        auto start = AllocationCount();
+        AnyMap copy(props);
+        allocations += AllocationCount() - start;
+        benchmark::DoNotOptimize(copy);
+    }
+    ReportAllocations(state, allocations);
+}
+
+static void
+CopyFlatAnyMap(benchmark::State& state)
+{
+    AnyMap props(AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS);
+    FillProperties(props, state.range(0));
+
+    std::size_t allocations = 0;
+    for (auto _ : state)
+    {
+        auto start = AllocationCount();
+        AnyMap copy(props);
+        allocations += AllocationCount() - start;
+        benchmark::DoNotOptimize(copy);
+    }
+    ReportAllocations(state, allocations);
+}
+
+static void
+CopyAnyVector(benchmark::State& state)
+{
+    std::vector<Any> values;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        values.emplace_back(static_cast<int>(i));
+    }
+
+    std::size_t allocations = 0;
+    for (auto _ : state)
+    {
+        auto start = AllocationCount();
+        std::vector<Any> copy(values);
+        allocations += AllocationCount() - start;
+        benchmark::DoNotOptimize(copy);
+    }
+    ReportAllocations(state, allocations);
+}
+
+BENCHMARK(ConstructServiceProperties)->Arg(8)->Arg(64);
+BENCHMARK(CopyServiceProperties)->Arg(8)->Arg(64);
+BENCHMARK(CopyAnyMap)->Arg(8)->Arg(64);
+BENCHMARK(CopyFlatAnyMap)->Arg(8)->Arg(64);
+BENCHMARK(CopyAnyVector)->Arg(8)->Arg(64);
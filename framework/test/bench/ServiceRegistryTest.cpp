@@ -10,8 +10,10 @@
 #include <cppmicroservices/ServiceFactory.h>
 #include <cppmicroservices/ServiceObjects.h>
 
+#include <atomic>
 #include <chrono>
 #include <iostream>
+#include <thread>
 #include <vector>
 
 using namespace cppmicroservices;
@@ -256,3 +258,176 @@ BENCHMARK_REGISTER_F(ServiceRegistryFixture, ModifyServices)
         {1, 1000}
 })
     ->UseManualTime();
+
+/**
+ * Measures service registration while many service listeners with conjunctive
+ * filters, as used by Declarative Services trackers, are registered. Only one
+ * of the listeners matches the registered services.
+ */
+BENCHMARK_DEFINE_F(ServiceRegistryFixture, RegisterServicesWithConjunctiveListeners)
+(benchmark::State& state)
+{
+    using namespace std::chrono;
+
+    auto fc = framework->GetBundleContext();
+    auto listenerCount = state.range(0);
+    std::vector<ListenerToken> tokens;
+    for (auto i = listenerCount; i > 0; --i)
+    {
+        tokens.push_back(fc.AddServiceListener([](ServiceEvent const&) {},
+                                               "(&(objectclass=TestInterface1)(component.name=component"
+                                                   + std::to_string(i) + "))"));
+    }
+
+    auto interfaceMap = MakeInterfaceMapWithNInterfaces(1);
+    ServiceProperties props { { "component.name", std::string("component1") } };
+    for (auto _ : state)
+    {
+        InterfaceMapPtr iMapCopy(std::make_shared<InterfaceMap>(*interfaceMap));
+        auto start = high_resolution_clock::now();
+        (void)fc.RegisterService(iMapCopy, props);
+        auto end = high_resolution_clock::now();
+        auto elapsed_seconds = duration_cast<duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+
+    for (auto& token : tokens)
+    {
+        fc.RemoveListener(std::move(token));
+    }
+}
+
+BENCHMARK_REGISTER_F(ServiceRegistryFixture, RegisterServicesWithConjunctiveListeners)
+    ->RangeMultiplier(8)
+    ->Range(8, 4096)
+    ->UseManualTime();
+
+namespace
+{
+    std::shared_ptr<Framework> lookupFramework;
+    std::vector<ServiceRegistrationU> lookupRegistrations;
+} // namespace
+
+/**
+ * Measures the throughput of concurrent service lookups while a fixed set of
+ * services is registered. Run with an increasing number of threads to see how
+ * lookups scale with and without registry snapshots.
+ */
+static void
+ConcurrentServiceLookups(benchmark::State& state, bool useSnapshots)
+{
+    if (state.thread_index() == 0)
+    {
+        lookupFramework = std::make_shared<Framework>(FrameworkFactory().NewFramework(
+            FrameworkConfiguration { { Constants::FRAMEWORK_SERVICE_REGISTRY_SNAPSHOT, useSnapshots } }));
+        lookupFramework->Start();
+        auto fc = lookupFramework->GetBundleContext();
+        auto interfaceMap = MakeInterfaceMapWithNInterfaces(10);
+        for (int i = 0; i < 100; ++i)
+        {
+            lookupRegistrations.push_back(fc.RegisterService(std::make_shared<InterfaceMap>(*interfaceMap)));
+        }
+    }
+
+    // the first iteration of the loop waits for all threads
+    for (auto _ : state)
+    {
+        auto refs = lookupFramework->GetBundleContext().GetServiceReferences("TestInterface5");
+        benchmark::DoNotOptimize(refs);
+    }
+
+    if (state.thread_index() == 0)
+    {
+        lookupRegistrations.clear();
+        lookupFramework->Stop();
+        lookupFramework->WaitForStop(std::chrono::milliseconds::zero());
+        lookupFramework.reset();
+    }
+}
+
+BENCHMARK_CAPTURE(ConcurrentServiceLookups, Locked, false)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_CAPTURE(ConcurrentServiceLookups, Snapshot, true)->ThreadRange(1, 64)->UseRealTime();
+
+/**
+ * Registers services while service listeners are registered, with synchronous
+ * and asynchronous service event delivery. Reports the time spent in
+ * RegisterService by the registering thread, the time until all events were
+ * delivered and the number of delivered events per second.
+ */
+static void
+ServiceEventDelivery(benchmark::State& state, bool async)
+{
+    using namespace std::chrono;
+
+    auto f = FrameworkFactory().NewFramework(
+        FrameworkConfiguration { { Constants::FRAMEWORK_SERVICE_EVENTS_ASYNC, async } });
+    f.Start();
+    auto fc = f.GetBundleContext();
+
+    auto const serviceCount = state.range(0);
+    auto const listenerCount = state.range(1);
+    std::atomic<int64_t> delivered(0);
+    std::vector<ListenerToken> tokens;
+    for (int64_t i = 0; i < listenerCount; ++i)
+    {
+        tokens.push_back(fc.AddServiceListener([&delivered](ServiceEvent const&)
+                                               { delivered.fetch_add(1, std::memory_order_relaxed); },
+                                               "(objectclass=TestInterface1)"));
+    }
+
+    auto interfaceMap = MakeInterfaceMapWithNInterfaces(1);
+    std::vector<ServiceRegistrationU> regs;
+    regs.reserve(serviceCount);
+    double registrationSeconds = 0;
+    double deliverySeconds = 0;
+    for (auto _ : state)
+    {
+        delivered = 0;
+        auto start = high_resolution_clock::now();
+        for (int64_t i = 0; i < serviceCount; ++i)
+        {
+            regs.push_back(fc.RegisterService(std::make_shared<InterfaceMap>(*interfaceMap)));
+        }
+        auto registered = high_resolution_clock::now();
+        while (delivered.load(std::memory_order_relaxed) < serviceCount * listenerCount)
+        {
+            std::this_thread::yield();
+        }
+        auto end = high_resolution_clock::now();
+
+        registrationSeconds += duration_cast<duration<double>>(registered - start).count();
+        deliverySeconds += duration_cast<duration<double>>(end - start).count();
+        state.SetIterationTime(duration_cast<duration<double>>(end - start).count());
+
+        state.PauseTiming();
+        for (auto& reg : regs)
+        {
+            reg.Unregister();
+        }
+        regs.clear();
+        state.ResumeTiming();
+    }
+
+    state.counters["registration_s"] = benchmark::Counter(registrationSeconds, benchmark::Counter::kAvgIterations);
+    state.counters["delivery_s"] = benchmark::Counter(deliverySeconds, benchmark::Counter::kAvgIterations);
+    state.counters["events/s"]
+        = benchmark::Counter(static_cast<double>(serviceCount * listenerCount) * state.iterations() / deliverySeconds);
+
+    for (auto& token : tokens)
+    {
+        fc.RemoveListener(std::move(token));
+    }
+    f.Stop();
+    f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+BENCHMARK_CAPTURE(ServiceEventDelivery, Sync, false)
+    ->Args({ 1000, 100 })
+    ->Args({ 10000, 1000 })
+    ->Iterations(1)
+    ->UseManualTime();
+BENCHMARK_CAPTURE(ServiceEventDelivery, Async, true)
+    ->Args({ 1000, 100 })
+    ->Args({ 10000, 1000 })
+    ->Iterations(1)
+    ->UseManualTime();
@@ -2,13 +2,64 @@
 #include <cppmicroservices/Bundle.h>
 #include <cppmicroservices/BundleContext.h>
 #include <cppmicroservices/BundleEvent.h>
+#include <cppmicroservices/Constants.h>
 #include <cppmicroservices/Framework.h>
 #include <cppmicroservices/FrameworkEvent.h>
 #include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/util/FileSystem.h>
+#include <cstring>
 #include <future>
+#include <stdexcept>
 
 #include "TestUtils.h"
 #include "benchmark/benchmark.h"
+#include "miniz.h"
+
+namespace
+{
+    constexpr int NUM_CACHED_BUNDLES = 500;
+
+    // Write a zip file with a bundle containing a manifest and a few
+    // compressed resources.
+    void
+    WriteZipBundle(std::string const& path, std::string const& symbolicName)
+    {
+        std::string manifest = R"({ "bundle.symbolic_name" : ")" + symbolicName + R"(", "bundle.version" : "1.2.3",)"
+                               + R"( "bundle.description" : "A bundle installed by the metadata cache benchmark",)"
+                               + R"( "bundle.vendor" : "CppMicroServices", "scr" : { "version" : 1,)"
+                               + R"( "components" : [ { "implementation-class" : "Impl", "service" : {)"
+                               + R"( "interfaces" : [ "Interface1", "Interface2" ] },)"
+                               + R"( "references" : [ { "name" : "ref", "interface" : "Interface3" } ] } ] })";
+        for (int i = 0; i < 20; ++i)
+        {
+            manifest += R"(, "header)" + std::to_string(i) + R"(" : ")" + std::to_string(i * i) + R"(")";
+        }
+        manifest += " }";
+
+        mz_zip_archive zip;
+        std::memset(&zip, 0, sizeof(mz_zip_archive));
+        bool ok = mz_zip_writer_init_file(&zip, path.c_str(), 0);
+        auto const manifestName = symbolicName + "/manifest.json";
+        ok = ok
+             && mz_zip_writer_add_mem(&zip,
+                                      manifestName.c_str(),
+                                      manifest.c_str(),
+                                      manifest.size(),
+                                      MZ_DEFAULT_COMPRESSION);
+        std::string const content(4096, 'x');
+        for (int i = 0; ok && i < 10; ++i)
+        {
+            auto const name = symbolicName + "/resources/resource" + std::to_string(i) + ".txt";
+            ok = mz_zip_writer_add_mem(&zip, name.c_str(), content.c_str(), content.size(), MZ_DEFAULT_COMPRESSION);
+        }
+        ok = ok && mz_zip_writer_finalize_archive(&zip);
+        ok = mz_zip_writer_end(&zip) && ok;
+        if (!ok)
+        {
+            throw std::runtime_error("Could not write " + path);
+        }
+    }
+} // namespace
 
 class BundleInstallFixture : public ::benchmark::Fixture
 {
@@ -40,6 +91,58 @@ class BundleInstallFixture : public ::benchmark::Fixture
     }
 
   protected:
+    void
+    InstallWithMetadataCache(benchmark::State& state, bool warmCache)
+    {
+        using namespace std::chrono;
+        using namespace cppmicroservices;
+
+        testing::TempDir tempDir(testing::MakeUniqueTempDirectory());
+        std::vector<std::string> locations;
+        for (int i = 0; i < NUM_CACHED_BUNDLES; ++i)
+        {
+            auto const symbolicName = "cached_bundle_" + std::to_string(i);
+            locations.push_back(tempDir.Path + util::DIR_SEP + symbolicName + ".zip");
+            WriteZipBundle(locations.back(), symbolicName);
+        }
+
+        auto const storage = tempDir.Path + util::DIR_SEP + "fwdir";
+        FrameworkConfiguration const config {
+            {                Constants::FRAMEWORK_STORAGE, storage},
+            {Constants::FRAMEWORK_BUNDLE_METADATA_CACHE,    true}
+        };
+        auto installAll = [&config, &locations]()
+        {
+            auto framework = FrameworkFactory().NewFramework(config);
+            framework.Start();
+            auto context = framework.GetBundleContext();
+            auto start = high_resolution_clock::now();
+            for (auto const& location : locations)
+            {
+                context.InstallBundles(location);
+            }
+            auto elapsed = duration_cast<duration<double>>(high_resolution_clock::now() - start);
+            framework.Stop();
+            framework.WaitForStop(milliseconds::zero());
+            return elapsed.count();
+        };
+
+        if (warmCache)
+        {
+            installAll();
+        }
+
+        for (auto _ : state)
+        {
+            if (!warmCache && util::Exists(storage))
+            {
+                util::RemoveDirectoryRecursive(storage);
+            }
+            state.SetIterationTime(installAll());
+        }
+        state.counters["bundles"] = NUM_CACHED_BUNDLES;
+    }
+
     void
     InstallWithCppFramework(benchmark::State& state, std::string const& bundleName)
     {
@@ -138,6 +241,12 @@ BENCHMARK_DEFINE_F(BundleInstallFixture, BundleInstallCppFramework)
 BENCHMARK_DEFINE_F(BundleInstallFixture, LargeBundleInstallCppFramework)
 (benchmark::State& state) { InstallWithCppFramework(state, "largeBundle"); }
 
+BENCHMARK_DEFINE_F(BundleInstallFixture, BundleInstallColdMetadataCache)
+(benchmark::State& state) { InstallWithMetadataCache(state, false); }
+
+BENCHMARK_DEFINE_F(BundleInstallFixture, BundleInstallWarmMetadataCache)
+(benchmark::State& state) { InstallWithMetadataCache(state, true); }
+
 #if defined(PERFORM_LARGE_CONCURRENCY_TEST)
 BENCHMARK_DEFINE_F(BundleInstallFixture, ConcurrentBundleInstall1Thread)
 (benchmark::State& state) { InstallConcurrently(state, 1); }
@@ -157,6 +266,8 @@ BENCHMARK_DEFINE_F(BundleInstallFixture, ConcurrentBundleInstall1ThreadPerBundle
 // Register functions as benchmark
 BENCHMARK_REGISTER_F(BundleInstallFixture, BundleInstallCppFramework)->UseManualTime();
 BENCHMARK_REGISTER_F(BundleInstallFixture, LargeBundleInstallCppFramework)->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, BundleInstallColdMetadataCache)->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, BundleInstallWarmMetadataCache)->UseManualTime();
 #if defined(PERFORM_LARGE_CONCURRENCY_TEST)
 BENCHMARK_REGISTER_F(BundleInstallFixture, ConcurrentBundleInstall1Thread)->UseManualTime();
 BENCHMARK_REGISTER_F(BundleInstallFixture, ConcurrentBundleInstall2Threads)->UseManualTime();
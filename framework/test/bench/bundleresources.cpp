@@ -0,0 +1,79 @@
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/BundleResource.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include "TestUtils.h"
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+
+using namespace cppmicroservices;
+
+class BundleResourceFixture : public ::benchmark::Fixture
+{
+  public:
+    using benchmark::Fixture::SetUp;
+    using benchmark::Fixture::TearDown;
+
+    void
+    SetUp(::benchmark::State const&) override
+    {
+        framework = std::make_unique<Framework>(FrameworkFactory().NewFramework());
+        framework->Start();
+        bundle = testing::InstallLib(framework->GetBundleContext(), "largeBundle");
+    }
+
+    void
+    TearDown(::benchmark::State const&) override
+    {
+        bundle = Bundle();
+        framework->Stop();
+        framework->WaitForStop(std::chrono::milliseconds::zero());
+        framework.reset();
+    }
+
+    ~BundleResourceFixture() override = default;
+
+  protected:
+    void
+    FindResources(benchmark::State& state, std::string const& path, std::string const& pattern, bool recurse)
+    {
+        std::size_t found = 0;
+        for (auto _ : state)
+        {
+            auto resources = bundle.FindResources(path, pattern, recurse);
+            found = resources.size();
+            benchmark::DoNotOptimize(resources);
+        }
+        state.counters["resources"] = static_cast<double>(found);
+    }
+
+    std::unique_ptr<Framework> framework;
+    Bundle bundle;
+};
+
+BENCHMARK_DEFINE_F(BundleResourceFixture, FindResourcesTopLevel)
+(benchmark::State& state) { FindResources(state, "", "*", false); }
+
+BENCHMARK_DEFINE_F(BundleResourceFixture, FindResourcesRecursive)
+(benchmark::State& state) { FindResources(state, "", "*", true); }
+
+BENCHMARK_DEFINE_F(BundleResourceFixture, FindResourcesRecursiveWithPattern)
+(benchmark::State& state) { FindResources(state, "", "*.json", true); }
+
+BENCHMARK_DEFINE_F(BundleResourceFixture, GetResource)
+(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bundle.GetResource("manifest.json"));
+    }
+}
+
+BENCHMARK_REGISTER_F(BundleResourceFixture, FindResourcesTopLevel);
+BENCHMARK_REGISTER_F(BundleResourceFixture, FindResourcesRecursive);
+BENCHMARK_REGISTER_F(BundleResourceFixture, FindResourcesRecursiveWithPattern);
+BENCHMARK_REGISTER_F(BundleResourceFixture, GetResource);
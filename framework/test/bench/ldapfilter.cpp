@@ -60,6 +60,35 @@ MatchFilterWithAnyMap(benchmark::State& state, Filter filter)
     }
 }
 
+// Evaluate a filter with numeric, floating point and boolean leaves against
+// a large set of property maps, as done when filtering many services.
+static void
+MatchTypedFilterWithManyAnyMaps(benchmark::State& state)
+{
+    LDAPFilter filter("(&(service.ranking>=10)(weight<=0.5)(enabled=true)(count=42))");
+
+    std::vector<AnyMap> propsList;
+    for (int i = 0; i < state.range(0); ++i)
+    {
+        AnyMap props(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        props["service.ranking"] = 10 + i % 5;
+        props["weight"] = 0.25;
+        props["enabled"] = true;
+        props["count"] = 42L;
+        propsList.push_back(std::move(props));
+    }
+
+    for (auto _ : state)
+    {
+        for (auto const& props : propsList)
+        {
+            benchmark::DoNotOptimize(filter.Match(props));
+        }
+    }
+    // four leaves are evaluated for each property map
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 4);
+}
+
 // A simple RAII class that wraps the framework and shuts it down
 // when the instance goes out of scope.
 struct ScopedFramework
@@ -134,3 +163,4 @@ BENCHMARK_CAPTURE(MatchFilterWithBundle, Simple, GetSimpleLDAPFilter());
 BENCHMARK_CAPTURE(MatchFilterWithBundle, Complex, GetComplexLDAPFilter());
 BENCHMARK_CAPTURE(MatchFilterWithServiceReference, Simple, GetSimpleLDAPFilter());
 BENCHMARK_CAPTURE(MatchFilterWithServiceReference, Complex, GetComplexLDAPFilter());
+BENCHMARK(MatchTypedFilterWithManyAnyMaps)->Range(64, 4096);
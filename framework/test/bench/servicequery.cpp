@@ -2,6 +2,7 @@
 #include <cppmicroservices/Framework.h>
 #include <cppmicroservices/FrameworkEvent.h>
 #include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/ServiceHandle.h>
 #include <cppmicroservices/ServiceReference.h>
 
 #include <chrono>
@@ -95,6 +96,26 @@ BENCHMARK_DEFINE_F(ServiceFixture, GetAllServiceReferencesByInterfaceAndLDAPFilt
     }
 }
 
+BENCHMARK_DEFINE_F(ServiceFixture, GetServiceByInterface)
+(benchmark::State& state)
+{
+    auto context = framework->GetBundleContext();
+    for (auto _ : state)
+    {
+        (void)context.GetService(context.GetServiceReference<benchmark::test::Foo>());
+    }
+}
+
+BENCHMARK_DEFINE_F(ServiceFixture, GetServiceByServiceHandle)
+(benchmark::State& state)
+{
+    cppmicroservices::ServiceHandle<benchmark::test::Foo> handle(framework->GetBundleContext());
+    for (auto _ : state)
+    {
+        (void)handle.Get();
+    }
+}
+
 // Register benchmark functions
 BENCHMARK_REGISTER_F(ServiceFixture, GetServiceReferenceByInterface);
 BENCHMARK_REGISTER_F(ServiceFixture, GetServiceReferenceByClassName);
@@ -102,3 +123,5 @@ BENCHMARK_REGISTER_F(ServiceFixture, GetAllServiceReferencesByInterface);
 BENCHMARK_REGISTER_F(ServiceFixture, GetAllServiceReferencesByClassName);
 BENCHMARK_REGISTER_F(ServiceFixture, GetAllServiceReferencesByClassNameAndLDAPFilter);
 BENCHMARK_REGISTER_F(ServiceFixture, GetAllServiceReferencesByInterfaceAndLDAPFilter);
+BENCHMARK_REGISTER_F(ServiceFixture, GetServiceByInterface);
+BENCHMARK_REGISTER_F(ServiceFixture, GetServiceByServiceHandle);
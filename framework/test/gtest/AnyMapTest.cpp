@@ -25,6 +25,9 @@ limitations under the License.
 
 #include "gtest/gtest.h"
 
+#include <sstream>
+#include <vector>
+
 using namespace cppmicroservices;
 
 TEST(AnyMapTest, CheckExceptions)
@@ -256,6 +259,90 @@ TEST(AnyMapTest, CIHashUnique)
     ASSERT_EQ(true, hashV1 != hashV2);
 }
 
+TEST(AnyMapTest, FlatMap)
+{
+    AnyMap flat(AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS);
+    ASSERT_EQ(flat.GetType(), AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS);
+    ASSERT_TRUE(flat.empty());
+    ASSERT_TRUE(flat.begin() == flat.end());
+
+    flat["Do"] = 1;
+    flat["re"] = 2;
+    ASSERT_TRUE(flat.insert(std::make_pair(std::string("mi"), Any(3))).second);
+    ASSERT_TRUE(flat.emplace("fa", 4).second);
+
+    // case variants refer to the same entry, which keeps the first spelling
+    flat["DO"] = 10;
+    ASSERT_FALSE(flat.insert(std::make_pair(std::string("RE"), Any(20))).second);
+    ASSERT_FALSE(flat.emplace("Fa", 40).second);
+    ASSERT_EQ(flat.size(), 4u);
+    ASSERT_EQ(flat.count("do"), 1u);
+    ASSERT_EQ(flat.count("sol"), 0u);
+    ASSERT_EQ(flat.find("dO")->first, "Do");
+    ASSERT_EQ(any_cast<int>(flat.at("do")), 10);
+    ASSERT_EQ(any_cast<int>(flat.at("RE")), 2);
+    ASSERT_THROW(flat.at("sol"), std::out_of_range);
+    ASSERT_TRUE(flat.find("sol") == flat.end());
+
+    // entries are iterated in insertion order
+    std::vector<std::string> keys;
+    for (any_map::const_iterator it = flat.begin(); it != flat.end(); ++it)
+    {
+        keys.push_back(it->first);
+    }
+    ASSERT_EQ(keys, (std::vector<std::string> { "Do", "re", "mi", "fa" }));
+
+    AnyMap copy(flat);
+    ASSERT_TRUE(copy == flat);
+    copy["mi"] = 30;
+    ASSERT_TRUE(copy != flat);
+
+    ASSERT_EQ(flat.erase("RE"), 1u);
+    ASSERT_EQ(flat.erase("re"), 0u);
+    ASSERT_EQ(flat.size(), 3u);
+    ASSERT_EQ(any_cast<int>(flat.at("mi")), 3);
+    ASSERT_EQ(any_cast<int>(flat.at("fa")), 4);
+    ASSERT_EQ(flat.begin()->first, "Do");
+
+    // the last entry took the place of the erased one
+    std::ostringstream stream;
+    any_value_to_string(stream, flat);
+    ASSERT_EQ(stream.str(), "{Do : 10, fa : 4, mi : 3}");
+
+    AnyMap moved(std::move(copy));
+    ASSERT_EQ(any_cast<int>(moved.at("MI")), 30);
+
+    flat.clear();
+    ASSERT_TRUE(flat.empty());
+}
+
+TEST(AnyMapTest, FlatMapManyKeys)
+{
+    AnyMap flat(AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS);
+    flat.reserve(10);
+    for (int i = 0; i < 500; ++i)
+    {
+        flat["key" + std::to_string(i)] = i;
+    }
+    for (int i = 0; i < 500; i += 3)
+    {
+        ASSERT_EQ(flat.erase("KEY" + std::to_string(i)), 1u);
+    }
+    for (int i = 0; i < 500; ++i)
+    {
+        auto it = flat.find("Key" + std::to_string(i));
+        if (i % 3 == 0)
+        {
+            ASSERT_TRUE(it == flat.end());
+        }
+        else
+        {
+            ASSERT_TRUE(it != flat.end());
+            ASSERT_EQ(any_cast<int>(it->second), i);
+        }
+    }
+}
+
 TEST(AnyMapTest, GeneralUsage)
 {
     ASSERT_THROW(AnyMap m(static_cast<AnyMap::map_type>(100)), std::logic_error);
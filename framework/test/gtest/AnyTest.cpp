@@ -310,3 +310,91 @@ TEST(AnyTest, AnyEquality)
               rhs); // and finally, with the "int" element erased, they should not be equal
                     // anymore.
 }
+
+namespace
+{
+    // Tracks the number of live instances to detect leaked or doubly destroyed values
+    template <bool NothrowMove, std::size_t Size>
+    struct Counted
+    {
+        static int alive;
+
+        Counted(int v) : value(v) { ++alive; }
+        Counted(Counted const& other) : value(other.value) { ++alive; }
+        Counted(Counted&& other) noexcept(NothrowMove) : value(other.value) { ++alive; }
+        ~Counted() { --alive; }
+
+        bool
+        operator==(Counted const& other) const
+        {
+            return value == other.value;
+        }
+
+        int value;
+        char padding[Size];
+    };
+
+    template <bool NothrowMove, std::size_t Size>
+    int Counted<NothrowMove, Size>::alive = 0;
+
+    template <bool NothrowMove, std::size_t Size>
+    std::ostream&
+    operator<<(std::ostream& os, Counted<NothrowMove, Size> const& c)
+    {
+        return os << c.value;
+    }
+
+    template <typename T>
+    void
+    TestCopyMoveSwap()
+    {
+        {
+            Any a(T(1));
+            Any b(a);
+            EXPECT_EQ(T::alive, 2);
+            EXPECT_EQ(any_cast<T>(b).value, 1);
+
+            Any c(std::move(a));
+            EXPECT_TRUE(a.Empty());
+            EXPECT_EQ(T::alive, 2);
+            EXPECT_EQ(ref_any_cast<T>(c).value, 1);
+
+            Any d(std::string("small"));
+            c.Swap(d);
+            EXPECT_EQ(any_cast<std::string>(c), "small");
+            EXPECT_EQ(ref_any_cast<T>(d).value, 1);
+            d.Swap(d);
+            EXPECT_EQ(ref_any_cast<T>(d).value, 1);
+
+            a = std::move(d);
+            EXPECT_TRUE(d.Empty());
+            EXPECT_EQ(T::alive, 2);
+            auto const& self = a;
+            a = self;
+            EXPECT_EQ(ref_any_cast<T>(a).value, 1);
+
+            b = 42;
+            EXPECT_EQ(T::alive, 1);
+            EXPECT_EQ(any_cast<int>(b), 42);
+
+            std::vector<Any> values(10, a);
+            values.resize(100, b);
+            EXPECT_EQ(T::alive, 11);
+            EXPECT_EQ(ref_any_cast<T>(values[9]).value, 1);
+        }
+        EXPECT_EQ(T::alive, 0);
+    }
+} // namespace
+
+TEST(AnyTest, AnyCopyMoveSwap)
+{
+    // small values are stored inline, others on the heap
+    TestCopyMoveSwap<Counted<true, 1>>();
+    TestCopyMoveSwap<Counted<false, 1>>();
+    TestCopyMoveSwap<Counted<true, 256>>();
+
+    Any s(std::string(1000, 'x'));
+    Any t(std::move(s));
+    EXPECT_TRUE(s.Empty());
+    EXPECT_EQ(ref_any_cast<std::string>(t).size(), 1000u);
+}
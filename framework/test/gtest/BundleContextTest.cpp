@@ -22,6 +22,7 @@
 
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleBatchReport.h"
 #include "cppmicroservices/Constants.h"
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkEvent.h"
@@ -31,11 +32,14 @@
 #include "cppmicroservices/ServiceFactory.h"
 #include "cppmicroservices/ServiceObjects.h"
 #include "cppmicroservices/ServiceReference.h"
+#include "cppmicroservices/util/FileSystem.h"
 
 #include "TestUtils.h"
 #include "TestingConfig.h"
 
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <future>
 #include <thread>
 
@@ -184,3 +188,90 @@ TEST(BundleContextTest, NoSegfaultWithServiceFactory)
     thread.join();
 }
 #endif
+
+#if defined(US_BUILD_SHARED_LIBS)
+namespace
+{
+    std::string
+    BundleLocation(std::string const& libName)
+    {
+        return LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + libName + US_LIB_POSTFIX + US_LIB_EXT;
+    }
+} // namespace
+
+TEST(BundleContextTest, InstallAndStartBundlesInBatch)
+{
+    std::atomic<int> validations { 0 };
+    std::function<bool(Bundle const&)> validationFunc = [&validations](Bundle const&)
+    {
+        ++validations;
+        return true;
+    };
+    cppmicroservices::Framework framework = FrameworkFactory().NewFramework(
+        FrameworkConfiguration { { Constants::FRAMEWORK_BUNDLE_VALIDATION_FUNC, validationFunc } });
+    framework.Start();
+    auto context = framework.GetBundleContext();
+
+    BundleBatchReport report;
+    auto bundles = context.InstallBundles({ BundleLocation("TestBundleA"), BundleLocation("TestBundleH") }, &report);
+    ASSERT_EQ(bundles.size(), 2ul);
+    EXPECT_EQ(bundles[0].GetSymbolicName(), "TestBundleA");
+    EXPECT_EQ(bundles[1].GetSymbolicName(), "TestBundleH");
+    ASSERT_EQ(report.installs.size(), 2ul);
+    for (auto const& timing : report.installs)
+    {
+        EXPECT_EQ(timing.bundleCount, 1ul);
+        EXPECT_FALSE(timing.exception);
+    }
+
+    // A bundle listed twice is started once
+    context.StartBundles({ bundles[0], bundles[1], bundles[0] }, &report);
+    for (auto const& bundle : bundles)
+    {
+        EXPECT_EQ(bundle.GetState(), Bundle::STATE_ACTIVE);
+    }
+    // Preloading validated the bundles, Start() must not validate them again
+    EXPECT_EQ(validations, 2);
+    ASSERT_EQ(report.starts.size(), 2ul);
+    EXPECT_EQ(report.starts[0].bundleId, bundles[0].GetBundleId());
+    EXPECT_EQ(report.starts[1].symbolicName, "TestBundleH");
+    EXPECT_FALSE(report.starts[1].exception);
+
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(BundleContextTest, BatchOperationsContinueAfterFailure)
+{
+    cppmicroservices::Framework framework = FrameworkFactory().NewFramework();
+    framework.Start();
+    auto context = framework.GetBundleContext();
+
+    BundleBatchReport report;
+    std::vector<std::string> const locations { BundleLocation("TestBundleStartFail"),
+                                               BundleLocation("DoesNotExist"),
+                                               BundleLocation("TestBundleA") };
+    EXPECT_THROW(context.InstallBundles(locations, &report), std::runtime_error);
+    ASSERT_EQ(report.installs.size(), 3ul);
+    EXPECT_FALSE(report.installs[0].exception);
+    EXPECT_TRUE(report.installs[1].exception);
+    EXPECT_EQ(report.installs[1].bundleCount, 0ul);
+    EXPECT_FALSE(report.installs[2].exception);
+
+    auto const startFail = context.GetBundles(locations[0]);
+    auto const bundleA = context.GetBundles(locations[2]);
+    ASSERT_EQ(startFail.size(), 1ul);
+    ASSERT_EQ(bundleA.size(), 1ul);
+
+    EXPECT_THROW(context.StartBundles({ startFail[0], bundleA[0] }, &report), std::runtime_error);
+    ASSERT_EQ(report.starts.size(), 2ul);
+    EXPECT_TRUE(report.starts[0].exception);
+    EXPECT_FALSE(report.starts[1].exception);
+    EXPECT_EQ(bundleA[0].GetState(), Bundle::STATE_ACTIVE);
+
+    EXPECT_THROW(context.StartBundles({ Bundle() }), std::invalid_argument);
+
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+#endif
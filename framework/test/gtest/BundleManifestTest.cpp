@@ -33,10 +33,14 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "miniz.h"
 
 #include "../../src/bundle/BundleManifest.h"
 #include "cppmicroservices/BundleResourceStream.h"
 
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 
 US_MSVC_PUSH_DISABLE_WARNING(4996)
@@ -216,6 +220,25 @@ TEST_F(BundleManifestTest, ParseManifest)
     ASSERT_EQ(any_cast<std::vector<Any>>(m["list"]).size(), 2ul);
 }
 
+// The object and array values of the manifest are parsed on the first GetHeaders() call.
+TEST_F(BundleManifestTest, DeferredObjectAndArrayHeaders)
+{
+    auto bundleM = cppmicroservices::testing::InstallLib(framework.GetBundleContext(), "TestBundleM");
+    ASSERT_TRUE(bundleM) << "Failed to install TestBundleM";
+
+    // The scalar headers are available without parsing the deferred values.
+    EXPECT_THAT(bundleM.GetSymbolicName(), ::testing::StrEq("TestBundleM"));
+
+    auto const& headers = bundleM.GetHeaders();
+    EXPECT_EQ(&headers, &bundleM.GetHeaders()) << "The headers must only be built once";
+
+    // The parsed values keep the case insensitive keys of the manifest.
+    auto const& m = ref_any_cast<AnyMap>(headers.at("MAP"));
+    EXPECT_THAT(m.at("String").ToString(), ::testing::StrEq("hi"));
+    EXPECT_EQ(ref_any_cast<std::vector<Any>>(m.at("LIST")).size(), 2ul);
+    EXPECT_EQ(ref_any_cast<std::vector<Any>>(headers.at("Vector")).size(), 3ul);
+}
+
 namespace cppmicroservices
 {
 
@@ -472,4 +495,86 @@ TEST_F(BundleManifestTest, DirectManifestInstallAndStartMultiStatic)
 }
 #endif
 
+namespace
+{
+    // Write a zip file with a manifest-only bundle
+    void
+    WriteManifestBundle(std::string const& path, std::string const& symbolicName, std::string const& manifest)
+    {
+        mz_zip_archive zip;
+        std::memset(&zip, 0, sizeof(mz_zip_archive));
+        ASSERT_TRUE(mz_zip_writer_init_file(&zip, path.c_str(), 0));
+        auto const name = symbolicName + "/manifest.json";
+        ASSERT_TRUE(mz_zip_writer_add_mem(&zip, name.c_str(), manifest.c_str(), manifest.size(), MZ_NO_COMPRESSION));
+        ASSERT_TRUE(mz_zip_writer_finalize_archive(&zip));
+        ASSERT_TRUE(mz_zip_writer_end(&zip));
+    }
+
+    AnyMap
+    InstallAndGetHeaders(FrameworkConfiguration const& config, std::string const& location)
+    {
+        auto f = FrameworkFactory().NewFramework(config);
+        f.Start();
+        auto bundles = f.GetBundleContext().InstallBundles(location);
+        EXPECT_EQ(bundles.size(), 1u);
+        auto headers = bundles.empty() ? AnyMap(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS) : bundles[0].GetHeaders();
+        f.Stop();
+        f.WaitForStop(std::chrono::milliseconds::zero());
+        return headers;
+    }
+
+    std::string
+    MakeCacheTestManifest(std::string const& version)
+    {
+        return R"({ "bundle.symbolic_name" : "cached_manifest", "bundle.version" : ")" + version
+               + R"(", "number" : 5, "double" : 1.5, "flag" : true, "vector" : [ "first", 2 ],)"
+               + R"( "map" : { "string" : "hi", "list" : [ 1, 2 ] } })";
+    }
+} // namespace
+
+TEST(BundleManifestCacheTest, CachedManifestForUnchangedBundle)
+{
+    namespace fs = std::filesystem;
+
+    cppmicroservices::testing::TempDir storage(cppmicroservices::testing::MakeUniqueTempDirectory());
+    auto const location = storage.Path + util::DIR_SEP + "cached_manifest.zip";
+    FrameworkConfiguration const config {
+        {                Constants::FRAMEWORK_STORAGE, storage.Path},
+        {Constants::FRAMEWORK_BUNDLE_METADATA_CACHE,         true}
+    };
+
+    WriteManifestBundle(location, "cached_manifest", MakeCacheTestManifest("1.0.0"));
+
+    // The first install parses the manifest, the second one reads the cache
+    auto const parsed = InstallAndGetHeaders(config, location);
+    auto const cached = InstallAndGetHeaders(config, location);
+    ASSERT_EQ(parsed.size(), cached.size());
+    for (auto const& header : parsed)
+    {
+        ASSERT_EQ(cached.count(header.first), 1u) << header.first;
+        auto const& value = cached.at(header.first);
+        EXPECT_EQ(value.Type(), header.second.Type()) << header.first;
+        if (value.Type() != typeid(AnyMap))
+        {
+            EXPECT_EQ(value.ToString(), header.second.ToString()) << header.first;
+        }
+    }
+    auto const& map = ref_any_cast<AnyMap>(cached.at("map"));
+    EXPECT_EQ(map.GetType(), AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    ASSERT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.at("STRING").ToString(), "hi");
+    EXPECT_EQ(map.at("list").ToString(), "[1,2]");
+
+    // Rewrite the bundle with a manifest of the same size and restore the
+    // modification time, so that the cache entry still matches.
+    auto const modified = fs::last_write_time(location);
+    WriteManifestBundle(location, "cached_manifest", MakeCacheTestManifest("2.0.0"));
+    fs::last_write_time(location, modified);
+    EXPECT_EQ(InstallAndGetHeaders(config, location).at(Constants::BUNDLE_VERSION).ToString(), "1.0.0");
+
+    // A changed modification time invalidates the cache entry
+    fs::last_write_time(location, modified + std::chrono::seconds(10));
+    EXPECT_EQ(InstallAndGetHeaders(config, location).at(Constants::BUNDLE_VERSION).ToString(), "2.0.0");
+}
+
 US_MSVC_POP_WARNING
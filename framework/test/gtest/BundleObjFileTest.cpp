@@ -107,5 +107,34 @@ TEST(BundleObjFile, MappedFile)
         ASSERT_EQ(mappedBundleFile.GetSize(), 0u);
     });
 }
+
+TEST(BundleObjFile, MappedFileRegion)
+{
+    auto mappedBundleFile = std::make_shared<cppmicroservices::MappedFile const>(testBundlePath, 4096, 0);
+    ASSERT_TRUE(mappedBundleFile->GetData());
+
+    cppmicroservices::MappedFileRegion region(mappedBundleFile, 16, 32);
+    ASSERT_EQ(region.GetData(), static_cast<char*>(mappedBundleFile->GetData()) + 16);
+    ASSERT_EQ(region.GetSize(), 32u);
+
+    // Released pages are read in again on the next access
+    char const firstByte = *static_cast<char const*>(region.GetData());
+    region.ReleasePages();
+    ASSERT_EQ(firstByte, *static_cast<char const*>(region.GetData()));
+}
 #    endif // defined (US_PLATFORM_APPLE) || defined (US_PLATFORM_POSIX)
+
+#    if defined(US_PLATFORM_LINUX)
+TEST(BundleObjFile, ElfResourcesSectionIsNotCopied)
+{
+    auto bundleObj = cppmicroservices::BundleObjFactory().CreateBundleFileObj(testBundlePath);
+    auto data = bundleObj->GetRawBundleResourceContainer();
+    ASSERT_TRUE(data);
+
+    // The raw data starts exactly at the embedded zip archive.
+    ASSERT_EQ(0, memcmp(data->GetData(), "PK\x03\x04", 4));
+    data->ReleasePages();
+    ASSERT_EQ(0, memcmp(data->GetData(), "PK\x03\x04", 4));
+}
+#    endif // defined (US_PLATFORM_LINUX)
 #endif     // defined (US_BUILD_SHARED_LIBS)
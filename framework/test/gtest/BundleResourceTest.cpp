@@ -27,8 +27,13 @@ limitations under the License.
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/util/FileSystem.h"
 
 #include "gtest/gtest.h"
+#include "miniz.h"
+
+#include <cstring>
+#include <iterator>
 #include <unordered_set>
 
 using namespace cppmicroservices;
@@ -434,6 +439,44 @@ TEST_F(BundleResourceTest, testCompressedResource)
     ASSERT_TRUE(bmp.eof());
 }
 
+// Compressed resources opened in binary mode are inflated incrementally.
+// Seeking backwards and putting characters back must still work.
+TEST_F(BundleResourceTest, testCompressedResourceSeek)
+{
+    BundleResource res = testBundle.GetResource("/icons/compressable.bmp");
+    ASSERT_LT(res.GetCompressedSize(), res.GetSize());
+
+    std::ifstream bmp(US_FRAMEWORK_SOURCE_DIR "/test/bundles/libRWithResources/resources/icons/compressable.bmp",
+                      std::ifstream::in | std::ifstream::binary);
+    ASSERT_TRUE(bmp.is_open());
+    std::string const expected((std::istreambuf_iterator<char>(bmp)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(expected.size(), 300122u);
+
+    BundleResourceStream rs(res, std::ios_base::binary);
+    std::string data(expected.size(), '\0');
+    ASSERT_TRUE(rs.read(&data[0], data.size()));
+    ASSERT_EQ(data, expected);
+
+    for (std::streamoff const pos : { std::streamoff(200000), std::streamoff(17), std::streamoff(65536) })
+    {
+        rs.clear();
+        rs.seekg(pos);
+        ASSERT_EQ(rs.tellg(), std::streampos(pos));
+        char c = 0;
+        ASSERT_TRUE(rs.get(c));
+        ASSERT_EQ(c, expected[pos]);
+        ASSERT_TRUE(rs.unget());
+        ASSERT_TRUE(rs.unget());
+        ASSERT_TRUE(rs.get(c));
+        ASSERT_EQ(c, expected[pos - 1]);
+    }
+
+    rs.seekg(-10, std::ios_base::end);
+    std::string tail(10, '\0');
+    ASSERT_TRUE(rs.read(&tail[0], tail.size()));
+    ASSERT_EQ(tail, expected.substr(expected.size() - 10));
+}
+
 TEST_F(BundleResourceTest, testResources)
 {
     BundleResource foo = testBundle.GetResource("foo.ptxt");
@@ -534,3 +577,131 @@ TEST_F(BundleResourceDataOnlyTest, TestResourceContainerGetsOpened)
     ASSERT_FALSE(resources.empty());
     ASSERT_EQ(resources.size(), 3);
 }
+
+// Resources stored without compression are read directly from the memory
+// mapped zip file. Streams must stay readable after the bundle is gone.
+TEST_F(BundleResourceDataOnlyTest, StoredResourcesOutliveBundle)
+{
+    cppmicroservices::testing::TempDir tempDir(cppmicroservices::testing::MakeUniqueTempDirectory());
+    auto const zipPath = tempDir.Path + util::DIR_SEP + "stored_resources.zip";
+
+    std::string const manifest = R"({ "bundle.symbolic_name" : "stored_resources" })";
+    std::string content;
+    for (int i = 0; i < 1000; ++i)
+    {
+        content += "line " + std::to_string(i) + "\n";
+    }
+
+    mz_zip_archive zip;
+    std::memset(&zip, 0, sizeof(mz_zip_archive));
+    ASSERT_TRUE(mz_zip_writer_init_file(&zip, zipPath.c_str(), 0));
+    ASSERT_TRUE(mz_zip_writer_add_mem(&zip,
+                                      "stored_resources/manifest.json",
+                                      manifest.c_str(),
+                                      manifest.size(),
+                                      MZ_NO_COMPRESSION));
+    ASSERT_TRUE(
+        mz_zip_writer_add_mem(&zip, "stored_resources/stored.txt", content.c_str(), content.size(), MZ_NO_COMPRESSION));
+    ASSERT_TRUE(mz_zip_writer_add_mem(&zip,
+                                      "stored_resources/deflated.txt",
+                                      content.c_str(),
+                                      content.size(),
+                                      MZ_DEFAULT_COMPRESSION));
+    ASSERT_TRUE(mz_zip_writer_finalize_archive(&zip));
+    ASSERT_TRUE(mz_zip_writer_end(&zip));
+
+    auto bundles = context.InstallBundles(zipPath);
+    ASSERT_EQ(bundles.size(), 1u);
+    auto bundle = bundles.front();
+
+    auto stored = bundle.GetResource("stored.txt");
+    auto deflated = bundle.GetResource("deflated.txt");
+    ASSERT_TRUE(stored.IsValid());
+    ASSERT_TRUE(deflated.IsValid());
+    ASSERT_EQ(stored.GetSize(), static_cast<int>(content.size()));
+    ASSERT_EQ(stored.GetCompressedSize(), stored.GetSize());
+    ASSERT_LT(deflated.GetCompressedSize(), deflated.GetSize());
+
+    auto storedStream = std::make_unique<BundleResourceStream>(stored, std::ios_base::binary);
+    auto deflatedStream = std::make_unique<BundleResourceStream>(deflated, std::ios_base::binary);
+
+    bundle.Uninstall();
+    bundle = Bundle();
+    stored = BundleResource();
+    deflated = BundleResource();
+    bundles.clear();
+
+    ASSERT_EQ(std::string(std::istreambuf_iterator<char>(*storedStream), {}), content);
+    ASSERT_EQ(std::string(std::istreambuf_iterator<char>(*deflatedStream), {}), content);
+}
+
+// FindResources walks the directory tree of the zip file. Entries below a
+// directory without an entry of its own are not part of the tree.
+TEST_F(BundleResourceDataOnlyTest, FindResourcesInNestedDirectories)
+{
+    cppmicroservices::testing::TempDir tempDir(cppmicroservices::testing::MakeUniqueTempDirectory());
+    auto const zipPath = tempDir.Path + util::DIR_SEP + "nested_resources.zip";
+
+    std::string const manifest = R"({ "bundle.symbolic_name" : "nested_resources" })";
+    mz_zip_archive zip;
+    std::memset(&zip, 0, sizeof(mz_zip_archive));
+    ASSERT_TRUE(mz_zip_writer_init_file(&zip, zipPath.c_str(), 0));
+    ASSERT_TRUE(mz_zip_writer_add_mem(&zip,
+                                      "nested_resources/manifest.json",
+                                      manifest.c_str(),
+                                      manifest.size(),
+                                      MZ_DEFAULT_COMPRESSION));
+    for (auto const* name : { "nested_resources/",
+                              "nested_resources/a/",
+                              "nested_resources/a/one.txt",
+                              "nested_resources/a/b/",
+                              "nested_resources/a/b/two.txt",
+                              "nested_resources/a/b/two.txt.bak",
+                              "nested_resources/a/b.txt",
+                              "nested_resources/a/c/three.txt",
+                              "nested_resources/d/" })
+    {
+        ASSERT_TRUE(mz_zip_writer_add_mem(&zip, name, "x", name[std::strlen(name) - 1] == '/' ? 0 : 1, 0));
+    }
+    ASSERT_TRUE(mz_zip_writer_finalize_archive(&zip));
+    ASSERT_TRUE(mz_zip_writer_end(&zip));
+
+    auto bundles = context.InstallBundles(zipPath);
+    ASSERT_EQ(bundles.size(), 1u);
+    auto bundle = bundles.front();
+
+    auto paths = [](std::vector<BundleResource> const& resources)
+    {
+        std::vector<std::string> result;
+        for (auto const& resource : resources)
+        {
+            result.push_back(resource.GetResourcePath());
+        }
+        return result;
+    };
+
+    std::vector<std::string> const topLevel { "/a/", "/d/", "/manifest.json" };
+    ASSERT_EQ(paths(bundle.FindResources("", "*", false)), topLevel);
+
+    std::vector<std::string> const all { "/a/b.txt",         "/a/b/two.txt", "/a/b/two.txt.bak", "/a/b/",
+                                         "/a/one.txt",       "/a/",          "/d/",              "/manifest.json" };
+    auto found = paths(bundle.FindResources("/", "*", true));
+    std::sort(found.begin(), found.end());
+    auto expected = all;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(found, expected);
+
+    std::vector<std::string> const txt { "/a/b.txt", "/a/b/two.txt", "/a/b/two.txt.bak", "/a/one.txt" };
+    found = paths(bundle.FindResources("a", "*.txt", true));
+    std::sort(found.begin(), found.end());
+    ASSERT_EQ(found, txt);
+
+    std::vector<std::string> const bChildren { "/a/b/two.txt", "/a/b/two.txt.bak" };
+    ASSERT_EQ(paths(bundle.FindResources("a/b/", "t*o", false)), bChildren);
+    ASSERT_TRUE(bundle.FindResources("a/c", "*", true).empty());
+
+    auto dir = bundle.GetResource("a/");
+    ASSERT_TRUE(dir.IsDir());
+    std::vector<std::string> const children { "b.txt", "b/", "one.txt" };
+    ASSERT_EQ(dir.GetChildren(), children);
+}
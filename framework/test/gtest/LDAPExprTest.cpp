@@ -191,6 +191,36 @@ TEST(LDAPExprTest, Compare)
     ASSERT_TRUE(ldapMatch.Match(props));
 }
 
+TEST(LDAPExprTest, CompareChangingTypes)
+{
+    // The same filter must match property values of varying types
+    LDAPFilter ldapMatch("(val=1)");
+    AnyMap props(AnyMap::UNORDERED_MAP);
+    for (int i = 0; i < 2; ++i)
+    {
+        props["val"] = 1;
+        ASSERT_TRUE(ldapMatch.Match(props));
+        props["val"] = std::string("1");
+        ASSERT_TRUE(ldapMatch.Match(props));
+        props["val"] = 1.0;
+        ASSERT_TRUE(ldapMatch.Match(props));
+        props["val"] = std::vector<Any> { std::string("0"), 1 };
+        ASSERT_TRUE(ldapMatch.Match(props));
+        props["val"] = 2L;
+        ASSERT_FALSE(ldapMatch.Match(props));
+        props["val"] = std::string("2");
+        ASSERT_FALSE(ldapMatch.Match(props));
+    }
+
+    ldapMatch = LDAPFilter("(val=TRUE)");
+    props["val"] = true;
+    ASSERT_TRUE(ldapMatch.Match(props));
+    props["val"] = false;
+    ASSERT_FALSE(ldapMatch.Match(props));
+    props["val"] = std::string("TRUE");
+    ASSERT_TRUE(ldapMatch.Match(props));
+}
+
 TEST(LDAPExprTest, CompareString)
 {
     // Testing string greater-equal, less-equal and approx. filters.
@@ -123,6 +123,39 @@ TEST(LDAPFilter, TestParsing)
     EXPECT_THROW(LDAPFilter ldap("cn=Babs Jensen)"), std::invalid_argument);
 }
 
+TEST(LDAPFilter, TestRepeatedParsing)
+{
+    // Compiled filters are cached by their string representation. Make sure
+    // repeated construction yields equivalent filters and that malformed
+    // filters keep failing instead of being cached.
+    auto const before = LDAPFilter::GetCacheStatistics();
+    for (int i = 0; i < 3; ++i)
+    {
+        LDAPFilter ldap("(&(cn=Babs Jensen)(sn=TestRepeatedParsing))");
+        ASSERT_EQ(ldap.ToString(), "(&(cn=Babs Jensen)(sn=TestRepeatedParsing))");
+        EXPECT_THROW(LDAPFilter malformed("cn=Babs Jensen)"), std::invalid_argument);
+    }
+    auto const after = LDAPFilter::GetCacheStatistics();
+    // the valid filter is parsed once and found twice, the malformed one is parsed every time.
+    // The cache is shared by the whole process, so other filters parsed meanwhile may add to
+    // the counters.
+    EXPECT_GE(after.hits - before.hits, 2u);
+    EXPECT_GE(after.misses - before.misses, 4u);
+
+    // More distinct filters than the cache can hold
+    for (int i = 0; i < 5000; ++i)
+    {
+        std::string const filter = "(id=" + std::to_string(i) + ")";
+        LDAPFilter ldap(filter);
+        AnyMap props(AnyMap::UNORDERED_MAP);
+        props["id"] = i;
+        ASSERT_TRUE(ldap.Match(props)) << filter;
+    }
+    auto const bounded = LDAPFilter::GetCacheStatistics();
+    EXPECT_LE(bounded.size, bounded.capacity);
+    EXPECT_GE(bounded.misses - after.misses, 5000u);
+}
+
 TEST(LDAPFilter, TestEvaluate)
 {
     // EVALUATE
@@ -168,3 +201,24 @@ TEST(LDAPFilter, TestEvaluate)
     props["prop"] = std::string("foo(bar)");
     ASSERT_TRUE(ldap.Match(props));
 }
+
+TEST(LDAPFilter, TestMatchWithDefaults)
+{
+    AnyMap props(AnyMap::UNORDERED_MAP);
+    props["cn"] = std::string("Babs Jensen");
+    AnyMap defaults(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    defaults["SN"] = std::string("Jensen");
+    defaults["cn"] = std::string("Tim Howes");
+
+    // keys missing from the properties are found in the defaults
+    ASSERT_TRUE(LDAPFilter("(&(cn=Babs *)(sn=Jensen))").Match(props, defaults));
+    ASSERT_FALSE(LDAPFilter("(&(cn=Babs *)(sn=Jensen))").Match(props));
+
+    // the properties take precedence
+    ASSERT_FALSE(LDAPFilter("(cn=Tim Howes)").Match(props, defaults));
+    ASSERT_TRUE(LDAPFilter("(!(cn=Tim Howes))").Match(props, defaults));
+
+    // negation of a key which is in neither map
+    ASSERT_TRUE(LDAPFilter("(!(o=*))").Match(props, defaults));
+    ASSERT_FALSE(LDAPFilter("(!(sn=*))").Match(props, defaults));
+}
@@ -0,0 +1,136 @@
+/*=============================================================================
+
+Library: CppMicroServices
+
+Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+file at the top-level directory of this distribution and at
+https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+=============================================================================*/
+
+#include "cppmicroservices/ServiceHandle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+using namespace cppmicroservices;
+
+namespace
+{
+    struct ITestServiceHandle
+    {
+        virtual ~ITestServiceHandle() {}
+    };
+
+    struct TestServiceHandleImpl : public ITestServiceHandle
+    {
+    };
+
+    struct IOtherService
+    {
+        virtual ~IOtherService() {}
+    };
+
+    struct OtherServiceImpl : public IOtherService
+    {
+    };
+
+    class ServiceHandleTest : public ::testing::Test
+    {
+      protected:
+        void
+        SetUp() override
+        {
+            framework.Start();
+            context = framework.GetBundleContext();
+        }
+
+        void
+        TearDown() override
+        {
+            framework.Stop();
+            framework.WaitForStop(std::chrono::milliseconds::zero());
+        }
+
+        Framework framework { FrameworkFactory().NewFramework() };
+        BundleContext context;
+    };
+} // namespace
+
+TEST_F(ServiceHandleTest, FollowsHighestRankedService)
+{
+    ServiceHandle<ITestServiceHandle> handle(context);
+    ASSERT_EQ(handle.Get(), nullptr);
+    ASSERT_FALSE(handle.GetServiceReference());
+
+    auto s1 = std::make_shared<TestServiceHandleImpl>();
+    auto reg1 = context.RegisterService<ITestServiceHandle>(s1);
+    ASSERT_EQ(handle.Get(), s1);
+    ASSERT_EQ(handle.GetServiceReference(), reg1.GetReference());
+
+    // Registering an unrelated service keeps the current service
+    auto otherReg = context.RegisterService<IOtherService>(std::make_shared<OtherServiceImpl>());
+    ASSERT_EQ(handle.Get(), s1);
+
+    ServiceProperties props;
+    props[Constants::SERVICE_RANKING] = 10;
+    auto s2 = std::make_shared<TestServiceHandleImpl>();
+    auto reg2 = context.RegisterService<ITestServiceHandle>(s2, props);
+    ASSERT_EQ(handle.Get(), s2);
+
+    // Re-ranking the first service switches back to it
+    props[Constants::SERVICE_RANKING] = 20;
+    reg1.SetProperties(props);
+    ASSERT_EQ(handle.Get(), s1);
+
+    reg1.Unregister();
+    ASSERT_EQ(handle.Get(), s2);
+
+    reg2.Unregister();
+    ASSERT_EQ(handle.Get(), nullptr);
+    ASSERT_FALSE(handle.GetServiceReference());
+
+    otherReg.Unregister();
+}
+
+TEST_F(ServiceHandleTest, KeepsServiceInUse)
+{
+    auto reg = context.RegisterService<ITestServiceHandle>(std::make_shared<TestServiceHandleImpl>());
+    auto ref = reg.GetReference();
+
+    {
+        ServiceHandle<ITestServiceHandle> handle(context);
+        ASSERT_NE(handle.Get(), nullptr);
+        ASSERT_NE(handle.Get(), nullptr);
+        ASSERT_EQ(ref.GetUsingBundles().size(), 1u);
+
+        // Copies are independent of each other
+        auto copy = handle;
+        ASSERT_EQ(copy.Get(), handle.Get());
+    }
+    ASSERT_TRUE(ref.GetUsingBundles().empty());
+
+    reg.Unregister();
+}
+
+TEST_F(ServiceHandleTest, InvalidContext)
+{
+    ASSERT_THROW(ServiceHandle<ITestServiceHandle> { BundleContext() }, std::runtime_error);
+}
@@ -209,6 +209,28 @@ namespace
         }
     };
 
+    // A find hook which looks up services itself, which requires that
+    // find hooks are not called with the service registry lock held
+    class TestServiceFindHookLookup : public ServiceFindHook
+    {
+      public:
+        void
+        Find(BundleContext const& context,
+             std::string const& name,
+             std::string const& /*filter*/,
+             ShrinkableVector<ServiceReferenceBase>& /*references*/)
+        {
+            // the nested lookup calls this hook again with an empty name
+            if (name == us_service_interface_iid<ServiceFindHook>())
+            {
+                BundleContext ctx(context);
+                lookups += ctx.GetServiceReferences("", "(" + Constants::OBJECTCLASS + "=" + name + ")").size();
+            }
+        }
+
+        std::size_t lookups = 0;
+    };
+
     class TestServiceListenerHook : public ServiceListenerHook
     {
       private:
@@ -439,6 +461,50 @@ TEST_F(ServiceHooksTest, TestFindHook)
     context.RemoveServiceListener(&serviceListener, &TestServiceListener::ServiceChanged);
 }
 
+TEST_F(ServiceHooksTest, TestFindHookRanking)
+{
+    TestServiceFindHook::ordering.clear();
+
+    auto serviceFindHook1 = std::make_shared<TestServiceFindHook>(1, context);
+    ServiceProperties hookProps1;
+    hookProps1[Constants::SERVICE_RANKING] = 10;
+    auto findHookReg1 = context.RegisterService<ServiceFindHook>(serviceFindHook1, hookProps1);
+
+    auto serviceFindHook2 = std::make_shared<TestServiceFindHook>(2, context);
+    ServiceProperties hookProps2;
+    hookProps2[Constants::SERVICE_RANKING] = 0;
+    auto findHookReg2 = context.RegisterService<ServiceFindHook>(serviceFindHook2, hookProps2);
+
+    ASSERT_TRUE(context.GetServiceReferences<ServiceFindHook>().empty());
+    ASSERT_EQ(TestServiceFindHook::ordering, (std::vector<int> { 1, 2 }));
+
+    // Re-ranking a hook changes the call order
+    hookProps2[Constants::SERVICE_RANKING] = 20;
+    findHookReg2.SetProperties(hookProps2);
+    TestServiceFindHook::ordering.clear();
+    context.GetServiceReferences<ServiceFindHook>();
+    ASSERT_EQ(TestServiceFindHook::ordering, (std::vector<int> { 2, 1 }));
+
+    // Unregistered hooks are no longer called
+    findHookReg2.Unregister();
+    TestServiceFindHook::ordering.clear();
+    context.GetServiceReferences<ServiceFindHook>();
+    ASSERT_EQ(TestServiceFindHook::ordering, (std::vector<int> { 1 }));
+
+    findHookReg1.Unregister();
+}
+
+TEST_F(ServiceHooksTest, TestFindHookLookup)
+{
+    auto lookupHook = std::make_shared<TestServiceFindHookLookup>();
+    auto lookupHookReg = context.RegisterService<ServiceFindHook>(lookupHook);
+
+    ASSERT_EQ(context.GetServiceReferences<ServiceFindHook>().size(), 1u);
+    ASSERT_EQ(lookupHook->lookups, 1u);
+
+    lookupHookReg.Unregister();
+}
+
 TEST_F(ServiceHooksTest, TestEventListenerHook)
 {
     TestServiceListener serviceListener1;
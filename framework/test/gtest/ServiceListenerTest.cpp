@@ -36,6 +36,14 @@
 
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
 US_MSVC_PUSH_DISABLE_WARNING(4996)
 
 using namespace cppmicroservices;
@@ -398,4 +406,205 @@ TEST_F(ServiceListenerTest, frameSL25a)
     sListen.clearEvents();
 }
 
+namespace
+{
+    struct IndexedListenerService
+    {
+        virtual ~IndexedListenerService() = default;
+    };
+} // namespace
+
+// Listeners with conjunctive filters are indexed by one of their equality terms.
+// Check that exactly the matching listeners are notified, whatever term is used.
+TEST_F(ServiceListenerTest, ConjunctiveFilterListeners)
+{
+    auto context = framework.GetBundleContext();
+    std::string const objectClass = us_service_interface_iid<IndexedListenerService>();
+
+    std::map<std::string, int> calls;
+    std::map<std::string, ListenerToken> tokens;
+    auto addListener = [&](std::string const& name, std::string const& filter)
+    {
+        tokens[name] = context.AddServiceListener(
+            [&calls, name](ServiceEvent const& evt)
+            {
+                if (evt.GetType() == ServiceEvent::SERVICE_REGISTERED)
+                {
+                    ++calls[name];
+                }
+            },
+            filter);
+    };
+
+    for (int i = 0; i < 50; ++i)
+    {
+        auto const n = std::to_string(i);
+        addListener("component" + n, "(&(objectclass=" + objectClass + ")(component.name=c" + n + "))");
+    }
+    addListener("caseInsensitive", "(&(Component.Name=c7)(objectclass=" + objectClass + "))");
+    addListener("nested", "(&(component.name=c7)(&(rank=5)(!(disabled=true))))");
+    addListener("wrongRank", "(&(rank=6)(component.name=c7))");
+    addListener("numeric", "(&(rank=5)(objectclass=" + objectClass + "))");
+    addListener("wildcard", "(&(component.name=c*)(rank=5))");
+    addListener("missingProperty", "(&(unknown=1)(component.name=c7))");
+    addListener("removed", "(&(component.name=c7)(rank=5))");
+    context.RemoveListener(std::move(tokens["removed"]));
+
+    context.RegisterService<IndexedListenerService>(std::make_shared<IndexedListenerService>(),
+                                                    { { "component.name", std::string("c7") }, { "rank", 5 } });
+
+    std::map<std::string, int> expected { { "component7", 1 }, { "caseInsensitive", 1 }, { "nested", 1 },
+                                          { "numeric", 1 },    { "wildcard", 1 } };
+    ASSERT_EQ(calls, expected);
+}
+
+
+namespace
+{
+    // Records service events delivered on the dispatcher threads.
+    class AsyncEventRecorder
+    {
+      public:
+        using Event = std::pair<ServiceEvent::Type, std::string>;
+
+        void
+        Record(ServiceEvent const& evt)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (std::this_thread::get_id() == callerThread)
+            {
+                deliveredOnCallerThread = true;
+            }
+            events.emplace_back(evt.GetType(), any_cast<std::string>(evt.GetServiceReference().GetProperty("name")));
+            changed.notify_all();
+        }
+
+        bool
+        WaitFor(std::size_t count)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            return changed.wait_for(lock, std::chrono::seconds(30), [&] { return events.size() >= count; });
+        }
+
+        std::vector<Event>
+        Events()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return events;
+        }
+
+        std::thread::id const callerThread = std::this_thread::get_id();
+        bool deliveredOnCallerThread = false;
+
+      private:
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::vector<Event> events;
+    };
+} // namespace
+
+// With asynchronous delivery, events are delivered on the dispatcher threads
+// in the order in which each listener would have received them synchronously.
+TEST(ServiceListenerAsyncTest, DeliveryOrder)
+{
+    auto f = FrameworkFactory().NewFramework(
+        FrameworkConfiguration { { Constants::FRAMEWORK_SERVICE_EVENTS_ASYNC, true } });
+    f.Start();
+    auto ctx = f.GetBundleContext();
+
+    AsyncEventRecorder recorder;
+    auto token = ctx.AddServiceListener([&recorder](ServiceEvent const& evt) { recorder.Record(evt); },
+                                        "(objectclass=" + us_service_interface_iid<IndexedListenerService>() + ")");
+
+    int const count = 100;
+    std::vector<ServiceRegistration<IndexedListenerService>> regs;
+    std::vector<AsyncEventRecorder::Event> expected;
+    for (int i = 0; i < count; ++i)
+    {
+        auto const name = std::to_string(i);
+        regs.push_back(ctx.RegisterService<IndexedListenerService>(std::make_shared<IndexedListenerService>(),
+                                                                   { { "name", name } }));
+        expected.emplace_back(ServiceEvent::SERVICE_REGISTERED, name);
+    }
+    ASSERT_TRUE(recorder.WaitFor(count));
+
+    for (int i = 0; i < count; ++i)
+    {
+        regs[i].Unregister();
+        expected.emplace_back(ServiceEvent::SERVICE_UNREGISTERING, std::to_string(i));
+    }
+    ASSERT_TRUE(recorder.WaitFor(2 * count));
+
+    ASSERT_EQ(recorder.Events(), expected);
+    ASSERT_FALSE(recorder.deliveredOnCallerThread);
+
+    ctx.RemoveListener(std::move(token));
+    f.Stop();
+    f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+// Events which became redundant while pending are not delivered.
+TEST(ServiceListenerAsyncTest, Coalescing)
+{
+    auto f = FrameworkFactory().NewFramework(
+        FrameworkConfiguration { { Constants::FRAMEWORK_SERVICE_EVENTS_ASYNC, true } });
+    f.Start();
+    auto ctx = f.GetBundleContext();
+
+    std::mutex gateMutex;
+    std::condition_variable gateChanged;
+    bool blocked = false;
+    bool released = false;
+
+    AsyncEventRecorder recorder;
+    auto token = ctx.AddServiceListener(
+        [&](ServiceEvent const& evt)
+        {
+            recorder.Record(evt);
+            // keep the first event pending, so that the next ones queue up
+            std::unique_lock<std::mutex> lock(gateMutex);
+            blocked = true;
+            gateChanged.notify_all();
+            gateChanged.wait(lock, [&] { return released; });
+        },
+        "(objectclass=" + us_service_interface_iid<IndexedListenerService>() + ")");
+
+    auto regA = ctx.RegisterService<IndexedListenerService>(std::make_shared<IndexedListenerService>(),
+                                                            { { "name", std::string("A") } });
+    {
+        std::unique_lock<std::mutex> lock(gateMutex);
+        ASSERT_TRUE(gateChanged.wait_for(lock, std::chrono::seconds(30), [&] { return blocked; }));
+    }
+
+    // unregistered before the listener could see it
+    auto regB = ctx.RegisterService<IndexedListenerService>(std::make_shared<IndexedListenerService>(),
+                                                            { { "name", std::string("B") } });
+    regB.SetProperties({ { "name", std::string("B") }, { "rank", 1 } });
+    regB.SetProperties({ { "name", std::string("B") }, { "rank", 2 } });
+    // modified before the listener could see it
+    auto regC = ctx.RegisterService<IndexedListenerService>(std::make_shared<IndexedListenerService>(),
+                                                            { { "name", std::string("C") } });
+    regC.SetProperties({ { "name", std::string("C") }, { "rank", 1 } });
+    regB.Unregister();
+
+    {
+        std::lock_guard<std::mutex> lock(gateMutex);
+        released = true;
+        gateChanged.notify_all();
+    }
+
+    auto regD = ctx.RegisterService<IndexedListenerService>(std::make_shared<IndexedListenerService>(),
+                                                            { { "name", std::string("D") } });
+    ASSERT_TRUE(recorder.WaitFor(3));
+
+    std::vector<AsyncEventRecorder::Event> expected { { ServiceEvent::SERVICE_REGISTERED, "A" },
+                                                      { ServiceEvent::SERVICE_REGISTERED, "C" },
+                                                      { ServiceEvent::SERVICE_REGISTERED, "D" } };
+    ASSERT_EQ(recorder.Events(), expected);
+
+    ctx.RemoveListener(std::move(token));
+    f.Stop();
+    f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
 US_MSVC_POP_WARNING
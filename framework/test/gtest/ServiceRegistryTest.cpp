@@ -28,6 +28,8 @@
 #include "TestUtils.h"
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <thread>
 #include <unordered_set>
 
 using namespace cppmicroservices;
@@ -205,3 +207,280 @@ TEST_F(ServiceRegistryTest, TestServicePropertiesUpdate)
     reg2.Unregister();
     ASSERT_TRUE(context.GetServiceReferences<ITestServiceA>().empty());
 }
+
+TEST_F(ServiceRegistryTest, TestManyUnregistrations)
+{
+    // Enough registrations to exercise compaction of unregistered entries
+    std::vector<ServiceRegistration<ITestServiceA>> regs;
+    for (int i = 0; i < 200; ++i)
+    {
+        regs.push_back(context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>()));
+    }
+    ASSERT_EQ(context.GetServiceReferences<ITestServiceA>().size(), 200);
+
+    for (std::size_t i = 0; i < regs.size(); i += 2)
+    {
+        regs[i].Unregister();
+    }
+    ASSERT_EQ(context.GetServiceReferences<ITestServiceA>().size(), 100);
+    ASSERT_EQ(context.GetServiceReferences("", "(objectclass=ITestServiceA)").size(), 100);
+
+    // registered services are reported in registration order
+    auto registered = framework.GetRegisteredServices();
+    ASSERT_EQ(registered.size(), 100);
+    for (std::size_t i = 0; i < registered.size(); ++i)
+    {
+        ASSERT_EQ(registered[i], regs[2 * i + 1].GetReference());
+    }
+
+    for (std::size_t i = 1; i < regs.size(); i += 2)
+    {
+        regs[i].Unregister();
+    }
+    ASSERT_TRUE(context.GetServiceReferences<ITestServiceA>().empty());
+    ASSERT_TRUE(framework.GetRegisteredServices().empty());
+}
+
+TEST_F(ServiceRegistryTest, TestRankingWithUnregisteredEntries)
+{
+    // Unregister fewer than half of the services so that the unregistered
+    // entries are not compacted away by the unregistrations themselves.
+    std::vector<ServiceRegistration<ITestServiceA>> regs;
+    for (int i = 0; i < 40; ++i)
+    {
+        regs.push_back(context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>(),
+                                                              { { Constants::SERVICE_RANKING, Any(i) } }));
+    }
+    for (std::size_t i = 0; i < regs.size(); i += 4)
+    {
+        regs[i].Unregister();
+    }
+
+    // inserting and re-ranking must keep the services ordered by ranking
+    auto best = context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>(),
+                                                       { { Constants::SERVICE_RANKING, Any(100) } });
+    regs[1].SetProperties({ { Constants::SERVICE_RANKING, Any(200) } });
+
+    auto refs = context.GetServiceReferences<ITestServiceA>();
+    ASSERT_EQ(refs.size(), 31);
+    ASSERT_EQ(refs[0], regs[1].GetReference());
+    ASSERT_EQ(refs[1], best.GetReference());
+    for (std::size_t i = 2; i < refs.size(); ++i)
+    {
+        ASSERT_TRUE(refs[i] < refs[i - 1]);
+    }
+}
+
+TEST_F(ServiceRegistryTest, TestServicesInUse)
+{
+    auto reg1 = context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>());
+    auto reg2 = context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>());
+    ASSERT_TRUE(framework.GetServicesInUse().empty());
+
+    auto s2 = context.GetService(reg2.GetReference());
+    auto s1 = context.GetService(reg1.GetReference());
+    auto inUse = framework.GetServicesInUse();
+    ASSERT_EQ(inUse.size(), 2);
+    ASSERT_EQ(inUse[0], reg1.GetReference());
+    ASSERT_EQ(inUse[1], reg2.GetReference());
+
+    s1.reset();
+    inUse = framework.GetServicesInUse();
+    ASSERT_EQ(inUse.size(), 1);
+    ASSERT_EQ(inUse[0], reg2.GetReference());
+
+    // unregistering a service in use removes it from the uses of all bundles
+    reg2.Unregister();
+    ASSERT_TRUE(framework.GetServicesInUse().empty());
+    s2.reset();
+    ASSERT_TRUE(framework.GetServicesInUse().empty());
+
+    reg1.Unregister();
+}
+
+TEST(ServiceRegistrySnapshotTest, TestLookupsSeeModifications)
+{
+    auto f = FrameworkFactory().NewFramework(
+        FrameworkConfiguration { { Constants::FRAMEWORK_SERVICE_REGISTRY_SNAPSHOT, true } });
+    f.Start();
+    auto ctx = f.GetBundleContext();
+
+    auto s1 = std::make_shared<TestServiceA>();
+    auto reg1 = ctx.RegisterService<ITestServiceA>(s1);
+    ASSERT_EQ(ctx.GetServiceReferences<ITestServiceA>().size(), 1);
+    ASSERT_EQ(ctx.GetServiceReferences("", "(objectclass=ITestServiceA)").size(), 1);
+
+    // a class registered after the first lookup, and lookups of all services
+    auto const allServices = ctx.GetServiceReferences("", "").size();
+    auto regB = ctx.RegisterService<ITestServiceB>(std::make_shared<ITestServiceB>());
+    ASSERT_EQ(ctx.GetServiceReferences<ITestServiceB>().size(), 1);
+    ASSERT_EQ(ctx.GetServiceReferences("", "").size(), allServices + 1);
+    regB.Unregister();
+    ASSERT_TRUE(ctx.GetServiceReferences<ITestServiceB>().empty());
+    ASSERT_EQ(ctx.GetServiceReferences("", "").size(), allServices);
+    // the class is dropped from the snapshot with its last service, and added again
+    regB = ctx.RegisterService<ITestServiceB>(std::make_shared<ITestServiceB>());
+    ASSERT_EQ(ctx.GetServiceReferences<ITestServiceB>().size(), 1);
+    regB.Unregister();
+    ASSERT_TRUE(ctx.GetServiceReferences<ITestServiceB>().empty());
+
+    auto s2 = std::make_shared<TestServiceA>();
+    auto reg2 = ctx.RegisterService<ITestServiceA>(s2, { { Constants::SERVICE_RANKING, Any(10) } });
+    ASSERT_EQ(ctx.GetServiceReferences<ITestServiceA>().size(), 2);
+    ASSERT_EQ(ctx.GetService(ctx.GetServiceReference<ITestServiceA>()), s2);
+
+    // re-ranking must be visible to subsequent lookups
+    reg1.SetProperties({ { Constants::SERVICE_RANKING, Any(20) } });
+    ASSERT_EQ(ctx.GetService(ctx.GetServiceReference<ITestServiceA>()), s1);
+
+    reg1.Unregister();
+    ASSERT_EQ(ctx.GetServiceReferences<ITestServiceA>().size(), 1);
+    reg2.Unregister();
+    ASSERT_FALSE(ctx.GetServiceReference<ITestServiceA>());
+
+    f.Stop();
+    f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(ServiceRegistrySnapshotTest, TestConcurrentLookups)
+{
+    auto f = FrameworkFactory().NewFramework(
+        FrameworkConfiguration { { Constants::FRAMEWORK_SERVICE_REGISTRY_SNAPSHOT, true } });
+    f.Start();
+    auto ctx = f.GetBundleContext();
+
+    auto reg = ctx.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>());
+
+    std::atomic<bool> lookupFailed(false);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [&ctx, &lookupFailed]()
+            {
+                for (int j = 0; j < 500; ++j)
+                {
+                    if (ctx.GetServiceReferences<ITestServiceA>().empty())
+                    {
+                        lookupFailed = true;
+                    }
+                }
+            });
+    }
+
+    // concurrently modify the registry
+    for (int i = 0; i < 100; ++i)
+    {
+        ctx.RegisterService<ITestServiceB>(std::make_shared<ITestServiceB>()).Unregister();
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    ASSERT_FALSE(lookupFailed);
+
+    reg.Unregister();
+    f.Stop();
+    f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(ServiceRegistryMetricsTest, TestDisabledByDefault)
+{
+    auto f = FrameworkFactory().NewFramework();
+    f.Start();
+    auto ctx = f.GetBundleContext();
+
+    auto reg = ctx.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>());
+    ASSERT_TRUE(ctx.GetServiceReference<ITestServiceA>());
+
+    auto metrics = f.GetServiceRegistryMetrics();
+    ASSERT_FALSE(metrics.enabled);
+    ASSERT_EQ(metrics.registrations, 0);
+    ASSERT_EQ(metrics.serviceRegistryLock.acquisitions, 0);
+    ASSERT_TRUE(metrics.topInterfaces.empty());
+
+    reg.Unregister();
+    f.Stop();
+    f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(ServiceRegistryMetricsTest, TestCountersAndTopQueries)
+{
+    auto f = FrameworkFactory().NewFramework(
+        FrameworkConfiguration { { Constants::FRAMEWORK_SERVICE_REGISTRY_METRICS, true } });
+    f.Start();
+    auto ctx = f.GetBundleContext();
+    auto const before = f.GetServiceRegistryMetrics();
+    ASSERT_TRUE(before.enabled);
+
+    int listenerCalls = 0;
+    auto token = ctx.AddServiceListener([&listenerCalls](ServiceEvent const&) { ++listenerCalls; },
+                                        "(objectclass=ITestServiceA)");
+
+    auto reg1 = ctx.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>());
+    auto reg2 = ctx.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>(),
+                                                   { { "flavor", Any(std::string("mint")) } });
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(ctx.GetServiceReference<ITestServiceA>());
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(ctx.GetServiceReferences<ITestServiceA>("(flavor=mint)").size(), 1);
+    }
+    reg1.Unregister();
+    reg2.Unregister();
+    ctx.RemoveListener(std::move(token));
+
+    auto const metrics = f.GetServiceRegistryMetrics(1);
+    ASSERT_EQ(metrics.registrations - before.registrations, 2);
+    ASSERT_EQ(metrics.unregistrations - before.unregistrations, 2);
+    ASSERT_GE(metrics.lookupsByClass - before.lookupsByClass, 5);
+    // Both services were matched against the lookup filter, twice
+    ASSERT_GE(metrics.filterEvaluations - before.filterEvaluations, 4);
+    ASSERT_EQ(listenerCalls, 4);
+    ASSERT_GE(metrics.listenerInvocations - before.listenerInvocations, 4);
+
+    ASSERT_EQ(metrics.topInterfaces.size(), 1);
+    ASSERT_EQ(metrics.topInterfaces[0].first, us_service_interface_iid<ITestServiceA>());
+    ASSERT_EQ(metrics.topFilters.size(), 1);
+    ASSERT_EQ(metrics.topFilters[0], std::make_pair(std::string("(flavor=mint)"), std::uint64_t(2)));
+
+    for (auto const* histogram :
+         { &metrics.serviceRegistryLock, &metrics.serviceListenersLock, &metrics.propertiesLock })
+    {
+        ASSERT_GT(histogram->acquisitions, 0);
+        ASSERT_EQ(histogram->counts.size(), histogram->upperBounds.size() + 1);
+        std::uint64_t total = 0;
+        for (auto count : histogram->counts)
+        {
+            total += count;
+        }
+        ASSERT_EQ(total, histogram->acquisitions);
+    }
+
+    f.Stop();
+    f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(ServiceRegistryMetricsTest, TestPropertiesLockAfterSetProperties)
+{
+    auto f = FrameworkFactory().NewFramework(
+        FrameworkConfiguration { { Constants::FRAMEWORK_SERVICE_REGISTRY_METRICS, true } });
+    f.Start();
+    auto ctx = f.GetBundleContext();
+
+    auto reg = ctx.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>());
+    reg.SetProperties({ { "flavor", Any(std::string("mint")) } });
+
+    // The new properties of the service keep recording the waits for their lock
+    auto const before = f.GetServiceRegistryMetrics();
+    ASSERT_EQ(reg.GetReference().GetProperty("flavor").ToString(), "mint");
+    auto const after = f.GetServiceRegistryMetrics();
+    ASSERT_GT(after.propertiesLock.acquisitions, before.propertiesLock.acquisitions);
+
+    reg.Unregister();
+    f.Stop();
+    f.WaitForStop(std::chrono::milliseconds::zero());
+}
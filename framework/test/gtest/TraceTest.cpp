@@ -0,0 +1,144 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/Trace.h"
+
+#include "TestUtils.h"
+
+#include "gtest/gtest.h"
+#include "json/json.h"
+
+#include <set>
+#include <sstream>
+
+using namespace cppmicroservices;
+
+namespace
+{
+    Json::Value
+    ParseChromeTrace()
+    {
+        std::stringstream trace;
+        Tracer::WriteChromeTrace(trace);
+
+        Json::Value root;
+        Json::Reader reader;
+        EXPECT_TRUE(reader.parse(trace, root)) << reader.getFormattedErrorMessages();
+        return root;
+    }
+
+    std::set<std::string>
+    SpanNames(Json::Value const& root)
+    {
+        std::set<std::string> names;
+        for (auto const& event : root["traceEvents"])
+        {
+            names.insert(event["name"].asString());
+        }
+        return names;
+    }
+
+    class TraceTest : public ::testing::Test
+    {
+      protected:
+        void
+        TearDown() override
+        {
+            Tracer::Disable();
+            Tracer::Clear();
+        }
+    };
+} // namespace
+
+TEST_F(TraceTest, DisabledByDefault)
+{
+    ASSERT_FALSE(Tracer::IsEnabled());
+    {
+        detail::TraceSpan span("TraceTest::Disabled");
+    }
+    EXPECT_EQ(ParseChromeTrace()["traceEvents"].size(), 0u);
+}
+
+TEST_F(TraceTest, RingBufferKeepsNewestSpans)
+{
+    Tracer::Enable(2);
+    for (std::string const spanDetail : { "first", "second", "third\n\"quoted\"" })
+    {
+        detail::TraceSpan span("TraceTest::Span", spanDetail);
+    }
+
+    auto const root = ParseChromeTrace();
+    auto const& events = root["traceEvents"];
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0]["args"]["detail"].asString(), "second");
+    EXPECT_EQ(events[1]["args"]["detail"].asString(), "third\n\"quoted\"");
+    EXPECT_EQ(events[1]["ph"].asString(), "X");
+    EXPECT_GE(events[1]["ts"].asDouble(), events[0]["ts"].asDouble());
+    EXPECT_GE(events[1]["dur"].asDouble(), 0.0);
+}
+
+TEST_F(TraceTest, SpanNamesAreCopied)
+{
+    Tracer::Enable();
+    auto const now = std::chrono::steady_clock::now();
+    {
+        std::string name = "TraceTest::Temporary";
+        Tracer::Record(name.c_str(), "", now, now);
+        name.assign(name.size(), 'x');
+    }
+    std::string const longName(Tracer::MAX_NAME_LENGTH + 10, 'n');
+    Tracer::Record(longName.c_str(), "", now, now);
+
+    auto const root = ParseChromeTrace();
+    auto const& events = root["traceEvents"];
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0]["name"].asString(), "TraceTest::Temporary");
+    EXPECT_EQ(events[1]["name"].asString(), longName.substr(0, Tracer::MAX_NAME_LENGTH));
+}
+
+#if defined(US_BUILD_SHARED_LIBS)
+TEST_F(TraceTest, FrameworkPropertyRecordsBundleLifecycle)
+{
+    auto framework = FrameworkFactory().NewFramework(FrameworkConfiguration { { Constants::FRAMEWORK_TRACE, true } });
+    ASSERT_TRUE(Tracer::IsEnabled());
+    framework.Start();
+
+    auto bundle = cppmicroservices::testing::InstallLib(framework.GetBundleContext(), "TestBundleA");
+    bundle.Start();
+
+    auto const names = SpanNames(ParseChromeTrace());
+    EXPECT_EQ(names.count("BundleRegistry::Install0"), 1u);
+    EXPECT_EQ(names.count("BundleManifest::Parse"), 1u);
+    EXPECT_EQ(names.count("SharedLibrary::Load"), 1u);
+    EXPECT_EQ(names.count("BundlePrivate::Start0"), 1u);
+    EXPECT_EQ(names.count("BundleActivator::Start"), 1u);
+
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+#endif
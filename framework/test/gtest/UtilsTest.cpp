@@ -20,12 +20,16 @@ limitations under the License.
 
 =============================================================================*/
 
+#include "cppmicroservices/util/BinaryEncoding.h"
 #include "cppmicroservices/util/FileSystem.h"
 
 #include <TestUtils.h>
 
 #include <gtest/gtest.h>
 
+#include <map>
+#include <vector>
+
 using namespace cppmicroservices;
 using namespace cppmicroservices::testing;
 using namespace cppmicroservices::util;
@@ -164,3 +168,60 @@ TEST_F(UtilsFs, MakeAndRemovePath)
     ASSERT_NO_THROW(MakePath(validPath));
     ASSERT_NO_THROW(RemoveDirectoryRecursive(validPath));
 }
+
+TEST(UtilsBinaryEncoding, Fnv1a)
+{
+    EXPECT_EQ(Fnv1a32(""), 0x811c9dc5u);
+    EXPECT_EQ(Fnv1a32("a"), 0xe40c292cu);
+    EXPECT_EQ(Fnv1a64(""), 0xcbf29ce484222325ULL);
+    EXPECT_EQ(Fnv1a64("a"), 0xaf63dc4c8601ec8cULL);
+    EXPECT_EQ(Fnv1a64("A", [](char c) { return static_cast<char>(c | 0x20); }), Fnv1a64("a"));
+}
+
+TEST(UtilsBinaryEncoding, RoundTrip)
+{
+    AnyMap nested(AnyMap::ORDERED_MAP);
+    nested["d"] = 2.5;
+    nested["f"] = 1.5f;
+    nested["ordered"] = std::map<std::string, Any> { { "u", 7u } };
+
+    AnyMap map(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    map["b"] = true;
+    map["i"] = -3;
+    map["l"] = -4L;
+    map["ul"] = 5UL;
+    map["ll"] = -6LL;
+    map["ull"] = 7ULL;
+    map["s"] = std::string("text");
+    map["v"] = std::vector<Any> { 1, std::string("two") };
+    map["m"] = nested;
+
+    BinaryWriter writer;
+    writer.WriteMap(map);
+    BinaryReader reader(writer.buffer.data(), writer.buffer.size());
+    auto const decoded = reader.ReadMap();
+    EXPECT_TRUE(reader.AtEnd());
+    EXPECT_EQ(decoded.GetType(), AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    EXPECT_EQ(decoded, map);
+    EXPECT_EQ(decoded.AtCompoundKey("m.ordered").Type(), typeid(std::map<std::string, Any>));
+
+    // every truncation is detected
+    for (std::size_t size = 0; size < writer.buffer.size(); ++size)
+    {
+        BinaryReader truncated(writer.buffer.data(), size);
+        EXPECT_THROW(truncated.ReadMap(), std::runtime_error) << size;
+    }
+}
+
+TEST(UtilsBinaryEncoding, UnsupportedType)
+{
+    BinaryWriter writer;
+    EXPECT_THROW(writer.WriteValue(Any('c')), std::invalid_argument);
+
+    Any deep = 1;
+    for (int i = 0; i < 100; ++i)
+    {
+        deep = std::vector<Any> { deep };
+    }
+    EXPECT_THROW(writer.WriteValue(deep), std::length_error);
+}
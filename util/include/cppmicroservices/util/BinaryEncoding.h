@@ -0,0 +1,480 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_UTIL_BINARYENCODING_H
+#define CPPMICROSERVICES_UTIL_BINARYENCODING_H
+
+#include "cppmicroservices/Any.h"
+#include "cppmicroservices/AnyMap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+
+namespace cppmicroservices
+{
+
+    namespace util
+    {
+
+        //-------------------------------------------------------------------
+        // FNV-1a hashes
+        //-------------------------------------------------------------------
+
+        /**
+         * 64-bit FNV-1a hash of data. Each byte is passed through fold before
+         * it is hashed, e.g. to hash a string case-insensitively.
+         */
+        template <class Fold>
+        std::uint64_t
+        Fnv1a64(std::string_view data, Fold fold) noexcept
+        {
+            std::uint64_t hash = 14695981039346656037ULL;
+            for (char c : data)
+            {
+                hash ^= static_cast<unsigned char>(fold(c));
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        inline std::uint64_t
+        Fnv1a64(std::string_view data) noexcept
+        {
+            return Fnv1a64(data, [](char c) { return c; });
+        }
+
+        inline std::uint32_t
+        Fnv1a32(std::string_view data) noexcept
+        {
+            std::uint32_t hash = 2166136261u;
+            for (char c : data)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        //-------------------------------------------------------------------
+        // Binary encoding of Any values
+        //-------------------------------------------------------------------
+
+        namespace detail
+        {
+            // Deeper values are not encoded
+            constexpr unsigned int MAX_ENCODING_DEPTH = 64;
+
+            enum EncodingTag : std::uint8_t
+            {
+                TAG_BOOL = 1,
+                TAG_INT,
+                TAG_UINT,
+                TAG_LONG,
+                TAG_ULONG,
+                TAG_LONGLONG,
+                TAG_ULONGLONG,
+                TAG_FLOAT,
+                TAG_DOUBLE,
+                TAG_STRING,
+                TAG_ANYMAP,
+                TAG_VECTOR,
+                TAG_ORDERED_MAP
+            };
+
+            using AnyOrderedMap = std::map<std::string, Any>;
+
+            template <class T>
+            std::uint64_t
+            ToBits(T value)
+            {
+                static_assert(sizeof(T) == sizeof(std::uint32_t) || sizeof(T) == sizeof(std::uint64_t),
+                              "unexpected size of floating point type");
+                if constexpr (sizeof(T) == sizeof(std::uint32_t))
+                {
+                    std::uint32_t bits;
+                    std::memcpy(&bits, &value, sizeof(bits));
+                    return bits;
+                }
+                else
+                {
+                    std::uint64_t bits;
+                    std::memcpy(&bits, &value, sizeof(bits));
+                    return bits;
+                }
+            }
+
+            template <class T>
+            T
+            FromBits(std::uint64_t bits)
+            {
+                T value;
+                if constexpr (sizeof(T) == sizeof(std::uint32_t))
+                {
+                    auto const narrow = static_cast<std::uint32_t>(bits);
+                    std::memcpy(&value, &narrow, sizeof(value));
+                }
+                else
+                {
+                    std::memcpy(&value, &bits, sizeof(value));
+                }
+                return value;
+            }
+        } // namespace detail
+
+        /**
+         * Appends little endian integers, strings and Any values to a buffer.
+         *
+         * Supported value types are bool, the integral types, float, double,
+         * std::string, std::vector<Any>, AnyMap and std::map<std::string, Any>.
+         * Integers are written with 64 bits, independent of the size of their
+         * type on this platform.
+         *
+         * This header is not compiled into the util library, as AnyMap is
+         * exported by the framework library.
+         */
+        class BinaryWriter
+        {
+          public:
+            void
+            WriteUInt(std::uint64_t value, std::size_t bytes)
+            {
+                for (std::size_t i = 0; i < bytes; ++i)
+                {
+                    buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+                }
+            }
+
+            /// Writes size with 32 bits. Throws std::length_error if it does not fit.
+            void
+            WriteSize(std::size_t size)
+            {
+                if (size > std::numeric_limits<std::uint32_t>::max())
+                {
+                    throw std::length_error("value too large to encode");
+                }
+                WriteUInt(size, 4);
+            }
+
+            void
+            WriteString(std::string_view str)
+            {
+                WriteSize(str.size());
+                buffer.append(str.data(), str.size());
+            }
+
+            /**
+             * Throws std::invalid_argument if value, or a value nested in it,
+             * has an unsupported type, and std::length_error if the values are
+             * nested too deeply. The buffer is left partially written then.
+             */
+            void
+            WriteValue(Any const& value)
+            {
+                WriteValue(value, 0);
+            }
+
+            /// Writes the map type and the entries of map.
+            void
+            WriteMap(AnyMap const& map)
+            {
+                WriteMap(map, 0);
+            }
+
+            std::string buffer;
+
+          private:
+            void
+            WriteMap(AnyMap const& map, unsigned int depth)
+            {
+                WriteUInt(map.GetType(), 1);
+                WriteEntries(map, depth);
+            }
+
+            template <class Map>
+            void
+            WriteEntries(Map const& map, unsigned int depth)
+            {
+                WriteSize(map.size());
+                for (auto const& entry : map)
+                {
+                    WriteString(entry.first);
+                    WriteValue(entry.second, depth + 1);
+                }
+            }
+
+            void
+            WriteValue(Any const& value, unsigned int depth)
+            {
+                using namespace detail;
+                if (depth > MAX_ENCODING_DEPTH)
+                {
+                    throw std::length_error("value nested too deeply to encode");
+                }
+
+                auto const& type = value.Type();
+                if (type == typeid(bool))
+                {
+                    WriteUInt(TAG_BOOL, 1);
+                    WriteUInt(any_cast<bool>(value) ? 1 : 0, 1);
+                }
+                else if (type == typeid(int))
+                {
+                    WriteUInt(TAG_INT, 1);
+                    WriteUInt(static_cast<std::uint64_t>(any_cast<int>(value)), 8);
+                }
+                else if (type == typeid(unsigned int))
+                {
+                    WriteUInt(TAG_UINT, 1);
+                    WriteUInt(any_cast<unsigned int>(value), 8);
+                }
+                else if (type == typeid(long))
+                {
+                    WriteUInt(TAG_LONG, 1);
+                    WriteUInt(static_cast<std::uint64_t>(any_cast<long>(value)), 8);
+                }
+                else if (type == typeid(unsigned long))
+                {
+                    WriteUInt(TAG_ULONG, 1);
+                    WriteUInt(any_cast<unsigned long>(value), 8);
+                }
+                else if (type == typeid(long long))
+                {
+                    WriteUInt(TAG_LONGLONG, 1);
+                    WriteUInt(static_cast<std::uint64_t>(any_cast<long long>(value)), 8);
+                }
+                else if (type == typeid(unsigned long long))
+                {
+                    WriteUInt(TAG_ULONGLONG, 1);
+                    WriteUInt(any_cast<unsigned long long>(value), 8);
+                }
+                else if (type == typeid(float))
+                {
+                    WriteUInt(TAG_FLOAT, 1);
+                    WriteUInt(ToBits(any_cast<float>(value)), 4);
+                }
+                else if (type == typeid(double))
+                {
+                    WriteUInt(TAG_DOUBLE, 1);
+                    WriteUInt(ToBits(any_cast<double>(value)), 8);
+                }
+                else if (type == typeid(std::string))
+                {
+                    WriteUInt(TAG_STRING, 1);
+                    WriteString(ref_any_cast<std::string>(value));
+                }
+                else if (type == typeid(std::vector<Any>))
+                {
+                    auto const& vec = ref_any_cast<std::vector<Any>>(value);
+                    WriteUInt(TAG_VECTOR, 1);
+                    WriteSize(vec.size());
+                    for (auto const& element : vec)
+                    {
+                        WriteValue(element, depth + 1);
+                    }
+                }
+                else if (type == typeid(AnyMap))
+                {
+                    WriteUInt(TAG_ANYMAP, 1);
+                    WriteMap(ref_any_cast<AnyMap>(value), depth);
+                }
+                else if (type == typeid(AnyOrderedMap))
+                {
+                    WriteUInt(TAG_ORDERED_MAP, 1);
+                    WriteEntries(ref_any_cast<AnyOrderedMap>(value), depth);
+                }
+                else
+                {
+                    throw std::invalid_argument(std::string("cannot encode a value of type ") + type.name());
+                }
+            }
+        };
+
+        /**
+         * Reads the values written by a BinaryWriter from a buffer, which must
+         * outlive the reader. Reading past the end of the buffer or reading an
+         * invalid value throws std::runtime_error.
+         */
+        class BinaryReader
+        {
+          public:
+            BinaryReader(char const* data, std::size_t size) : pos(data), end(data + size) {}
+
+            bool
+            AtEnd() const
+            {
+                return pos == end;
+            }
+
+            std::uint64_t
+            ReadUInt(std::size_t bytes)
+            {
+                Require(bytes);
+                std::uint64_t value = 0;
+                for (std::size_t i = 0; i < bytes; ++i)
+                {
+                    value |= static_cast<std::uint64_t>(static_cast<unsigned char>(pos[i])) << (8 * i);
+                }
+                pos += bytes;
+                return value;
+            }
+
+            std::size_t
+            ReadSize()
+            {
+                return static_cast<std::size_t>(ReadUInt(4));
+            }
+
+            std::string_view
+            ReadBytes(std::size_t size)
+            {
+                Require(size);
+                std::string_view bytes(pos, size);
+                pos += size;
+                return bytes;
+            }
+
+            std::string_view
+            ReadString()
+            {
+                return ReadBytes(ReadSize());
+            }
+
+            Any
+            ReadValue()
+            {
+                return ReadValue(0);
+            }
+
+            AnyMap
+            ReadMap()
+            {
+                return ReadMap(0);
+            }
+
+          private:
+            AnyMap
+            ReadMap(unsigned int depth)
+            {
+                auto const type = ReadUInt(1);
+                if (type > AnyMap::FLAT_MAP_CASEINSENSITIVE_KEYS)
+                {
+                    throw std::runtime_error("invalid map type");
+                }
+                AnyMap map(static_cast<AnyMap::map_type>(type));
+                ReadEntries(map, depth);
+                return map;
+            }
+
+            template <class Map>
+            void
+            ReadEntries(Map& map, unsigned int depth)
+            {
+                auto const size = ReadSize();
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    std::string key(ReadString());
+                    map.emplace(std::move(key), ReadValue(depth + 1));
+                }
+            }
+
+            Any
+            ReadValue(unsigned int depth)
+            {
+                using namespace detail;
+                if (depth > MAX_ENCODING_DEPTH)
+                {
+                    throw std::runtime_error("invalid nesting");
+                }
+
+                switch (ReadUInt(1))
+                {
+                    case TAG_BOOL:
+                        return Any(ReadUInt(1) != 0);
+                    case TAG_INT:
+                        return Any(static_cast<int>(ReadUInt(8)));
+                    case TAG_UINT:
+                        return Any(static_cast<unsigned int>(ReadUInt(8)));
+                    case TAG_LONG:
+                        return Any(static_cast<long>(ReadUInt(8)));
+                    case TAG_ULONG:
+                        return Any(static_cast<unsigned long>(ReadUInt(8)));
+                    case TAG_LONGLONG:
+                        return Any(static_cast<long long>(ReadUInt(8)));
+                    case TAG_ULONGLONG:
+                        return Any(static_cast<unsigned long long>(ReadUInt(8)));
+                    case TAG_FLOAT:
+                        return Any(FromBits<float>(ReadUInt(4)));
+                    case TAG_DOUBLE:
+                        return Any(FromBits<double>(ReadUInt(8)));
+                    case TAG_STRING:
+                        return Any(std::string(ReadString()));
+                    case TAG_VECTOR:
+                    {
+                        auto const size = ReadSize();
+                        // every element takes at least one byte
+                        Require(size);
+                        std::vector<Any> vec;
+                        vec.reserve(size);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            vec.push_back(ReadValue(depth + 1));
+                        }
+                        return Any(std::move(vec));
+                    }
+                    case TAG_ANYMAP:
+                        return Any(ReadMap(depth));
+                    case TAG_ORDERED_MAP:
+                    {
+                        AnyOrderedMap map;
+                        ReadEntries(map, depth);
+                        return Any(std::move(map));
+                    }
+                    default:
+                        throw std::runtime_error("invalid value tag");
+                }
+            }
+
+            void
+            Require(std::size_t bytes) const
+            {
+                if (static_cast<std::size_t>(end - pos) < bytes)
+                {
+                    throw std::runtime_error("unexpected end of data");
+                }
+            }
+
+            char const* pos;
+            char const* const end;
+        };
+
+    } // namespace util
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_UTIL_BINARYENCODING_H
@@ -161,6 +161,67 @@ namespace cppmicroservices
             }
         }
 
+        // Locate the .us_resources section through the headers of the mapped
+        // file. The raw bundle resources refer to the mapping, nothing is copied.
+        explicit BundleElfFile(std::shared_ptr<MappedFile const> mappedFile) : m_rawData()
+        {
+            auto const* fileData = static_cast<char const*>(mappedFile->GetData());
+            std::size_t const fileSize = mappedFile->GetSize();
+            if (fileSize < sizeof(Ehdr))
+            {
+                throw InvalidElfException("Missing ELF header");
+            }
+
+            Ehdr elfHeader;
+            memcpy(&elfHeader, fileData, sizeof elfHeader);
+
+            if (elfHeader.e_type != ET_DYN)
+            {
+                throw InvalidElfException("Not an ELF shared library");
+            }
+
+            if (elfHeader.e_shentsize != sizeof(Shdr) || elfHeader.e_shstrndx >= elfHeader.e_shnum
+                || elfHeader.e_shoff + (elfHeader.e_shnum * sizeof(Shdr)) > fileSize)
+            {
+                throw InvalidElfException("ELF section headers missing");
+            }
+
+            auto const GetSectionHeader = [&](std::size_t i)
+            {
+                Shdr sectionHeader;
+                memcpy(&sectionHeader, fileData + elfHeader.e_shoff + (i * sizeof(Shdr)), sizeof sectionHeader);
+                return sectionHeader;
+            };
+
+            Shdr const strTabHeader = GetSectionHeader(elfHeader.e_shstrndx);
+            if (strTabHeader.sh_offset + strTabHeader.sh_size > fileSize)
+            {
+                throw InvalidElfException("ELF section names missing");
+            }
+            char const* sectionNames = fileData + strTabHeader.sh_offset;
+
+            static constexpr char resourcesName[] = ".us_resources";
+            for (std::size_t i = 0; i < elfHeader.e_shnum; ++i)
+            {
+                Shdr const sectionHeader = GetSectionHeader(i);
+                if (sectionHeader.sh_name + sizeof resourcesName > strTabHeader.sh_size
+                    || 0 != memcmp(resourcesName, sectionNames + sectionHeader.sh_name, sizeof resourcesName))
+                {
+                    continue;
+                }
+                if (0 < sectionHeader.sh_size && sectionHeader.sh_offset + sectionHeader.sh_size <= fileSize)
+                {
+                    m_rawData = std::make_shared<RawBundleResources>(
+                        std::make_unique<MappedFileRegion>(mappedFile, sectionHeader.sh_offset, sectionHeader.sh_size));
+                }
+                break;
+            }
+
+            // Only the header pages were touched; the resources are paged in
+            // when the zip archive is read.
+            mappedFile->ReleasePages();
+        }
+
         std::shared_ptr<RawBundleResources>
         GetRawBundleResourceContainer() const override
         {
@@ -188,6 +249,33 @@ namespace cppmicroservices
             throw InvalidElfException("Missing ELF identification");
         }
 
+        // Map the whole file once and read the headers and the resources
+        // section from the mapping. Fall back to reading the headers
+        // through a stream if the file cannot be mapped.
+        auto mappedFile = std::make_shared<MappedFile const>(fileName, fileSize, 0);
+        if (mappedFile->GetData())
+        {
+            auto const* elfIdent = static_cast<char const*>(mappedFile->GetData());
+            if (memcmp(elfIdent, ELFMAG, SELFMAG) != 0)
+            {
+                throw InvalidElfException("Not an ELF object file");
+            }
+
+            if (elfIdent[EI_CLASS] == ELFCLASS32)
+            {
+                return std::unique_ptr<BundleObjFile>(new BundleElfFile<Elf<ELFCLASS32>>(std::move(mappedFile)));
+            }
+            else if (elfIdent[EI_CLASS] == ELFCLASS64)
+            {
+                return std::unique_ptr<BundleObjFile>(new BundleElfFile<Elf<ELFCLASS64>>(std::move(mappedFile)));
+            }
+            else
+            {
+                throw InvalidElfException("Unknown ELF format");
+            }
+        }
+        mappedFile.reset();
+
         std::ifstream elfFile(fileName.c_str(), std::ios_base::binary);
         elfFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
 
@@ -66,6 +66,11 @@ namespace cppmicroservices
         {
             return m_Data->GetSize();
         }
+        void
+        ReleasePages() const
+        {
+            m_Data->ReleasePages();
+        }
 
       private:
         std::unique_ptr<DataContainer> m_Data;
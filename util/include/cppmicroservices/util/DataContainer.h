@@ -44,6 +44,14 @@ namespace cppmicroservices
         virtual void* GetData() const = 0;
         virtual std::size_t GetSize() const = 0;
 
+        // Hint that the data will not be accessed for a while. Containers
+        // backed by a file mapping drop their resident pages, which are
+        // read in again on the next access.
+        virtual void
+        ReleasePages() const
+        {
+        }
+
       protected:
         DataContainer() = default;
     };
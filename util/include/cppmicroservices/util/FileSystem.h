@@ -23,6 +23,7 @@
 #ifndef CPPMICROSERVICES_UTIL_FILESYSTEM_H
 #define CPPMICROSERVICES_UTIL_FILESYSTEM_H
 
+#include <cstdint>
 #include <string>
 
 namespace cppmicroservices
@@ -50,6 +51,19 @@ namespace cppmicroservices
         bool IsFile(std::string const& path);
         bool IsRelative(std::string const& path);
 
+        struct FileStatus
+        {
+            uint64_t size;
+            // last modification time in nanoseconds since the epoch
+            int64_t modified;
+            // always zero on Windows
+            uint64_t inode;
+        };
+
+        // Get the size, modification time and inode of a file.
+        // Returns false if the file does not exist.
+        bool GetFileStatus(std::string const& path, FileStatus& status);
+
         std::string GetAbsolute(std::string const& path, std::string const& base);
 
         void MakePath(std::string const& path);
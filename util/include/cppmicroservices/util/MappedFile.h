@@ -27,6 +27,9 @@
 
 #        include "DataContainer.h"
 
+#        include <algorithm>
+#        include <memory>
+
 #        include <fcntl.h>
 #        include <sys/mman.h>
 #        include <sys/stat.h>
@@ -79,12 +82,69 @@ namespace cppmicroservices
             return mapSize;
         }
 
+        void
+        ReleasePages() const override
+        {
+            ReleasePages(0, mapSize);
+        }
+
+        // Drop the resident pages overlapping [offset, offset + length).
+        // The mapping is read-only, so the pages are simply read in again
+        // from the file on the next access.
+        void
+        ReleasePages(std::size_t offset, std::size_t length) const
+        {
+            if (!mappedAddress || offset >= mapSize || 0 == length)
+            {
+                return;
+            }
+            std::size_t const pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            std::size_t const begin = offset & ~(pageSize - 1);
+            std::size_t const end = (std::min)(offset + length, mapSize);
+            madvise(static_cast<char*>(mappedAddress) + begin, end - begin, MADV_DONTNEED);
+        }
+
       private:
         int fileDesc;
         void* mappedAddress;
         size_t mapSize;
     };
 
+    // A range of a MappedFile, e.g. a section of an object file. Keeps the
+    // whole mapping alive and does not copy any data.
+    class MappedFileRegion final : public DataContainer
+    {
+      public:
+        MappedFileRegion(std::shared_ptr<MappedFile const> file, std::size_t offset, std::size_t size)
+            : mappedFile(std::move(file))
+            , regionOffset(offset)
+            , regionSize(size)
+        {
+        }
+
+        void*
+        GetData() const override
+        {
+            return mappedFile->GetData() ? static_cast<char*>(mappedFile->GetData()) + regionOffset : nullptr;
+        }
+        std::size_t
+        GetSize() const override
+        {
+            return mappedFile->GetData() ? regionSize : 0;
+        }
+
+        void
+        ReleasePages() const override
+        {
+            mappedFile->ReleasePages(regionOffset, regionSize);
+        }
+
+      private:
+        std::shared_ptr<MappedFile const> mappedFile;
+        std::size_t regionOffset;
+        std::size_t regionSize;
+    };
+
 } // namespace cppmicroservices
 #    endif // CPPMICROSERVICES_MAPPEDFILE_H
 
@@ -267,6 +267,30 @@ namespace cppmicroservices
             return S_ISREG(s.st_mode);
         }
 
+        bool
+        GetFileStatus(std::string const& path, FileStatus& status)
+        {
+            US_STAT s;
+            errno = 0;
+            if (us_stat(path.c_str(), &s))
+            {
+                if (not_found_c_error(errno))
+                    return false;
+                else
+                    throw std::invalid_argument(GetLastCErrorStr());
+            }
+            status.size = static_cast<uint64_t>(s.st_size);
+#if defined(US_PLATFORM_APPLE)
+            status.modified = static_cast<int64_t>(s.st_mtimespec.tv_sec) * 1000000000 + s.st_mtimespec.tv_nsec;
+#elif defined(US_PLATFORM_POSIX)
+            status.modified = static_cast<int64_t>(s.st_mtim.tv_sec) * 1000000000 + s.st_mtim.tv_nsec;
+#else
+            status.modified = static_cast<int64_t>(s.st_mtime) * 1000000000;
+#endif
+            status.inode = static_cast<uint64_t>(s.st_ino);
+            return true;
+        }
+
         bool
         IsRelative(std::string const& path)
         {
@@ -32,8 +32,11 @@
 #include "cppmicroservices/BundleResource.h"
 #include "cppmicroservices/BundleResourceStream.h"
 #include "cppmicroservices/Constants.h"
+#include "cppmicroservices/Framework.h"
 #include "cppmicroservices/GetBundleContext.h"
 
+#include <chrono>
+#include <cstdint>
 #include <set>
 
 namespace cppmicroservices
@@ -60,6 +63,19 @@ namespace cppmicroservices
                 response.GetOutputStream() << rs.rdbuf();
             }
         }
+        else if (pathInfo == "/services/metrics")
+        {
+            BundleResource res = GetBundleContext().GetBundle().GetResource("/templates/service_metrics.html");
+            if (res)
+            {
+                auto& data = std::static_pointer_cast<WebConsoleDefaultVariableResolver>(GetVariableResolver(request))
+                                 ->GetData();
+                GetMetrics(data);
+
+                BundleResourceStream rs(res, std::ios_base::binary);
+                response.GetOutputStream() << rs.rdbuf();
+            }
+        }
         else if (pathInfo.size() > 20 && pathInfo.compare(0, 20, "/services/interface/") == 0)
         {
             std::string id = pathInfo.substr(20);
@@ -127,4 +143,71 @@ namespace cppmicroservices
 
         return data;
     }
+
+    void
+    ServicesPlugin::GetMetrics(TemplateData& data) const
+    {
+        auto const metrics = Framework(GetContext().GetBundle(0)).GetServiceRegistryMetrics();
+        data["enabled"] = metrics.enabled ? TemplateData::Type::True : TemplateData::Type::False;
+
+        TemplateData counters(TemplateData::Type::List);
+        auto addCounter = [&counters](std::string const& name, std::uint64_t value)
+        {
+            TemplateData entry;
+            entry["name"] = name;
+            entry["value"] = NumToString(static_cast<int64_t>(value));
+            counters << std::move(entry);
+        };
+        addCounter("Registrations", metrics.registrations);
+        addCounter("Unregistrations", metrics.unregistrations);
+        addCounter("Lookups by interface", metrics.lookupsByClass);
+        addCounter("Filter evaluations", metrics.filterEvaluations);
+        addCounter("Listener invocations", metrics.listenerInvocations);
+        data["counters"] = std::move(counters);
+
+        TemplateData locks(TemplateData::Type::List);
+        auto addLock = [&locks](std::string const& name, LockWaitHistogram const& histogram)
+        {
+            auto toMicros = [](std::chrono::nanoseconds ns)
+            { return NumToString(std::chrono::duration_cast<std::chrono::microseconds>(ns).count()); };
+
+            TemplateData buckets(TemplateData::Type::List);
+            for (std::size_t i = 0; i < histogram.counts.size(); ++i)
+            {
+                TemplateData bucket;
+                bucket["bound"] = i < histogram.upperBounds.size()
+                                      ? "< " + toMicros(histogram.upperBounds[i])
+                                      : ">= " + toMicros(histogram.upperBounds.back());
+                bucket["count"] = NumToString(static_cast<int64_t>(histogram.counts[i]));
+                buckets << std::move(bucket);
+            }
+
+            TemplateData entry;
+            entry["name"] = name;
+            entry["acquisitions"] = NumToString(static_cast<int64_t>(histogram.acquisitions));
+            entry["total"] = toMicros(histogram.totalWait);
+            entry["max"] = toMicros(histogram.maxWait);
+            entry["buckets"] = std::move(buckets);
+            locks << std::move(entry);
+        };
+        addLock("ServiceRegistry", metrics.serviceRegistryLock);
+        addLock("ServiceListeners", metrics.serviceListenersLock);
+        addLock("Properties", metrics.propertiesLock);
+        data["locks"] = std::move(locks);
+
+        auto toList = [](std::vector<std::pair<std::string, std::uint64_t>> const& top)
+        {
+            TemplateData list(TemplateData::Type::List);
+            for (auto const& [name, count] : top)
+            {
+                TemplateData entry;
+                entry["name"] = name;
+                entry["count"] = NumToString(static_cast<int64_t>(count));
+                list << std::move(entry);
+            }
+            return list;
+        };
+        data["interfaces"] = toList(metrics.topInterfaces);
+        data["filters"] = toList(metrics.topFilters);
+    }
 } // namespace cppmicroservices
@@ -38,6 +38,7 @@ namespace cppmicroservices
 
         TemplateData GetIds() const;
         TemplateData GetInterface(std::string const& iid) const;
+        void GetMetrics(TemplateData& data) const;
     };
 } // namespace cppmicroservices
 